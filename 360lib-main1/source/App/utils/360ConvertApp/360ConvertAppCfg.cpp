@@ -63,6 +63,16 @@
 #if SVIDEO_CPPPSNR
 #include "Lib360/TCPPPSNRMetricCalc.h"
 #endif
+#if SVIDEO_VIEWPORT_RENDERER
+#include "Lib360/TViewPortRenderer.h"
+#endif
+#if SVIDEO_FRAME_PIPELINE
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#endif
 
 #ifdef WIN32
 #define strdup _strdup
@@ -103,6 +113,19 @@ TApp360ConvertCfg::TApp360ConvertCfg()
   , m_pchDynVPortFile(nullptr)
 #endif
   , m_pchSpherePointsFile(nullptr)
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+  , m_bFastGeometryMappingCheck(false)
+#endif
+#if SVIDEO_FACE_VIEWS
+  , m_bFaceViews(false)
+#endif
+#if SVIDEO_FRAME_PIPELINE
+  , m_iFrameWorkers(0)
+#endif
+#if SVIDEO_VIEWPORT_RENDERER
+  , m_pchViewPortListFile(nullptr)
+  , m_pchViewPortListOutputFile(nullptr)
+#endif
   , m_inputColourSpaceConvert(IPCOLOURSPACE_UNCHANGED)
   //, m_snrInternalColourSpace(false)
   , m_outputInternalColourSpace(false)
@@ -122,6 +145,10 @@ TApp360ConvertCfg::~TApp360ConvertCfg()
   if (m_pchDynVPortFile) { free(m_pchDynVPortFile); m_pchDynVPortFile = nullptr; }
 #endif
   if (m_pchSpherePointsFile) { free(m_pchSpherePointsFile); m_pchSpherePointsFile = nullptr; }
+#if SVIDEO_VIEWPORT_RENDERER
+  if (m_pchViewPortListFile) { free(m_pchViewPortListFile); m_pchViewPortListFile = nullptr; }
+  if (m_pchViewPortListOutputFile) { free(m_pchViewPortListOutputFile); m_pchViewPortListOutputFile = nullptr; }
+#endif
 }
 
 Void TApp360ConvertCfg::create()
@@ -498,6 +525,10 @@ Bool TApp360ConvertCfg::parseCfg( Int argc, TChar* argv[] )
   string cfg_Dynamic_ViewFile;
 #endif
   string cfg_SpherePointsFile;
+#if SVIDEO_VIEWPORT_RENDERER
+  string cfg_ViewPortListFile;
+  string cfg_ViewPortListOutputFile;
+#endif
 
   Int tmpInternalChromaFormat, tmpOutputChromaFormat;
   Int tmpInputChromaFormat;
@@ -520,6 +551,15 @@ Bool TApp360ConvertCfg::parseCfg( Int argc, TChar* argv[] )
   m_inputGeoParam.nBitDepth = 8;
   m_inputGeoParam.iInterp[Int(ChannelType::LUMA)] = SI_LANCZOS3;
   m_inputGeoParam.iInterp[Int(ChannelType::CHROMA)] = SI_LANCZOS2;
+#if SVIDEO_PARALLEL_PROCESSING
+  m_inputGeoParam.iNumThreads = 1;
+#endif
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+  m_inputGeoParam.bFastGeometryMapping = false;
+#endif
+#if SVIDEO_COMPACT_WEIGHT_MAP
+  m_inputGeoParam.bCompactWeightMap = false;
+#endif
 
   po::Options opts;
   opts.addOptions()
@@ -537,6 +577,10 @@ Bool TApp360ConvertCfg::parseCfg( Int argc, TChar* argv[] )
     ("DynamicViewPortFile,-dynvp",                      cfg_Dynamic_ViewFile,                        string(""), "Viewport parameter file name for sequential dynamic viewport generation")
 #endif
     ("SpherePointsFile,p",                              cfg_SpherePointsFile,                        string(""), "File name for point coordinates on the sphere of the converted projction")
+#if SVIDEO_VIEWPORT_RENDERER
+    ("ViewPortListFile",                                cfg_ViewPortListFile,                        string(""), "Viewports rendered from every converted picture, one viewport per line: hFOV vFOV yaw pitch width height")
+    ("ViewPortListOutputFile",                          cfg_ViewPortListOutputFile,                  string(""), "Output file name prefix of the viewports of ViewPortListFile")
+#endif
     ("SourceWidth,-wdt",                                m_iInputWidth,                                        0, "Source picture width")
     ("SourceHeight,-hgt",                               m_iInputHeight,                                       0, "Source picture height")
     ("InputBitDepth",                                   m_inputBitDepth[ChannelType::LUMA],                   8, "Bit-depth of input file")
@@ -632,6 +676,26 @@ Bool TApp360ConvertCfg::parseCfg( Int argc, TChar* argv[] )
 #else
     ("ChromaSampleLocType,-csl",                        m_inputGeoParam.iChromaSampleLocType,                 2,                                   "Chroma sample location type relative to luma, 0: 0.5 shift in vertical direction; 1: 0.5 shift in both directions, 2: aligned with luma (default setting), 3: 0.5 shift in horizontal direction")
 #endif
+#if SVIDEO_PARALLEL_PROCESSING
+    ("GeoConvertThreads",                               m_inputGeoParam.iNumThreads,                          1,                                   "Number of threads used for the 360 geometry conversion, 1: serial")
+#endif
+#if SVIDEO_WEIGHT_MAP_CACHE
+    ("WeightMapCacheDir",                               m_inputGeoParam.sWeightMapCacheDir,                   string(""),                          "Directory of the on-disk geometry weight map cache, empty: disabled")
+    ("WeightMapCacheMaxMB",                             m_inputGeoParam.iWeightMapCacheMaxMB,                 4096,                                "Size limit of the weight map cache in MB, the least recently used files are removed beyond it; 0: unlimited")
+#endif
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+    ("FastGeometryMapping",                             m_inputGeoParam.bFastGeometryMapping,                 false,                               "Generate the geometry weight maps with single-precision trigonometry (approximate)")
+    ("FastGeometryMappingCheck",                        m_bFastGeometryMappingCheck,                          false,                               "Report the position error and the PSNR of the fast geometry mapping against the double-precision one")
+#endif
+#if SVIDEO_COMPACT_WEIGHT_MAP
+    ("CompactWeightMap",                                m_inputGeoParam.bCompactWeightMap,                    false,                               "Keep the geometry weight maps in the compact delta coded format (same output, less memory)")
+#endif
+#if SVIDEO_FACE_VIEWS
+    ("FaceViews",                                       m_bFaceViews,                                         false,                               "ERP input: reference the input picture as face buffer where the layouts allow it instead of copying it")
+#endif
+#if SVIDEO_FRAME_PIPELINE
+    ("FrameWorkers",                                    m_iFrameWorkers,                                      0,                                   "Pipelined conversion: number of frames converted concurrently while the next ones are read and the previous ones are written, 0: sequential")
+#endif
 #if PADDED_HCMP
     ("InputPCMP",                                       m_sourceSVideoInfo.bPCMP,                             false,                               "Enable padded hemisphere-based projection format for input")
     ("CodingPCMP",                                      m_codingSVideoInfo.bPCMP,                             false,                                "Enable padded hemisphere-based projection format for coding")
@@ -782,6 +846,10 @@ Bool TApp360ConvertCfg::parseCfg( Int argc, TChar* argv[] )
   m_pchDynVPortFile = cfg_Dynamic_ViewFile.empty() ? nullptr : strdup(cfg_Dynamic_ViewFile.c_str());
 #endif
   m_pchSpherePointsFile = cfg_SpherePointsFile.empty() ? nullptr : strdup(cfg_SpherePointsFile.c_str());
+#if SVIDEO_VIEWPORT_RENDERER
+  m_pchViewPortListFile = cfg_ViewPortListFile.empty() ? nullptr : strdup(cfg_ViewPortListFile.c_str());
+  m_pchViewPortListOutputFile = cfg_ViewPortListOutputFile.empty() ? nullptr : strdup(cfg_ViewPortListOutputFile.c_str());
+#endif
   m_framesToBeConverted = ( m_framesToBeConverted + m_temporalSubsampleRatio - 1 ) / m_temporalSubsampleRatio;
   m_iSourceHeightOrg = m_iSourceHeight;
 
@@ -2252,6 +2320,15 @@ Void TApp360ConvertCfg::xCheckParameter()
     printf("ChromaSampleLocType must be in the range of [0, 3], and it is reset to 2!\n");
     m_inputGeoParam.iChromaSampleLocType = 2;
   }
+#endif
+#if SVIDEO_PARALLEL_PROCESSING
+  xConfirmPara( m_inputGeoParam.iNumThreads < 1,                                              "GeoConvertThreads must be at least 1" );
+#endif
+#if SVIDEO_FRAME_PIPELINE
+  xConfirmPara( m_iFrameWorkers < 0,                                                          "FrameWorkers must not be negative" );
+#endif
+#if SVIDEO_VIEWPORT_RENDERER
+  xConfirmPara( m_pchViewPortListFile && !m_pchViewPortListOutputFile,                       "ViewPortListFile requires ViewPortListOutputFile" );
 #endif
   //xConfirmPara( m_iFrameRate <= 0,                                                          "Frame rate must be more than 1" );
   xConfirmPara( m_framesToBeConverted <= 0,                                                   "Total Number Of Frames encoded must be more than 0" );
@@ -2654,6 +2731,9 @@ Void TApp360ConvertCfg::xPrintParameter()
   printf("DynViewPortFile                        : %s\n", m_pchDynVPortFile? m_pchDynVPortFile : "NULL");
 #endif
   printf("SpherePointsFile File                  : %s\n", m_pchSpherePointsFile? m_pchSpherePointsFile : "NULL");
+#if SVIDEO_VIEWPORT_RENDERER
+  printf("ViewPortListFile                       : %s\n", m_pchViewPortListFile? m_pchViewPortListFile : "NULL");
+#endif
   printf("Real     Format                        : %dx%d %gHz\n", m_iSourceWidth - m_confWinLeft - m_confWinRight, m_iSourceHeight - m_confWinTop - m_confWinBottom, (Double)m_iFrameRate/m_temporalSubsampleRatio );
   printf("Internal Format                        : %dx%d %gHz\n", m_iSourceWidth, m_iSourceHeight, (Double)m_iFrameRate/m_temporalSubsampleRatio );
   printf("Frame index                            : %u - %d (%d frames)\n", m_FrameSkip, m_FrameSkip+m_framesToBeConverted-1, m_framesToBeConverted );
@@ -2817,6 +2897,39 @@ Void TApp360ConvertCfg::xPrintParameter()
 #else
   printf("\nChromaSampleLocType: %d", m_inputGeoParam.iChromaSampleLocType);
 #endif
+#if SVIDEO_PARALLEL_PROCESSING
+  printf("\nGeometry conversion threads: %d", m_inputGeoParam.iNumThreads);
+#endif
+#if SVIDEO_WEIGHT_MAP_CACHE
+  if (!m_inputGeoParam.sWeightMapCacheDir.empty())
+  {
+    printf("\nWeight map cache directory: %s (limit %d MB)", m_inputGeoParam.sWeightMapCacheDir.c_str(), m_inputGeoParam.iWeightMapCacheMaxMB);
+  }
+#endif
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+  if (m_inputGeoParam.bFastGeometryMapping)
+  {
+    printf("\nFast geometry mapping: enabled%s", m_bFastGeometryMappingCheck ? " (checked against double precision)" : "");
+  }
+#endif
+#if SVIDEO_COMPACT_WEIGHT_MAP
+  if (m_inputGeoParam.bCompactWeightMap)
+  {
+    printf("\nCompact weight maps: enabled");
+  }
+#endif
+#if SVIDEO_FACE_VIEWS
+  if (m_bFaceViews)
+  {
+    printf("\nFace views of the input picture: enabled");
+  }
+#endif
+#if SVIDEO_FRAME_PIPELINE
+  if (m_iFrameWorkers)
+  {
+    printf("\nPipelined conversion: %d frame worker(s)", m_iFrameWorkers);
+  }
+#endif
 #if SVIDEO_ROT_FIX
   printf("\nRotation in 1/100 degrees: (yaw:%d  pitch:%d  roll:%d)", m_codingSVideoInfo.sVideoRotation.degree[2], m_codingSVideoInfo.sVideoRotation.degree[1], m_codingSVideoInfo.sVideoRotation.degree[0]); 
 #endif
@@ -3044,6 +3157,15 @@ Void  TApp360ConvertCfg::convert()
 #endif
 #if SVIDEO_CPPPSNR
   TCPPPSNRMetric cCPPPSNRCalc;
+#endif
+#if SVIDEO_CONVERSION_CACHE
+  TConversionCache cConversionCache;
+#if SVIDEO_SPSNR_I
+  cSPSNRICalc.setConversionCache(&cConversionCache);
+#endif
+#if SVIDEO_CPPPSNR
+  cCPPPSNRCalc.setConversionCache(&cConversionCache);
+#endif
 #endif
   pcPicYuvReadFromFile = new PelStorage;
   pcPicYuvReadFromFile->create(m_InputChromaFormatIDC, Area(Position(), Size(m_iInputWidth, m_iInputHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
@@ -3132,7 +3254,29 @@ Void  TApp360ConvertCfg::convert()
   }
 
   pcInputGeometry = TGeometry::create(m_sourceSVideoInfo, &m_inputGeoParam); 
+#if SVIDEO_FACE_VIEWS
+  if (m_bFaceViews)
+  {
+    // the input pictures (pcPicYuvReadFromFile, pcPicYuvRot) carry S_PAD_MAX margins;
+    pcInputGeometry->enableFaceViews(S_PAD_MAX);
+  }
+#endif
   pcCodingGeometry = TGeometry::create(m_codingSVideoInfo, &m_inputGeoParam);
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+  // the double-precision conversion the fast one is checked against;
+  TGeometry  *pcCheckGeometry = nullptr;
+  PelStorage  cPicYuvCheck;
+  TPSNRMetric cCheckPSNRCalc;
+  Double      dCheckPSNRSum[MAX_NUM_COMPONENT] = { 0, 0, 0 };
+  if (m_inputGeoParam.bFastGeometryMapping && m_bFastGeometryMappingCheck && !bGeoConvertSkip && !bDirectFPConvert)
+  {
+    InputGeoParam checkGeoParam        = m_inputGeoParam;
+    checkGeoParam.bFastGeometryMapping = false;
+    pcCheckGeometry                    = TGeometry::create(m_codingSVideoInfo, &checkGeoParam);
+    cCheckPSNRCalc.setOutputBitDepth(m_outputBitDepth);
+    cCheckPSNRCalc.setReferenceBitDepth(m_outputBitDepth);
+  }
+#endif
 #if SVIDEO_CPPPSNR
   //pcReferenceGeometry = TGeometry::create(m_referenceSVideoInfo, &m_inputGeoParam);
 #endif
@@ -3157,6 +3301,13 @@ Void  TApp360ConvertCfg::convert()
 #else
     pcPicYuvOrg->create(m_OutputChromaFormatIDC, Area(Position(), Size(m_iSourceWidth, m_iSourceHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
     cPicYuvTrueOrg.create(m_OutputChromaFormatIDC, Area(Position(), Size(m_iSourceWidth, m_iSourceHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+#endif
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+    if (pcCheckGeometry)
+    {
+      cPicYuvCheck.create(m_OutputChromaFormatIDC, Area(Position(), Size(cPicYuvTrueOrg.Y().width, cPicYuvTrueOrg.Y().height)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+      cPicYuvCheck.copyFrom(cPicYuvTrueOrg);
+    }
 #endif
   }
 
@@ -3193,6 +3344,23 @@ Void  TApp360ConvertCfg::convert()
   {
     cCPPPSNRCalc.initCPPPSNR(m_inputGeoParam, m_cppPsnrWidth, m_cppPsnrHeight, m_codingSVideoInfo, m_referenceSVideoInfo);
   }
+#endif
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+  if (pcCheckGeometry)
+  {
+    GeoMappingError err;
+    pcCodingGeometry->checkFastGeometryMapping(pcInputGeometry, err);
+    printf("Fast geometry mapping: %lld luma samples, max. position error %.6f, mean position error %.6f, %lld samples on a different face.\n",
+           (long long) err.iNumSamples, err.dMaxPosError, err.dSumPosError / std::max<int64_t>(1, err.iNumSamples - err.iNumFaceMismatch),
+           (long long) err.iNumFaceMismatch);
+#if SVIDEO_ROT_FIX
+    // the mapping of the reconstruction back to the input geometry (inverse rotation), as done by the encoder and decoder;
+    pcInputGeometry->checkFastGeometryMapping(pcCodingGeometry, err, true);
+    printf("Fast geometry mapping (reconstruction): %lld luma samples, max. position error %.6f, mean position error %.6f, %lld samples on a different face.\n",
+           (long long) err.iNumSamples, err.dMaxPosError, err.dSumPosError / std::max<int64_t>(1, err.iNumSamples - err.iNumFaceMismatch),
+           (long long) err.iNumFaceMismatch);
+#endif
+  }
 #endif
   //dump all points on the sphere;
   if(m_pchSpherePointsFile)
@@ -3234,220 +3402,532 @@ Void  TApp360ConvertCfg::convert()
   }
 #endif
 
+#if SVIDEO_VIEWPORT_RENDERER
+  // viewports rendered from every converted picture; they are rendered from the input geometry when it holds the padded
+  // picture after the conversion, otherwise the renderer imports the input picture itself;
+  TViewPortRenderer         cViewPortRenderer;
+  std::vector<ViewPortPose> viewPortPoses;
+  if (m_pchViewPortListFile)
+  {
+    FILE *fViewPortList = fopen(m_pchViewPortListFile, "r");
+    CHECK(!fViewPortList, "cannot open ViewPortListFile");
+    ViewPortPose pose;
+    while (fscanf(fViewPortList, "%f %f %f %f %d %d ", &pose.fHFOV, &pose.fVFOV, &pose.fYaw, &pose.fPitch, &pose.iWidth, &pose.iHeight) == 6)
+    {
+      CHECK(pose.iWidth <= 0 || pose.iHeight <= 0, "invalid viewport size in ViewPortListFile");
+      viewPortPoses.push_back(pose);
+    }
+    fclose(fViewPortList);
+    printf("%d viewport(s) rendered from every picture\n", (Int) viewPortPoses.size());
+  }
+  const Int iNumListViewPorts = (Int) viewPortPoses.size();
+  std::vector<PelStorage>   cViewPortYuv(iNumListViewPorts), cViewPortYuvOut(iNumListViewPorts);
+  std::vector<PelUnitBuf*>  viewPortDstYuvs(iNumListViewPorts);
+  std::vector<VideoIOYuv>   cTVideoIOYuvViewPortFiles(iNumListViewPorts);
+  if (iNumListViewPorts)
+  {
+    // every pose is rendered from every picture, all of them stay cached;
+    cViewPortRenderer.init(m_sourceSVideoInfo, &m_inputGeoParam, m_OutputChromaFormatIDC, iNumListViewPorts);
+    TChar *pStr = strdup(m_pchViewPortListOutputFile);
+    TChar *pCh = strrchr(pStr, '.');
+    if(pCh)
+      *pCh = '\0';
+    Int chromaFormatId[4] = {400, 420, 422, 444};
+    TChar pchFileName[512];
+    for (Int i = 0; i < iNumListViewPorts; i++)
+    {
+      Area area(Position(), Size(viewPortPoses[i].iWidth, viewPortPoses[i].iHeight));
+      cViewPortYuv[i].create(m_OutputChromaFormatIDC, area, 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+      cViewPortYuvOut[i].create(m_OutputChromaFormatIDC, area, 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+      viewPortDstYuvs[i] = &cViewPortYuv[i];
+      snprintf(pchFileName, sizeof(pchFileName), "%s_vp%d_%dx%d_%dHz_%db_%d.yuv", pStr, i, viewPortPoses[i].iWidth, viewPortPoses[i].iHeight, m_iFrameRate, m_outputBitDepth[ChannelType::LUMA], chromaFormatId[Int(m_OutputChromaFormatIDC)]);
+      cTVideoIOYuvViewPortFiles[i].open(pchFileName, true, m_outputBitDepth, m_outputBitDepth, m_outputBitDepth);  // write mode
+    }
+    free(pStr);
+  }
+#endif
+
   // starting time
   Double dResult;
   clock_t lBefore = clock();
 
-  while ( !bEos && m_framesToBeConverted)
+  // one picture through the geometry conversion; the sequential loop and the conversion workers of the pipeline share it;
+  struct FrameWorker
   {
-    // read input YUV file
-    Int aiPad[2]={0,0};
-    cTVideoIOYuvInputFile.read(*pcPicYuvReadFromFile, *pcPicYuvReadFromFile, IPCOLOURSPACE_UNCHANGED, aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range);
-
-    if (cTVideoIOYuvInputFile.isEof())
-      break;
-
-    if(!bGeoConvertSkip)
+    TGeometry  *pcInputGeometry;
+    TGeometry  *pcCodingGeometry;
+    PelStorage *pcPicYuvRot;
+    PelStorage *pcPicYuvTrueOrg;
+  };
+  auto convertFrame = [&](FrameWorker &w, PelStorage *pcPicYuvSrc, PelStorage *pcPicYuvDst, Int iFrame)
+  {
+    if(w.pcPicYuvRot)
+    {
+      w.pcInputGeometry->rotYuv(pcPicYuvSrc, w.pcPicYuvRot, (360-m_sourceSVideoInfo.framePackStruct.faces[0][0].rot)%360);
+      w.pcInputGeometry->convertYuv(w.pcPicYuvRot);
+    }
+    else
     {
-      if(pcPicYuvRot)
+      if((w.pcInputGeometry->getSVideoInfo()->geoType == SVIDEO_OCTAHEDRON || w.pcInputGeometry->getSVideoInfo()->geoType == SVIDEO_ICOSAHEDRON) && w.pcInputGeometry->getSVideoInfo()->iCompactFPStructure)
       {
-        pcInputGeometry->rotYuv(pcPicYuvReadFromFile, pcPicYuvRot, (360-m_sourceSVideoInfo.framePackStruct.faces[0][0].rot)%360);
-        pcInputGeometry->convertYuv(pcPicYuvRot);
+        w.pcInputGeometry->compactFramePackConvertYuv(pcPicYuvSrc);
       }
       else
       {
-        if((pcInputGeometry->getSVideoInfo()->geoType == SVIDEO_OCTAHEDRON || pcInputGeometry->getSVideoInfo()->geoType == SVIDEO_ICOSAHEDRON) && pcInputGeometry->getSVideoInfo()->iCompactFPStructure)
-        {
-          pcInputGeometry->compactFramePackConvertYuv(pcPicYuvReadFromFile);
-        }
-        else
-        {
-          pcInputGeometry->convertYuv(pcPicYuvReadFromFile);
-        }
-      }  
+        w.pcInputGeometry->convertYuv(pcPicYuvSrc);
+      }
+    }  
 
-      if(fViewPort)
-      {
-        if (iNextFrame==iNumConverted)
-        { 
-          Float fovx,fovy,yaw,pitch;
-          if(fscanf(fViewPort, "%f %f %f %f ", &fovx,&fovy,&yaw,&pitch) == 4)
+    if(fViewPort)
+    {
+      if (iNextFrame==iFrame)
+      { 
+        Float fovx,fovy,yaw,pitch;
+        if(fscanf(fViewPort, "%f %f %f %f ", &fovx,&fovy,&yaw,&pitch) == 4)
+        {
+          ((TViewPort*)w.pcCodingGeometry)->setViewPort(fovx,fovy,yaw,pitch);
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+          if (pcCheckGeometry)
           {
-            ((TViewPort*)pcCodingGeometry)->setViewPort(fovx,fovy,yaw,pitch);
-            if(fscanf(fViewPort, "%d ", &iNextFrame) != 1)
-              iNextFrame = m_framesToBeConverted+1;
+            ((TViewPort*)pcCheckGeometry)->setViewPort(fovx,fovy,yaw,pitch);
           }
-          else
-          {
-            printf("Frame:%d, format error for viewport settings. The viewport will not be changed any more!\n", iNumConverted);
+#endif
+          if(fscanf(fViewPort, "%d ", &iNextFrame) != 1)
             iNextFrame = m_framesToBeConverted+1;
-          }
+        }
+        else
+        {
+          printf("Frame:%d, format error for viewport settings. The viewport will not be changed any more!\n", iFrame);
+          iNextFrame = m_framesToBeConverted+1;
         }
       }
+    }
 
 #if SVIDEO_DYNAMIC_VIEWPORT_PSNR
-      if(fDynViewPort)
+    if(fDynViewPort)
+    {
+      Int iNumFrames = dynViewPortSettings.iPOC[1] - dynViewPortSettings.iPOC[0] + 1;
+      Float fpitch_c  = (iNumFrames > 1) ? ( dynViewPortSettings.fPitch[0] + (dynViewPortSettings.fPitch[1] - dynViewPortSettings.fPitch[0])/Float(iNumFrames-1)*Float(iFrame) ) : dynViewPortSettings.fPitch[0];
+      Float fyaw_c    = (iNumFrames > 1) ? ( dynViewPortSettings.fYaw[0] + (dynViewPortSettings.fYaw[1] - dynViewPortSettings.fYaw[0])/Float(iNumFrames-1)*Float(iFrame) ) : dynViewPortSettings.fYaw[0];
+      ((TViewPort*)w.pcCodingGeometry)->setViewPort(dynViewPortSettings.hFOV, dynViewPortSettings.vFOV, fyaw_c, fpitch_c);
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+      if (pcCheckGeometry)
       {
-        Int iNumFrames = dynViewPortSettings.iPOC[1] - dynViewPortSettings.iPOC[0] + 1;
-        Float fpitch_c  = (iNumFrames > 1) ? ( dynViewPortSettings.fPitch[0] + (dynViewPortSettings.fPitch[1] - dynViewPortSettings.fPitch[0])/Float(iNumFrames-1)*Float(iNumConverted) ) : dynViewPortSettings.fPitch[0];
-        Float fyaw_c    = (iNumFrames > 1) ? ( dynViewPortSettings.fYaw[0] + (dynViewPortSettings.fYaw[1] - dynViewPortSettings.fYaw[0])/Float(iNumFrames-1)*Float(iNumConverted) ) : dynViewPortSettings.fYaw[0];
-        ((TViewPort*)pcCodingGeometry)->setViewPort(dynViewPortSettings.hFOV, dynViewPortSettings.vFOV, fyaw_c, fpitch_c);
+        ((TViewPort*)pcCheckGeometry)->setViewPort(dynViewPortSettings.hFOV, dynViewPortSettings.vFOV, fyaw_c, fpitch_c);
       }
 #endif
+    }
+#endif
 
+    if(!bDirectFPConvert)
+    {
+      w.pcInputGeometry->geoConvert(w.pcCodingGeometry);
+    }
+    else
+    {
+      w.pcInputGeometry->setPaddingFlag(true);
+    }
+    if((w.pcCodingGeometry->getSVideoInfo()->geoType == SVIDEO_OCTAHEDRON || w.pcCodingGeometry->getSVideoInfo()->geoType == SVIDEO_ICOSAHEDRON) && w.pcCodingGeometry->getSVideoInfo()->iCompactFPStructure)
+    {
       if(!bDirectFPConvert)
       {
-        pcInputGeometry->geoConvert(pcCodingGeometry);
+        w.pcCodingGeometry->compactFramePack(w.pcPicYuvTrueOrg);
       }
       else
       {
-        pcInputGeometry->setPaddingFlag(true);
+        w.pcInputGeometry->compactFramePack(w.pcPicYuvTrueOrg);
       }
-      if((pcCodingGeometry->getSVideoInfo()->geoType == SVIDEO_OCTAHEDRON || pcCodingGeometry->getSVideoInfo()->geoType == SVIDEO_ICOSAHEDRON) && pcCodingGeometry->getSVideoInfo()->iCompactFPStructure)
+    }
+    else
+    {
+      if(!bDirectFPConvert)
       {
-        if(!bDirectFPConvert)
-        {
-          pcCodingGeometry->compactFramePack(&cPicYuvTrueOrg);
-        }
-        else
-        {
-          pcInputGeometry->compactFramePack(&cPicYuvTrueOrg);
-        }
+        w.pcCodingGeometry->framePack(w.pcPicYuvTrueOrg);
       }
       else
       {
-        if(!bDirectFPConvert)
-        {
-          pcCodingGeometry->framePack(&cPicYuvTrueOrg);
-        }
-        else
-        {
-          pcInputGeometry->framePack(&cPicYuvTrueOrg);
-        }
+        w.pcInputGeometry->framePack(w.pcPicYuvTrueOrg);
       }
-      cTVideoIOYuvInputFile.colourSpaceConvert(cPicYuvTrueOrg, *pcPicYuvOrg, ipCSC, true);
     }
-    else
-      pcPicYuvOrg = pcPicYuvReadFromFile;
-
-    // increase number of received frames
-    printf("\nFrame:%d ", iNumConverted);
-    iNumConverted++;
-    bEos = ( (iNumConverted == m_framesToBeConverted) );
-
-
-    // write bistream to file if necessary
-    if ( iNumConverted > 0 && m_pchOutputFile)
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+    if (pcCheckGeometry)
     {
-      cTVideoIOYuvOutputFile.write(
-        pcPicYuvOrg->get(COMPONENT_Y).width, pcPicYuvOrg->get(COMPONENT_Y).height,
-        *pcPicYuvOrg, ipCSCOutput, false, m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom, ChromaFormat::NUM, m_bClipOutputVideoToRec709Range  );
+      w.pcInputGeometry->geoConvert(pcCheckGeometry);
+      if ((pcCheckGeometry->getSVideoInfo()->geoType == SVIDEO_OCTAHEDRON || pcCheckGeometry->getSVideoInfo()->geoType == SVIDEO_ICOSAHEDRON) && pcCheckGeometry->getSVideoInfo()->iCompactFPStructure)
+      {
+        pcCheckGeometry->compactFramePack(&cPicYuvCheck);
+      }
+      else
+      {
+        pcCheckGeometry->framePack(&cPicYuvCheck);
+      }
+      cCheckPSNRCalc.xCalculatePSNR(&cPicYuvCheck, w.pcPicYuvTrueOrg);
+      for (Int i = 0; i < MAX_NUM_COMPONENT; i++)
+      {
+        dCheckPSNRSum[i] += cCheckPSNRCalc.getPSNR()[i];
+      }
     }
-
-    // temporally skip frames
-    if( m_temporalSubsampleRatio > 1 )
+#endif
+    cTVideoIOYuvInputFile.colourSpaceConvert(*w.pcPicYuvTrueOrg, *pcPicYuvDst, ipCSC, true);
+  };
+  // reads the reference picture of the converted picture and evaluates the metrics, in the order of the pictures;
+  auto measureFrame = [&](PelStorage *pcPicYuvDst)
+  {
+    if (!m_pchRefFile)
     {
-      cTVideoIOYuvInputFile.skipFrames(m_temporalSubsampleRatio-1, m_iInputWidth, m_iInputHeight, m_InputChromaFormatIDC);
+      return;
     }
-    if(m_pchRefFile) 
+    Int aiPad[2] = { 0, 0 };
+    cTVideoIOYuvRefFile.read(*pcPicYuvReadFromRefFile, *pcPicYuvReadFromRefFile, IPCOLOURSPACE_UNCHANGED, aiPad, m_OutputChromaFormatIDC, m_bClipInputVideoToRec709Range);
+    if (!cTVideoIOYuvRefFile.isEof())
     {
-      cTVideoIOYuvRefFile.read(*pcPicYuvReadFromRefFile, *pcPicYuvReadFromRefFile, IPCOLOURSPACE_UNCHANGED, aiPad, m_OutputChromaFormatIDC, m_bClipInputVideoToRec709Range);
-      if (!cTVideoIOYuvRefFile.isEof())
+#if SVIDEO_CONVERSION_CACHE
+      cConversionCache.newPicture();
+#endif
+#if SVIDEO_FIX_TICKET51
+      if(m_psnrEnabled[METRIC_PSNR])
+      {
+        cPSNRCalc.xCalculatePSNR(pcPicYuvReadFromRefFile, pcPicYuvDst);
+        printf(" %6.4lf dB    %6.4lf dB    %6.4lf dB |", cPSNRCalc.getPSNR()[COMPONENT_Y], cPSNRCalc.getPSNR()[COMPONENT_Cb], cPSNRCalc.getPSNR()[COMPONENT_Cr] );
+      }
+#if SVIDEO_SPSNR_NN
+      if(m_psnrEnabled[METRIC_SPSNR_NN])
+      {
+        cSPSNRCalc.xCalculateSPSNR(*pcPicYuvReadFromRefFile, *pcPicYuvDst);
+        printf(" %6.4lf dB    %6.4lf dB    %6.4lf dB |", cSPSNRCalc.getSPSNR()[COMPONENT_Y], cSPSNRCalc.getSPSNR()[COMPONENT_Cb], cSPSNRCalc.getSPSNR()[COMPONENT_Cr] );
+      }
+#endif
+#else
+#if SVIDEO_SPSNR_NN
+      if(m_psnrEnabled[METRIC_PSNR])
+      {
+        cPSNRCalc.xCalculatePSNR(pcPicYuvReadFromRefFile, pcPicYuvDst);
+        printf(" %6.4lf dB    %6.4lf dB    %6.4lf dB |", cPSNRCalc.getPSNR()[COMPONENT_Y], cPSNRCalc.getPSNR()[COMPONENT_Cb], cPSNRCalc.getPSNR()[COMPONENT_Cr] );
+      }
+      if(m_psnrEnabled[METRIC_SPSNR_NN])
+      {
+        cSPSNRCalc.xCalculateSPSNR(*pcPicYuvReadFromRefFile, *pcPicYuvDst);
+        printf(" %6.4lf dB    %6.4lf dB    %6.4lf dB |", cSPSNRCalc.getSPSNR()[COMPONENT_Y], cSPSNRCalc.getSPSNR()[COMPONENT_Cb], cSPSNRCalc.getSPSNR()[COMPONENT_Cr] );
+      }
+#endif
+#endif
+#if SVIDEO_WSPSNR
+      if(m_psnrEnabled[METRIC_WSPSNR])
+      {
+        cWSPSNRCalc.xCalculateWSPSNR(pcPicYuvReadFromRefFile, pcPicYuvDst);
+        printf(" %6.4lf dB    %6.4lf dB    %6.4lf dB |", cWSPSNRCalc.getWSPSNR()[COMPONENT_Y], cWSPSNRCalc.getWSPSNR()[COMPONENT_Cb], cWSPSNRCalc.getWSPSNR()[COMPONENT_Cr] );
+      }
+#endif
+#if SVIDEO_SPSNR_I
+      if(m_psnrEnabled[METRIC_SPSNR_I])
+      {
+        cSPSNRICalc.xCalculateSPSNRI(pcPicYuvReadFromRefFile, pcPicYuvDst);
+        printf(" %6.4lf dB    %6.4lf dB    %6.4lf dB |", cSPSNRICalc.getSPSNRI()[COMPONENT_Y], cSPSNRICalc.getSPSNRI()[COMPONENT_Cb], cSPSNRICalc.getSPSNRI()[COMPONENT_Cr] );
+      }
+#endif
+#if SVIDEO_CPPPSNR
+      if(m_psnrEnabled[METRIC_CPPPSNR])
+      {
+        cCPPPSNRCalc.xCalculateCPPPSNR(pcPicYuvReadFromRefFile, pcPicYuvDst);
+        printf(" %6.4lf dB    %6.4lf dB    %6.4lf dB |", cCPPPSNRCalc.getCPPPSNR()[COMPONENT_Y], cCPPPSNRCalc.getCPPPSNR()[COMPONENT_Cb], cCPPPSNRCalc.getCPPPSNR()[COMPONENT_Cr] );
+      }
+#endif
+      for( Int i = 0; i < MAX_NUM_COMPONENT; i++)
       {
 #if SVIDEO_FIX_TICKET51
         if(m_psnrEnabled[METRIC_PSNR])
         {
-          cPSNRCalc.xCalculatePSNR(pcPicYuvReadFromRefFile, pcPicYuvOrg);
-          printf(" %6.4lf dB    %6.4lf dB    %6.4lf dB |", cPSNRCalc.getPSNR()[COMPONENT_Y], cPSNRCalc.getPSNR()[COMPONENT_Cb], cPSNRCalc.getPSNR()[COMPONENT_Cr] );
+          dPSNRSum[METRIC_PSNR][i] += cPSNRCalc.getPSNR()[i];
         }
 #if SVIDEO_SPSNR_NN
         if(m_psnrEnabled[METRIC_SPSNR_NN])
         {
-          cSPSNRCalc.xCalculateSPSNR(*pcPicYuvReadFromRefFile, *pcPicYuvOrg);
-          printf(" %6.4lf dB    %6.4lf dB    %6.4lf dB |", cSPSNRCalc.getSPSNR()[COMPONENT_Y], cSPSNRCalc.getSPSNR()[COMPONENT_Cb], cSPSNRCalc.getSPSNR()[COMPONENT_Cr] );
+          dPSNRSum[METRIC_SPSNR_NN][i] += cSPSNRCalc.getSPSNR()[i];
         }
 #endif
 #else
 #if SVIDEO_SPSNR_NN
         if(m_psnrEnabled[METRIC_PSNR])
         {
-          cPSNRCalc.xCalculatePSNR(pcPicYuvReadFromRefFile, pcPicYuvOrg);
-          printf(" %6.4lf dB    %6.4lf dB    %6.4lf dB |", cPSNRCalc.getPSNR()[COMPONENT_Y], cPSNRCalc.getPSNR()[COMPONENT_Cb], cPSNRCalc.getPSNR()[COMPONENT_Cr] );
+          dPSNRSum[METRIC_PSNR][i] += cPSNRCalc.getPSNR()[i];
         }
         if(m_psnrEnabled[METRIC_SPSNR_NN])
         {
-          cSPSNRCalc.xCalculateSPSNR(*pcPicYuvReadFromRefFile, *pcPicYuvOrg);
-          printf(" %6.4lf dB    %6.4lf dB    %6.4lf dB |", cSPSNRCalc.getSPSNR()[COMPONENT_Y], cSPSNRCalc.getSPSNR()[COMPONENT_Cb], cSPSNRCalc.getSPSNR()[COMPONENT_Cr] );
+          dPSNRSum[METRIC_SPSNR_NN][i] += cSPSNRCalc.getSPSNR()[i];
         }
 #endif
 #endif
 #if SVIDEO_WSPSNR
         if(m_psnrEnabled[METRIC_WSPSNR])
         {
-          cWSPSNRCalc.xCalculateWSPSNR(pcPicYuvReadFromRefFile, pcPicYuvOrg);
-          printf(" %6.4lf dB    %6.4lf dB    %6.4lf dB |", cWSPSNRCalc.getWSPSNR()[COMPONENT_Y], cWSPSNRCalc.getWSPSNR()[COMPONENT_Cb], cWSPSNRCalc.getWSPSNR()[COMPONENT_Cr] );
+          dPSNRSum[METRIC_WSPSNR][i] += cWSPSNRCalc.getWSPSNR()[i];
         }
 #endif
 #if SVIDEO_SPSNR_I
         if(m_psnrEnabled[METRIC_SPSNR_I])
         {
-          cSPSNRICalc.xCalculateSPSNRI(pcPicYuvReadFromRefFile, pcPicYuvOrg);
-          printf(" %6.4lf dB    %6.4lf dB    %6.4lf dB |", cSPSNRICalc.getSPSNRI()[COMPONENT_Y], cSPSNRICalc.getSPSNRI()[COMPONENT_Cb], cSPSNRICalc.getSPSNRI()[COMPONENT_Cr] );
+          dPSNRSum[METRIC_SPSNR_I][i] += cSPSNRICalc.getSPSNRI()[i];
         }
 #endif
 #if SVIDEO_CPPPSNR
         if(m_psnrEnabled[METRIC_CPPPSNR])
         {
-          cCPPPSNRCalc.xCalculateCPPPSNR(pcPicYuvReadFromRefFile, pcPicYuvOrg);
-          printf(" %6.4lf dB    %6.4lf dB    %6.4lf dB |", cCPPPSNRCalc.getCPPPSNR()[COMPONENT_Y], cCPPPSNRCalc.getCPPPSNR()[COMPONENT_Cb], cCPPPSNRCalc.getCPPPSNR()[COMPONENT_Cr] );
+          dPSNRSum[METRIC_CPPPSNR][i] += cCPPPSNRCalc.getCPPPSNR()[i];
         }
 #endif
-        for( Int i = 0; i < MAX_NUM_COMPONENT; i++)
-        {
-#if SVIDEO_FIX_TICKET51
-          if(m_psnrEnabled[METRIC_PSNR])
-          {
-            dPSNRSum[METRIC_PSNR][i] += cPSNRCalc.getPSNR()[i];
-          }
-#if SVIDEO_SPSNR_NN
-          if(m_psnrEnabled[METRIC_SPSNR_NN])
-          {
-            dPSNRSum[METRIC_SPSNR_NN][i] += cSPSNRCalc.getSPSNR()[i];
-          }
+      }
+    }
+  };
+
+#if SVIDEO_FRAME_PIPELINE
+  // pipelined conversion: a reader thread reads the input pictures, the frame workers convert different frames at the same
+  // time and this thread writes and measures the converted pictures in the order of the frames; a fixed set of picture
+  // buffers travels through the stages, which bounds the queues between them; the viewport settings change the coding
+  // geometry from frame to frame and the fast mapping check sums over the frames, so those conversions stay sequential;
+  // so do the SSP and RSP conversions, their face buffers carry the seam samples of the previous frame over;
+  if (m_iFrameWorkers > 0 && !bGeoConvertSkip && !fViewPort && m_codingSVideoInfo.geoType != SVIDEO_VIEWPORT
+#if SVIDEO_SEGMENTED_SPHERE
+      && m_sourceSVideoInfo.geoType != SVIDEO_SEGMENTEDSPHERE && m_codingSVideoInfo.geoType != SVIDEO_SEGMENTEDSPHERE
 #endif
-#else
-#if SVIDEO_SPSNR_NN
-          if(m_psnrEnabled[METRIC_PSNR])
-          {
-            dPSNRSum[METRIC_PSNR][i] += cPSNRCalc.getPSNR()[i];
-          }
-          if(m_psnrEnabled[METRIC_SPSNR_NN])
-          {
-            dPSNRSum[METRIC_SPSNR_NN][i] += cSPSNRCalc.getSPSNR()[i];
-          }
+#if SVIDEO_ROTATED_SPHERE
+      && m_sourceSVideoInfo.geoType != SVIDEO_ROTATEDSPHERE && m_codingSVideoInfo.geoType != SVIDEO_ROTATEDSPHERE
 #endif
+#if SVIDEO_DYNAMIC_VIEWPORT_PSNR
+      && !fDynViewPort
 #endif
-#if SVIDEO_WSPSNR
-          if(m_psnrEnabled[METRIC_WSPSNR])
-          {
-            dPSNRSum[METRIC_WSPSNR][i] += cWSPSNRCalc.getWSPSNR()[i];
-          }
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+      && !pcCheckGeometry
 #endif
-#if SVIDEO_SPSNR_I
-          if(m_psnrEnabled[METRIC_SPSNR_I])
-          {
-            dPSNRSum[METRIC_SPSNR_I][i] += cSPSNRICalc.getSPSNRI()[i];
-          }
+#if SVIDEO_VIEWPORT_RENDERER
+      && !iNumListViewPorts
 #endif
-#if SVIDEO_CPPPSNR
-          if(m_psnrEnabled[METRIC_CPPPSNR])
+     )
+  {
+    const Int iNumWorkers = m_iFrameWorkers;
+    const Int iNumPics    = iNumWorkers + 2;   //one picture per worker, one being read and one being written;
+
+    // worker 0 converts with the geometries set up above; the weight maps it generates for the first frame are shared
+    // by the other workers;
+    std::vector<FrameWorker> workers(iNumWorkers);
+    workers[0] = { pcInputGeometry, pcCodingGeometry, pcPicYuvRot, &cPicYuvTrueOrg };
+    for (Int k = 1; k < iNumWorkers; k++)
+    {
+      FrameWorker &w    = workers[k];
+      w.pcInputGeometry = TGeometry::create(m_sourceSVideoInfo, &m_inputGeoParam);
+#if SVIDEO_FACE_VIEWS
+      if (m_bFaceViews)
+      {
+        w.pcInputGeometry->enableFaceViews(S_PAD_MAX);
+      }
+#endif
+      w.pcCodingGeometry = TGeometry::create(m_codingSVideoInfo, &m_inputGeoParam);
+      w.pcPicYuvRot      = nullptr;
+      if (pcPicYuvRot)
+      {
+        w.pcPicYuvRot = new PelStorage;
+        w.pcPicYuvRot->create(m_InputChromaFormatIDC, Area(Position(), Size(iAdjustWidth, iAdjustHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+      }
+      w.pcPicYuvTrueOrg = new PelStorage;
+      w.pcPicYuvTrueOrg->create(m_OutputChromaFormatIDC, Area(Position(), Size(cPicYuvTrueOrg.Y().width, cPicYuvTrueOrg.Y().height)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+      w.pcPicYuvTrueOrg->copyFrom(cPicYuvTrueOrg);   //HCMP: the samples outside the faces keep their padding value;
+    }
+    std::vector<PelStorage> cPicYuvIn(iNumPics), cPicYuvOut(iNumPics);
+    std::vector<Int>        picFrame(iNumPics);
+    std::deque<Int>         freePics, readPics;   //picture indices, readPics in the order of the frames;
+    std::map<Int, Int>      convertedPics;        //frame -> picture index;
+    for (Int p = 0; p < iNumPics; p++)
+    {
+      cPicYuvIn[p].create(m_InputChromaFormatIDC, Area(Position(), Size(m_iInputWidth, m_iInputHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+      cPicYuvOut[p].create(m_OutputChromaFormatIDC, Area(Position(), Size(cPicYuvTrueOrg.Y().width, cPicYuvTrueOrg.Y().height)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+      freePics.push_back(p);
+    }
+    std::mutex              pipelineMutex;
+    std::condition_variable pipelineCv;
+    Int                     iNumRead   = 0;
+    Bool                    bReadDone  = false;
+    Bool                    bMapsReady = false;
+
+    std::thread reader([&]() {
+      Int aiPad[2] = { 0, 0 };
+      while (iNumRead < m_framesToBeConverted)
+      {
+        Int p;
+        {
+          std::unique_lock<std::mutex> lock(pipelineMutex);
+          pipelineCv.wait(lock, [&] { return !freePics.empty(); });
+          p = freePics.front();
+          freePics.pop_front();
+        }
+        cTVideoIOYuvInputFile.read(cPicYuvIn[p], cPicYuvIn[p], IPCOLOURSPACE_UNCHANGED, aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range);
+        if (cTVideoIOYuvInputFile.isEof())
+        {
+          break;
+        }
+        // temporally skip frames
+        if (m_temporalSubsampleRatio > 1)
+        {
+          cTVideoIOYuvInputFile.skipFrames(m_temporalSubsampleRatio-1, m_iInputWidth, m_iInputHeight, m_InputChromaFormatIDC);
+        }
+        std::unique_lock<std::mutex> lock(pipelineMutex);
+        picFrame[p] = iNumRead++;
+        readPics.push_back(p);
+        pipelineCv.notify_all();
+      }
+      std::unique_lock<std::mutex> lock(pipelineMutex);
+      bReadDone = true;
+      pipelineCv.notify_all();
+    });
+
+    std::vector<std::thread> workerThreads;
+    for (Int k = 0; k < iNumWorkers; k++)
+    {
+      workerThreads.emplace_back([&, k]() {
+        FrameWorker &w = workers[k];
+        if (k > 0)
+        {
+          std::unique_lock<std::mutex> lock(pipelineMutex);
+          pipelineCv.wait(lock, [&] { return bMapsReady; });
+          lock.unlock();
+          w.pcInputGeometry->shareWeightMaps(workers[0].pcInputGeometry);
+          w.pcCodingGeometry->shareWeightMaps(workers[0].pcCodingGeometry);
+        }
+        while (true)
+        {
+          Int p;
           {
-            dPSNRSum[METRIC_CPPPSNR][i] += cCPPPSNRCalc.getCPPPSNR()[i];
+            std::unique_lock<std::mutex> lock(pipelineMutex);
+            pipelineCv.wait(lock, [&] { return !readPics.empty() || bReadDone; });
+            if (readPics.empty())
+            {
+              break;
+            }
+            p = readPics.front();
+            readPics.pop_front();
           }
-#endif
+          convertFrame(w, &cPicYuvIn[p], &cPicYuvOut[p], picFrame[p]);
+          std::unique_lock<std::mutex> lock(pipelineMutex);
+          convertedPics[picFrame[p]] = p;
+          bMapsReady |= (k == 0);
+          pipelineCv.notify_all();
+        }
+        std::unique_lock<std::mutex> lock(pipelineMutex);
+        bMapsReady = true;
+        pipelineCv.notify_all();
+      });
+    }
+
+    // ordered writer;
+    while (true)
+    {
+      Int p;
+      {
+        std::unique_lock<std::mutex> lock(pipelineMutex);
+        pipelineCv.wait(lock, [&] { return convertedPics.count(iNumConverted) || (bReadDone && iNumConverted == iNumRead); });
+        if (!convertedPics.count(iNumConverted))
+        {
+          break;
         }
+        p = convertedPics[iNumConverted];
+        convertedPics.erase(iNumConverted);
+      }
+      printf("\nFrame:%d ", iNumConverted);
+      iNumConverted++;
+      if (m_pchOutputFile)
+      {
+        cTVideoIOYuvOutputFile.write(
+          cPicYuvOut[p].get(COMPONENT_Y).width, cPicYuvOut[p].get(COMPONENT_Y).height,
+          cPicYuvOut[p], ipCSCOutput, false, m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom, ChromaFormat::NUM, m_bClipOutputVideoToRec709Range  );
+      }
+      measureFrame(&cPicYuvOut[p]);
+      std::unique_lock<std::mutex> lock(pipelineMutex);
+      freePics.push_back(p);
+      pipelineCv.notify_all();
+    }
+    reader.join();
+    for (auto &t: workerThreads)
+    {
+      t.join();
+    }
+
+    // the workers share the weight maps of worker 0, they go first;
+    for (Int k = 1; k < iNumWorkers; k++)
+    {
+      delete workers[k].pcInputGeometry;
+      delete workers[k].pcCodingGeometry;
+      if (workers[k].pcPicYuvRot)
+      {
+        workers[k].pcPicYuvRot->destroy();
+        delete workers[k].pcPicYuvRot;
+      }
+      workers[k].pcPicYuvTrueOrg->destroy();
+      delete workers[k].pcPicYuvTrueOrg;
+    }
+    for (Int p = 0; p < iNumPics; p++)
+    {
+      cPicYuvIn[p].destroy();
+      cPicYuvOut[p].destroy();
+    }
+    bEos = true;   //all frames went through the pipeline;
+  }
+#endif
+  while ( !bEos && m_framesToBeConverted)
+  {
+    // read input YUV file
+    Int aiPad[2]={0,0};
+    cTVideoIOYuvInputFile.read(*pcPicYuvReadFromFile, *pcPicYuvReadFromFile, IPCOLOURSPACE_UNCHANGED, aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range);
+
+    if (cTVideoIOYuvInputFile.isEof())
+      break;
+
+    if(!bGeoConvertSkip)
+    {
+      FrameWorker w = { pcInputGeometry, pcCodingGeometry, pcPicYuvRot, &cPicYuvTrueOrg };
+      convertFrame(w, pcPicYuvReadFromFile, pcPicYuvOrg, iNumConverted);
+    }
+    else
+      pcPicYuvOrg = pcPicYuvReadFromFile;
+
+#if SVIDEO_VIEWPORT_RENDERER
+    if (iNumListViewPorts)
+    {
+      if (!bGeoConvertSkip && !bDirectFPConvert)
+      {
+        cViewPortRenderer.setSourceGeometry(pcInputGeometry);
+      }
+      else
+      {
+        cViewPortRenderer.importPicture(pcPicYuvReadFromFile);
+      }
+      cViewPortRenderer.render(viewPortPoses, viewPortDstYuvs);
+      for (Int i = 0; i < iNumListViewPorts; i++)
+      {
+        cTVideoIOYuvInputFile.colourSpaceConvert(cViewPortYuv[i], cViewPortYuvOut[i], ipCSC, true);
+        cTVideoIOYuvViewPortFiles[i].write(viewPortPoses[i].iWidth, viewPortPoses[i].iHeight, cViewPortYuvOut[i], ipCSCOutput, false,
+                                           0, 0, 0, 0, ChromaFormat::NUM, m_bClipOutputVideoToRec709Range);
       }
     }
+#endif
+
+    // increase number of received frames
+    printf("\nFrame:%d ", iNumConverted);
+    iNumConverted++;
+    bEos = ( (iNumConverted == m_framesToBeConverted) );
+
+
+    // write bistream to file if necessary
+    if ( iNumConverted > 0 && m_pchOutputFile)
+    {
+      cTVideoIOYuvOutputFile.write(
+        pcPicYuvOrg->get(COMPONENT_Y).width, pcPicYuvOrg->get(COMPONENT_Y).height,
+        *pcPicYuvOrg, ipCSCOutput, false, m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom, ChromaFormat::NUM, m_bClipOutputVideoToRec709Range  );
+    }
+
+    // temporally skip frames
+    if( m_temporalSubsampleRatio > 1 )
+    {
+      cTVideoIOYuvInputFile.skipFrames(m_temporalSubsampleRatio-1, m_iInputWidth, m_iInputHeight, m_InputChromaFormatIDC);
+    }
+    measureFrame(pcPicYuvOrg);
   }
 
   if(m_pchRefFile)
@@ -3461,6 +3941,13 @@ Void  TApp360ConvertCfg::convert()
     printf("\n");
   }
 
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+  if (pcCheckGeometry && iNumConverted)
+  {
+    printf("\n\nFast geometry mapping PSNR against double precision\n\n");
+    printf(" %6.4lf     %6.4lf     %6.4lf  |\n", dCheckPSNRSum[COMPONENT_Y]/iNumConverted, dCheckPSNRSum[COMPONENT_Cb]/iNumConverted, dCheckPSNRSum[COMPONENT_Cr]/iNumConverted);
+  }
+#endif
   // ending time
   dResult = (Double)(clock()-lBefore) / CLOCKS_PER_SEC;
   printf("\n Total Time: %12.3f sec.\n", dResult);
@@ -3474,6 +3961,14 @@ Void  TApp360ConvertCfg::convert()
   // Video I/O
   cTVideoIOYuvInputFile.close();
   cTVideoIOYuvOutputFile.close();
+#if SVIDEO_VIEWPORT_RENDERER
+  for (Int i = 0; i < iNumListViewPorts; i++)
+  {
+    cTVideoIOYuvViewPortFiles[i].close();
+    cViewPortYuv[i].destroy();
+    cViewPortYuvOut[i].destroy();
+  }
+#endif
   if(m_pchRefFile)
     cTVideoIOYuvRefFile.close();
 
@@ -3492,6 +3987,14 @@ Void  TApp360ConvertCfg::convert()
 
   // delete used buffers in encoder class
   cPicYuvTrueOrg.destroy();
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+  cPicYuvCheck.destroy();
+  if (pcCheckGeometry)
+  {
+    delete pcCheckGeometry;
+    pcCheckGeometry = nullptr;
+  }
+#endif
 
   if(pcPicYuvReadFromFile)
   {
@@ -81,6 +81,19 @@ protected:
   TChar*     m_pchDynVPortFile;
 #endif
   TChar*     m_pchSpherePointsFile;
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+  Bool      m_bFastGeometryMappingCheck;                      ///< compare the fast geometry mapping with the double-precision one
+#endif
+#if SVIDEO_FACE_VIEWS
+  Bool      m_bFaceViews;                                     ///< let the input geometry reference the input picture instead of copying it
+#endif
+#if SVIDEO_FRAME_PIPELINE
+  Int       m_iFrameWorkers;                                  ///< number of frames converted concurrently by the pipelined conversion; 0: sequential
+#endif
+#if SVIDEO_VIEWPORT_RENDERER
+  TChar*    m_pchViewPortListFile;                            ///< viewports rendered from every converted picture, one "hFOV vFOV yaw pitch width height" per line
+  TChar*    m_pchViewPortListOutputFile;                      ///< output file name prefix of the rendered viewports
+#endif
   // source specification
   Int       m_iFrameRate;                                     ///< source frame-rates (Hz)
   UInt      m_FrameSkip;                                      ///< number of skipped frames from the beginning
@@ -0,0 +1,76 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __TEXT360APPDECCFG__
+#define __TEXT360APPDECCFG__
+
+#include "CommonLib/CommonDef.h"
+#include "Lib360/TGeometry.h"
+
+class DecAppCfg;
+
+namespace ProgramOptionsLite
+{
+  struct Options;
+}
+
+// the decoded pictures are in the coding geometry; they are rendered back to the source geometry of the encoder, the
+// options share the names of the encoder ones so that the 360 part of an encoder configuration can be passed as is;
+class TExt360AppDecCfg
+{
+protected:
+  Bool      m_bSVideo;                                        ///< render the output pictures to the source geometry;
+  Int       m_iSourceWidth;                                   ///< width of the rendered pictures;
+  Int       m_iSourceHeight;                                  ///< height of the rendered pictures;
+  std::string m_renderFileName;                               ///< file of the rendered pictures;
+  SVideoInfo m_sourceSVideoInfo;
+  SVideoInfo m_codingSVideoInfo;
+  InputGeoParam m_inputGeoParam;
+  Int       m_iInternalChromaFormat;                          ///< chroma format of the conversion; 0: the decoded one;
+#if SVIDEO_DECODER_RENDER_THREAD
+  Int       m_iRenderQueue;                                   ///< number of output pictures queued for the render thread; 0: rendered when output
+#endif
+
+  DecAppCfg &m_cfg;
+  friend class TExt360AppDecTop;
+
+public:
+  TExt360AppDecCfg(DecAppCfg &cfg);
+  virtual ~TExt360AppDecCfg();
+
+  Void addOptions(ProgramOptionsLite::Options &opts);
+  Bool processOptions();   // returns false on failure
+};
+
+#endif
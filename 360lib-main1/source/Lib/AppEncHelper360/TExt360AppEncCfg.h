@@ -59,6 +59,12 @@ protected:
   Int       m_iCodingFaceHeight;
   Int       m_faceSizeAlignment;
   InputGeoParam m_inputGeoParam;
+#if SVIDEO_FACE_VIEWS
+  Bool      m_bFaceViews;                                     ///< let the input geometry reference the input picture instead of copying it
+#endif
+#if SVIDEO_INPUT_LOOKAHEAD
+  Int       m_iInputLookahead;                                ///< number of input pictures read and converted ahead of the encoder; 0: converted on request
+#endif
 #if SVIDEO_VIEWPORT_PSNR
   ViewPortPSNRParam m_viewPortPSNRParam;
 #endif
@@ -126,8 +132,6 @@ public:
   Bool isGeoConvertSkipped();
   Bool isDirectFPConvert();  
 private:
-  Void xSetDefaultFramePackingParam(SVideoInfo& sVideoInfo);
-  Void xFillSourceSVideoInfo(SVideoInfo& sourceSVideoInfo, Int inputWidth, Int inputHeight);
   Void xCalcOutputResolution(SVideoInfo& sourceSVideoInfo, SVideoInfo& codingSVideoInfo, Int& iOutputWidth, Int& iOutputHeight, Int minCuSize=8);
   Void xPrintGeoTypeName(Int nType, Bool bCompactFPFormat);
 
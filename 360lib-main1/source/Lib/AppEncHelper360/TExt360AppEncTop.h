@@ -39,6 +39,12 @@
 #include "Lib360/TGeometry.h"
 #include "AppEncHelper360/TExt360AppEncCfg.h"
 #include "Utilities/VideoIOYuv.h"
+#if SVIDEO_INPUT_LOOKAHEAD
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
 
 class EncAppCfg;
 class TExt360EncGop;
@@ -67,8 +73,32 @@ class TExt360AppEncTop
 #endif
 #endif
 
+#if SVIDEO_INPUT_LOOKAHEAD
+  // the lookahead thread reads the input with its own file handle and converts into the ring, read() hands the
+  // pictures out in order and keeps the encoder's file handle at the same position;
+  struct LookaheadPic
+  {
+    PelStorage picYuvOrg;
+    PelStorage picYuvTrueOrg;
+    Bool       bEof;
+  };
+  Int                       m_iLookahead;
+  std::vector<LookaheadPic> m_lookaheadPics;                  ///< ring, picture n in [n % m_iLookahead];
+  VideoIOYuv                m_cTVideoIOYuvInputFileLookahead;
+  std::thread               m_lookaheadThread;
+  std::mutex                m_lookaheadMutex;
+  std::condition_variable   m_lookaheadCv;
+  Int                       m_iNumLookaheadConverted;        ///< pictures put into the ring;
+  Int                       m_iNumLookaheadRead;             ///< pictures handed out by read();
+  Bool                      m_bLookaheadExit;
+
+  Void xLookaheadLoop(const InputColourSpaceConversion ipCSC);
+  Void xReadLookahead(VideoIOYuv &inputVideoFile, PelStorage &picYuvOrg, PelStorage &picYuvTrueOrg, const InputColourSpaceConversion ipCSC);
+#endif
+
   Void xDestroy();
   Void xCreate(EncGOP &encGop, PelStorage &yuvOrig);
+  Void xReadConvert(VideoIOYuv &inputVideoFile, PelStorage &picYuvOrg, PelStorage &picYuvTrueOrg, const InputColourSpaceConversion ipCSC);
 
 public:
   TExt360AppEncTop(EncAppCfg &cfg, TExt360EncGop &ext360Gop, EncGOP &encGop, PelStorage &yuvOrig);
@@ -0,0 +1,95 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2024, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     Interpolation360.cpp
+ *  \brief    Weighted 2D block filter used by the 360 geometry conversion
+ */
+
+#include "Interpolation360.h"
+
+#if EXTENSION_360_VIDEO
+
+template<int N>
+int filter2DCore(const Pel *src, ptrdiff_t srcStride, const int *coeff)
+{
+  int sum = 0;
+  for (int m = 0; m < N; m++)
+  {
+    for (int n = 0; n < N; n++)
+    {
+      sum += src[n] * coeff[n];
+    }
+    src += srcStride;
+    coeff += N;
+  }
+  return sum;
+}
+
+template<int N>
+void gather2DCore(Pel *dst, Pel *const *srcFaces, ptrdiff_t srcStride, const Interp360GatherSample *samples, int num,
+                  int shift, int bitDepth)
+{
+  const int offset = 1 << (shift - 1);
+  for (int k = 0; k < num; k++)
+  {
+    const int sum = filter2DCore<N>(srcFaces[samples[k].srcFace] + samples[k].src, srcStride, samples[k].coeff);
+    dst[samples[k].dst] = ClipBD((sum + offset) >> shift, bitDepth);
+  }
+}
+
+Interp360Ops::Interp360Ops()
+{
+  filter2D[0] = nullptr;
+  filter2D[1] = filter2DCore<1>;
+  filter2D[2] = filter2DCore<2>;
+  filter2D[3] = filter2DCore<3>;
+  filter2D[4] = filter2DCore<4>;
+  filter2D[5] = filter2DCore<5>;
+  filter2D[6] = filter2DCore<6>;
+  filter2D[7] = filter2DCore<7>;
+  filter2D[8] = filter2DCore<8>;
+
+  gather2D[0] = nullptr;
+  gather2D[1] = gather2DCore<1>;
+  gather2D[2] = gather2DCore<2>;
+  gather2D[3] = gather2DCore<3>;
+  gather2D[4] = gather2DCore<4>;
+  gather2D[5] = gather2DCore<5>;
+  gather2D[6] = gather2DCore<6>;
+  gather2D[7] = gather2DCore<7>;
+  gather2D[8] = gather2DCore<8>;
+}
+
+Interp360Ops g_interp360OP = Interp360Ops();
+
+#endif
@@ -0,0 +1,79 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2024, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     Interpolation360.h
+ *  \brief    Weighted 2D block filter used by the 360 geometry conversion (header)
+ */
+
+#ifndef __INTERPOLATION360__
+#define __INTERPOLATION360__
+
+#include "CommonDef.h"
+
+#if EXTENSION_360_VIDEO
+
+static constexpr int INTERP360_MAX_TAPS = 8;
+
+/// One entry of a gather table: the block at srcFaces[srcFace] + src is filtered with coeff, the rounded and clipped
+/// result is written to dst[dst]. The sphere padding keeps the scattered margin samples of a face in such tables.
+struct Interp360GatherSample
+{
+  int        dst;
+  int        srcFace;
+  int        src;
+  const int *coeff;
+};
+
+/// One output sample of the 360 geometry conversion is the weighted sum of a square taps x taps block of the source
+/// face; the weights are stored row by row. The kernels are indexed by the number of taps (1: NN, 2: bilinear,
+/// 4: bicubic/Lanczos2, 6: Lanczos3, 8: Lanczos4).
+struct Interp360Ops
+{
+  Interp360Ops();
+
+#if ENABLE_SIMD_OPT_INTERP360 && defined(TARGET_SIMD_X86)
+  void initInterp360OpsX86();
+  template<X86_VEXT vext>
+  void _initInterp360OpsX86();
+#endif
+
+  int (*filter2D[INTERP360_MAX_TAPS + 1])(const Pel *src, ptrdiff_t srcStride, const int *coeff);
+  // the entries are processed in order, an entry may read a sample written by an earlier one;
+  void (*gather2D[INTERP360_MAX_TAPS + 1])(Pel *dst, Pel *const *srcFaces, ptrdiff_t srcStride,
+                                           const Interp360GatherSample *samples, int num, int shift, int bitDepth);
+};
+
+extern Interp360Ops g_interp360OP;
+
+#endif
+#endif
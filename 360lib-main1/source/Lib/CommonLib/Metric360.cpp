@@ -0,0 +1,73 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2024, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     Metric360.cpp
+ *  \brief    Row kernels of the weighted spherical PSNR metrics
+ */
+
+#include "Metric360.h"
+
+#if EXTENSION_360_VIDEO
+
+static double weightedSSECore(const Pel *org, const Pel *rec, const double *weight, int width, int orgShift, int recShift)
+{
+  double sum = 0;
+  for (int x = 0; x < width; x++)
+  {
+    const int diff = (org[x] << orgShift) - (rec[x] << recShift);
+    sum += (double) diff * diff * weight[x];
+  }
+  return sum;
+}
+
+static double sseCore(const Pel *org, const Pel *rec, int width, int orgShift, int recShift)
+{
+  int64_t sum = 0;
+  for (int x = 0; x < width; x++)
+  {
+    const int64_t diff = (org[x] << orgShift) - (rec[x] << recShift);
+    sum += diff * diff;
+  }
+  return (double) sum;
+}
+
+Metric360Ops::Metric360Ops()
+{
+  weightedSSE = weightedSSECore;
+  sse         = sseCore;
+}
+
+Metric360Ops g_metric360OP = Metric360Ops();
+
+#endif
@@ -0,0 +1,66 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2024, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     Metric360.h
+ *  \brief    Row kernels of the weighted spherical PSNR metrics (header)
+ */
+
+#ifndef __METRIC360__
+#define __METRIC360__
+
+#include "CommonDef.h"
+
+#if EXTENSION_360_VIDEO
+
+/// Row kernels of the WS-PSNR metric. The difference of a sample pair is (org << orgShift) - (rec << recShift).
+struct Metric360Ops
+{
+  Metric360Ops();
+
+#if ENABLE_SIMD_OPT_METRIC360 && defined(TARGET_SIMD_X86)
+  void initMetric360OpsX86();
+  template<X86_VEXT vext>
+  void _initMetric360OpsX86();
+#endif
+
+  /// sum of the squared differences of one row, each multiplied by the weight of its sample
+  double (*weightedSSE)(const Pel *org, const Pel *rec, const double *weight, int width, int orgShift, int recShift);
+  /// sum of the squared differences of one row; the result is an integer and exact up to 2^53
+  double (*sse)(const Pel *org, const Pel *rec, int width, int orgShift, int recShift);
+};
+
+extern Metric360Ops g_metric360OP;
+
+#endif
+#endif
@@ -0,0 +1,110 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2024, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     Resample360.cpp
+ *  \brief    Row kernels of the 4:2:0 <-> 4:4:4 chroma resampling of the 360 geometries
+ */
+
+#include "Resample360.h"
+
+#if EXTENSION_360_VIDEO
+
+static inline int filterTaps(const Pel *src, ptrdiff_t step, const int *coeff, int numTaps)
+{
+  int sum = 0;
+  for (int t = 0; t < numTaps; t++)
+  {
+    sum += src[t * step] * coeff[t];
+  }
+  return sum;
+}
+
+static inline int filterTaps(const int *src, const int *coeff, int numTaps)
+{
+  int sum = 0;
+  for (int t = 0; t < numTaps; t++)
+  {
+    sum += src[t] * coeff[t];
+  }
+  return sum;
+}
+
+static void filterVerCore(const Pel *src, ptrdiff_t srcStride, int *dst, int width, const int *coeff, int numTaps)
+{
+  for (int x = 0; x < width; x++)
+  {
+    dst[x] = filterTaps(src + x, srcStride, coeff, numTaps);
+  }
+}
+
+static void filterVerClipCore(const Pel *src, ptrdiff_t srcStride, Pel *dst, int width, const int *coeff, int numTaps,
+                              int shift, int bitDepth)
+{
+  const int offset = shift ? 1 << (shift - 1) : 0;
+  for (int x = 0; x < width; x++)
+  {
+    dst[x] = ClipBD((filterTaps(src + x, srcStride, coeff, numTaps) + offset) >> shift, bitDepth);
+  }
+}
+
+static void filterHorUpCore(const int *src0, const int *src1, Pel *dst, int width, const int *coeff0, int numTaps0,
+                            const int *coeff1, int numTaps1, int shift, int bitDepth)
+{
+  const int offset = shift ? 1 << (shift - 1) : 0;
+  for (int x = 0; x < width; x++)
+  {
+    dst[2 * x]     = ClipBD((filterTaps(src0 + x, coeff0, numTaps0) + offset) >> shift, bitDepth);
+    dst[2 * x + 1] = ClipBD((filterTaps(src1 + x, coeff1, numTaps1) + offset) >> shift, bitDepth);
+  }
+}
+
+static void filterHorDownCore(const Pel *src, Pel *dst, int width, const int *coeff, int numTaps)
+{
+  for (int x = 0; x < width; x++)
+  {
+    dst[x] = filterTaps(src + 2 * x, 1, coeff, numTaps);
+  }
+}
+
+Resample360Ops::Resample360Ops()
+{
+  filterVer     = filterVerCore;
+  filterVerClip = filterVerClipCore;
+  filterHorUp   = filterHorUpCore;
+  filterHorDown = filterHorDownCore;
+}
+
+Resample360Ops g_resample360OP = Resample360Ops();
+
+#endif
@@ -0,0 +1,73 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2024, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     Resample360.h
+ *  \brief    Row kernels of the 4:2:0 <-> 4:4:4 chroma resampling of the 360 geometries (header)
+ */
+
+#ifndef __RESAMPLE360__
+#define __RESAMPLE360__
+
+#include "CommonDef.h"
+
+#if EXTENSION_360_VIDEO
+
+/// Row kernels of the separable chroma resampling filters. The source pointers address the first tap of the first
+/// output sample; the coefficients are those of Filter1DInfo. A shift of 0 means no rounding offset.
+struct Resample360Ops
+{
+  Resample360Ops();
+
+#if ENABLE_SIMD_OPT_RESAMPLE360 && defined(TARGET_SIMD_X86)
+  void initResample360OpsX86();
+  template<X86_VEXT vext>
+  void _initResample360OpsX86();
+#endif
+
+  /// vertical filter of one row into 32-bit intermediates: dst[x] = sum(coeff[t] * src[x + t * srcStride])
+  void (*filterVer)(const Pel *src, ptrdiff_t srcStride, int *dst, int width, const int *coeff, int numTaps);
+  /// vertical filter of one row, rounded, shifted and clipped to bitDepth
+  void (*filterVerClip)(const Pel *src, ptrdiff_t srcStride, Pel *dst, int width, const int *coeff, int numTaps,
+                        int shift, int bitDepth);
+  /// horizontal 1:2 upsampling of one row of intermediates: the even outputs filter src0, the odd outputs src1
+  void (*filterHorUp)(const int *src0, const int *src1, Pel *dst, int width, const int *coeff0, int numTaps0,
+                      const int *coeff1, int numTaps1, int shift, int bitDepth);
+  /// horizontal 2:1 downsampling of one row, unnormalised: dst[x] = (Pel) sum(coeff[t] * src[2 * x + t])
+  void (*filterHorDown)(const Pel *src, Pel *dst, int width, const int *coeff, int numTaps);
+};
+
+extern Resample360Ops g_resample360OP;
+
+#endif
+#endif
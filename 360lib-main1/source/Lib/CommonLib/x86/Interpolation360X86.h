@@ -0,0 +1,214 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2024, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     Interpolation360X86.h
+ *  \brief    SIMD weighted 2D block filter of the 360 geometry conversion
+ */
+
+//! \ingroup CommonLib
+//! \{
+
+#include "CommonLib/CommonDef.h"
+#include "CommonDefX86.h"
+#include "CommonLib/Interpolation360.h"
+
+#if ENABLE_SIMD_OPT_INTERP360
+#ifdef TARGET_SIMD_X86
+
+// All kernels accumulate the 32-bit products in the same wrap-around arithmetic as filter2DCore(), so the result is
+// bit-exact with the C path whatever the summation order. Only the taps of the block are loaded, never beyond it.
+
+static inline int sumInt32x4(__m128i vsum)
+{
+  vsum = _mm_add_epi32(vsum, _mm_shuffle_epi32(vsum, 0x4e));
+  vsum = _mm_add_epi32(vsum, _mm_shuffle_epi32(vsum, 0xb1));
+  return _mm_cvtsi128_si32(vsum);
+}
+
+#ifdef USE_AVX2
+static inline __m128i foldInt32x8(__m256i vsum)
+{
+  return _mm_add_epi32(_mm256_castsi256_si128(vsum), _mm256_extracti128_si256(vsum, 1));
+}
+#endif
+
+template<X86_VEXT vext>
+int filter2D2x2_SIMD(const Pel *src, ptrdiff_t srcStride, const int *coeff)
+{
+  __m128i vsrc = _mm_unpacklo_epi32(_mm_cvtsi32_si128(*(int32_t *) src), _mm_cvtsi32_si128(*(int32_t *) (src + srcStride)));
+  vsrc         = _mm_cvtepi16_epi32(vsrc);
+  return sumInt32x4(_mm_mullo_epi32(vsrc, _mm_loadu_si128((const __m128i *) coeff)));
+}
+
+template<X86_VEXT vext>
+int filter2D4x4_SIMD(const Pel *src, ptrdiff_t srcStride, const int *coeff)
+{
+#ifdef USE_AVX2
+  if (vext >= AVX2)
+  {
+    __m256i vsum = _mm256_setzero_si256();
+    for (int m = 0; m < 4; m += 2)
+    {
+      // two rows of four samples per iteration, the coefficients of both rows are contiguous;
+      __m128i vsrc = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *) src),
+                                        _mm_loadl_epi64((const __m128i *) (src + srcStride)));
+      __m256i vcoeff = _mm256_loadu_si256((const __m256i *) coeff);
+      vsum = _mm256_add_epi32(vsum, _mm256_mullo_epi32(_mm256_cvtepi16_epi32(vsrc), vcoeff));
+      src += 2 * srcStride;
+      coeff += 8;
+    }
+    return sumInt32x4(foldInt32x8(vsum));
+  }
+#endif
+  __m128i vsum = _mm_setzero_si128();
+  for (int m = 0; m < 4; m++)
+  {
+    __m128i vsrc = _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *) src));
+    vsum         = _mm_add_epi32(vsum, _mm_mullo_epi32(vsrc, _mm_loadu_si128((const __m128i *) coeff)));
+    src += srcStride;
+    coeff += 4;
+  }
+  return sumInt32x4(vsum);
+}
+
+template<X86_VEXT vext>
+int filter2D6x6_SIMD(const Pel *src, ptrdiff_t srcStride, const int *coeff)
+{
+#ifdef USE_AVX2
+  if (vext >= AVX2)
+  {
+    __m256i vsum4 = _mm256_setzero_si256();
+    __m128i vsum2 = _mm_setzero_si128();
+    for (int m = 0; m < 6; m += 2)
+    {
+      // samples 0..3 of two rows in one 256-bit vector, samples 4..5 of the same rows in one 128-bit vector;
+      __m128i vsrc4 = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *) src),
+                                         _mm_loadl_epi64((const __m128i *) (src + srcStride)));
+      __m256i vcoeff4 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) coeff)),
+                                                _mm_loadu_si128((const __m128i *) (coeff + 6)), 1);
+      vsum4 = _mm256_add_epi32(vsum4, _mm256_mullo_epi32(_mm256_cvtepi16_epi32(vsrc4), vcoeff4));
+
+      __m128i vsrc2   = _mm_unpacklo_epi32(_mm_cvtsi32_si128(*(int32_t *) (src + 4)),
+                                         _mm_cvtsi32_si128(*(int32_t *) (src + srcStride + 4)));
+      __m128i vcoeff2 = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *) (coeff + 4)),
+                                           _mm_loadl_epi64((const __m128i *) (coeff + 10)));
+      vsum2 = _mm_add_epi32(vsum2, _mm_mullo_epi32(_mm_cvtepi16_epi32(vsrc2), vcoeff2));
+      src += 2 * srcStride;
+      coeff += 12;
+    }
+    return sumInt32x4(_mm_add_epi32(foldInt32x8(vsum4), vsum2));
+  }
+#endif
+  __m128i vsum = _mm_setzero_si128();
+  for (int m = 0; m < 6; m++)
+  {
+    __m128i vsrc4 = _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *) src));
+    __m128i vsrc2 = _mm_cvtepi16_epi32(_mm_cvtsi32_si128(*(int32_t *) (src + 4)));
+    vsum          = _mm_add_epi32(vsum, _mm_mullo_epi32(vsrc4, _mm_loadu_si128((const __m128i *) coeff)));
+    vsum          = _mm_add_epi32(vsum, _mm_mullo_epi32(vsrc2, _mm_loadl_epi64((const __m128i *) (coeff + 4))));
+    src += srcStride;
+    coeff += 6;
+  }
+  return sumInt32x4(vsum);
+}
+
+template<X86_VEXT vext>
+int filter2D8x8_SIMD(const Pel *src, ptrdiff_t srcStride, const int *coeff)
+{
+#ifdef USE_AVX2
+  if (vext >= AVX2)
+  {
+    __m256i vsum = _mm256_setzero_si256();
+    for (int m = 0; m < 8; m++)
+    {
+      __m256i vsrc = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *) src));
+      vsum         = _mm256_add_epi32(vsum, _mm256_mullo_epi32(vsrc, _mm256_loadu_si256((const __m256i *) coeff)));
+      src += srcStride;
+      coeff += 8;
+    }
+    return sumInt32x4(foldInt32x8(vsum));
+  }
+#endif
+  __m128i vsum = _mm_setzero_si128();
+  for (int m = 0; m < 8; m++)
+  {
+    __m128i vsrc = _mm_loadu_si128((const __m128i *) src);
+    vsum = _mm_add_epi32(vsum, _mm_mullo_epi32(_mm_cvtepi16_epi32(vsrc), _mm_loadu_si128((const __m128i *) coeff)));
+    vsum = _mm_add_epi32(vsum, _mm_mullo_epi32(_mm_cvtepi16_epi32(_mm_srli_si128(vsrc, 8)),
+                                               _mm_loadu_si128((const __m128i *) (coeff + 4))));
+    src += srcStride;
+    coeff += 8;
+  }
+  return sumInt32x4(vsum);
+}
+
+// the block filter is inlined into the loop over the table; the source rows of the next entry are prefetched since the
+// entries of a gather table are scattered over the faces;
+template<X86_VEXT vext, int (*filter)(const Pel *, ptrdiff_t, const int *)>
+void gather2D_SIMD(Pel *dst, Pel *const *srcFaces, ptrdiff_t srcStride, const Interp360GatherSample *samples, int num,
+                   int shift, int bitDepth)
+{
+  const int offset = 1 << (shift - 1);
+  for (int k = 0; k < num; k++)
+  {
+    if (k + 1 < num)
+    {
+      _mm_prefetch((const char *) (srcFaces[samples[k + 1].srcFace] + samples[k + 1].src), _MM_HINT_T0);
+    }
+    const int sum = filter(srcFaces[samples[k].srcFace] + samples[k].src, srcStride, samples[k].coeff);
+    dst[samples[k].dst] = ClipBD((sum + offset) >> shift, bitDepth);
+  }
+}
+
+template<X86_VEXT vext>
+void Interp360Ops::_initInterp360OpsX86()
+{
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+  // 1 tap (nearest neighbour) is a single multiplication and stays with the C kernel;
+  filter2D[2] = filter2D2x2_SIMD<vext>;
+  filter2D[4] = filter2D4x4_SIMD<vext>;
+  filter2D[6] = filter2D6x6_SIMD<vext>;
+  filter2D[8] = filter2D8x8_SIMD<vext>;
+
+  gather2D[2] = gather2D_SIMD<vext, filter2D2x2_SIMD<vext>>;
+  gather2D[4] = gather2D_SIMD<vext, filter2D4x4_SIMD<vext>>;
+  gather2D[6] = gather2D_SIMD<vext, filter2D6x6_SIMD<vext>>;
+  gather2D[8] = gather2D_SIMD<vext, filter2D8x8_SIMD<vext>>;
+#endif
+}
+
+template void Interp360Ops::_initInterp360OpsX86<SIMDX86>();
+
+#endif // TARGET_SIMD_X86
+#endif
+//! \}
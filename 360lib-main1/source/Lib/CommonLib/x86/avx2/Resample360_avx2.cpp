@@ -0,0 +1 @@
+#include "../Resample360X86.h"
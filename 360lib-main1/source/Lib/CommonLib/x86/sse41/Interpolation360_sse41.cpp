@@ -0,0 +1 @@
+#include "../Interpolation360X86.h"
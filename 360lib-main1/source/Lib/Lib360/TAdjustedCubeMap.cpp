@@ -185,5 +185,17 @@ Void TAdjustedCubeMap::map3DTo2D(SPos *pSPosIn, SPos *pSPosOut)
   pSPosOut->x = (POSType)((pu+1.0)*(m_sVideoInfo.iFaceWidth>>1) + (-0.5));
   pSPosOut->y = (POSType)((pv+1.0)*(m_sVideoInfo.iFaceHeight>>1)+ (-0.5));
 }
+
+#if SVIDEO_ROW_PROJECTION
+Void TAdjustedCubeMap::map2DTo3DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap2DTo3DRow(this, pSPosIn, pSPosOut, iNum);
+}
+
+Void TAdjustedCubeMap::map3DTo2DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap3DTo2DRow(this, pSPosIn, pSPosOut, iNum);
+}
+#endif
 #endif
 #endif
\ No newline at end of file
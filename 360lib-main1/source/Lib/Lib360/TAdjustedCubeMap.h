@@ -53,6 +53,10 @@ public:
 
   virtual Void map2DTo3D(SPos& IPosIn, SPos *pSPosOut); 
   virtual Void map3DTo2D(SPos *pSPosIn, SPos *pSPosOut); 
+#if SVIDEO_ROW_PROJECTION
+  virtual Void map2DTo3DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum);
+  virtual Void map3DTo2DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum);
+#endif
 };
 #endif
 #endif
@@ -43,12 +43,18 @@ TCPPPSNRMetric::TCPPPSNRMetric()
 : m_bCPPPSNREnabled(false)
 , m_pCart2D(nullptr)
 , m_fpTable(nullptr)
+#if SVIDEO_CONVERSION_CACHE
+, m_pcConversionCache(nullptr)
+#endif
 {
   m_dCPPPSNR[0] = m_dCPPPSNR[1] = m_dCPPPSNR[2] = 0;
   m_pcOutputGeomtry    = nullptr;
   m_pcReferenceGeomtry = nullptr;
   m_pcOutputCPPGeomtry = nullptr;
   m_pcRefCPPGeomtry    = nullptr;
+#if SVIDEO_CPPPSNR_MASK
+  m_iNumValid[0] = m_iNumValid[1] = 0;
+#endif
 }
 
 TCPPPSNRMetric::~TCPPPSNRMetric()
@@ -78,6 +84,10 @@ TCPPPSNRMetric::~TCPPPSNRMetric()
   {
     delete m_pcRefCPPGeomtry; m_pcRefCPPGeomtry = nullptr;
   }
+#if SVIDEO_CPPPSNR_MASK
+  m_cRefCPPYuv.destroy();
+  m_cOutCPPYuv.destroy();
+#endif
 }
 
 Void TCPPPSNRMetric::setOutputBitDepth(const BitDepths &outputBitDepths)
@@ -426,16 +436,81 @@ Void TCPPPSNRMetric::initCPPPSNR(InputGeoParam inputGeoParam, Int cppWidth, Int
   m_pcRefCPPGeomtry = TGeometry::create(m_cppVideoInfo, &m_cppGeoParam);
   m_pcReferenceGeomtry = TGeometry::create(m_cppRefVideoInfo, &m_cppGeoParam);
 #endif
+#if SVIDEO_CPPPSNR_MASK
+  m_cRefCPPYuv.destroy();
+  m_cOutCPPYuv.destroy();
+  m_cRefCPPYuv.create(m_chromaFormatIDC, Area(Position(), Size(m_cppWidth, m_cppHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+  m_cOutCPPYuv.create(m_chromaFormatIDC, Area(Position(), Size(m_cppWidth, m_cppHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+  xCreateValidMasks();
+#endif
 }
 
+#if SVIDEO_CPPPSNR_MASK
+/**
+ * Marks the samples of each channel type plane that fall inside the Crasters-parabolic outline.
+ * The test only depends on the plane size, so it is done once instead of per frame.
+ */
+Void TCPPPSNRMetric::xCreateValidMasks()
+{
+  for (Int chType = 0; chType < MAX_NUM_CHANNEL_TYPE; chType++)
+  {
+    m_validMask[chType].clear();
+    m_iNumValid[chType] = 0;
+    if (chType == Int(ChannelType::CHROMA) && m_chromaFormatIDC == ChromaFormat::_400)
+    {
+      continue;
+    }
+    const ComponentID ch      = chType == Int(ChannelType::LUMA) ? COMPONENT_Y : COMPONENT_Cb;
+    const Int         iWidth  = m_cRefCPPYuv.get(ch).width;
+    const Int         iHeight = m_cRefCPPYuv.get(ch).height;
+    m_validMask[chType].resize(iWidth * iHeight, 0);
+    UChar *pMask = m_validMask[chType].data();
+
+    double fPhi, fLambda;
+    double fIdxX, fIdxY;
+    double fLamdaX, fLamdaY;
+
+    for (Int y = 0; y < iHeight; y++)
+    {
+      for (Int x = 0; x < iWidth; x++)
+      {
+        fLamdaX = ((double)x / (iWidth)) * (2 * S_PI) - S_PI;
+        fLamdaY = ((double)y / (iHeight)) * S_PI - (S_PI_2);
+
+        fPhi = 3 * sasin(fLamdaY / S_PI);
+        fLambda = fLamdaX / (2 * scos(2 * fPhi / 3) - 1);
+
+        fLamdaX = (fLambda + S_PI) / 2 / S_PI * (iWidth);
+        fLamdaY = (fPhi + (S_PI / 2)) / S_PI *  (iHeight);
+
+        fIdxX = (int)((fLamdaX < 0) ? fLamdaX - 0.5 : fLamdaX + 0.5);
+        fIdxY = (int)((fLamdaY < 0) ? fLamdaY - 0.5 : fLamdaY + 0.5);
+
+        if (fIdxY >= 0 && fIdxX >= 0 && fIdxX < iWidth && fIdxY < iHeight)
+        {
+          pMask[x] = 1;
+          m_iNumValid[chType]++;
+        }
+      }
+      pMask += iWidth;
+    }
+  }
+}
+#endif
+
 Void TCPPPSNRMetric::xCalculateCPPPSNR( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPicD)
 {
   Int iBitDepthForPSNRCalc[MAX_NUM_CHANNEL_TYPE];
   Int iReferenceBitShift[MAX_NUM_CHANNEL_TYPE];
   Int iOutputBitShift[MAX_NUM_CHANNEL_TYPE];
 
+#if SVIDEO_CPPPSNR_MASK
+  PelStorage *TPicYUVRefCPP = &m_cRefCPPYuv;
+  PelStorage *TPicYUVOutCPP = &m_cOutCPPYuv;
+#else
   PelStorage *TPicYUVRefCPP;
   PelStorage *TPicYUVOutCPP;
+#endif
 
   iBitDepthForPSNRCalc[Int(ChannelType::LUMA)] = std::max(m_outputBitDepth[Int(ChannelType::LUMA)], m_referenceBitDepth[Int(ChannelType::LUMA)]);
   iBitDepthForPSNRCalc[Int(ChannelType::CHROMA)] = std::max(m_outputBitDepth[Int(ChannelType::CHROMA)], m_referenceBitDepth[Int(ChannelType::CHROMA)]);
@@ -447,14 +522,21 @@ Void TCPPPSNRMetric::xCalculateCPPPSNR( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcP
   memset(m_dCPPPSNR, 0, sizeof(Double)*3);
   Double SCPPDspsnr[3]={0, 0 ,0};
 
+#if !SVIDEO_CPPPSNR_MASK
   // Convert Output and Ref to CPP_Projection
   TPicYUVRefCPP = new PelStorage;
   TPicYUVRefCPP->create(m_chromaFormatIDC, Area(Position(), Size(m_cppWidth, m_cppHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
 
   TPicYUVOutCPP = new PelStorage;
   TPicYUVOutCPP->create(m_chromaFormatIDC, Area(Position(), Size(m_cppWidth, m_cppHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+#endif
 
   // Converting Reference to CPP
+#if SVIDEO_CONVERSION_CACHE
+  if (m_pcConversionCache)
+    m_pcConversionCache->convertYuv(m_pcReferenceGeomtry, pcOrgPicYuv);
+  else
+#endif
   if ((m_pcReferenceGeomtry->getSVideoInfo()->geoType == SVIDEO_OCTAHEDRON || m_pcReferenceGeomtry->getSVideoInfo()->geoType == SVIDEO_ICOSAHEDRON) && m_pcReferenceGeomtry->getSVideoInfo()->iCompactFPStructure)
   {
     m_pcReferenceGeomtry->compactFramePackConvertYuv(pcOrgPicYuv);
@@ -467,6 +549,11 @@ Void TCPPPSNRMetric::xCalculateCPPPSNR( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcP
   m_pcRefCPPGeomtry->framePack(TPicYUVRefCPP);
 
   // Converting Output to CPP
+#if SVIDEO_CONVERSION_CACHE
+  if (m_pcConversionCache)
+    m_pcConversionCache->convertYuv(m_pcOutputGeomtry, pcPicD);
+  else
+#endif
   if ((m_pcOutputGeomtry->getSVideoInfo()->geoType == SVIDEO_OCTAHEDRON || m_pcOutputGeomtry->getSVideoInfo()->geoType == SVIDEO_ICOSAHEDRON) && m_pcOutputGeomtry->getSVideoInfo()->iCompactFPStructure)
   {
     m_pcOutputGeomtry->compactFramePackConvertYuv(pcPicD);
@@ -492,6 +579,25 @@ Void TCPPPSNRMetric::xCalculateCPPPSNR( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcP
     const Int   iWidth     = TPicYUVRefCPP->get(ch).width;
     const Int   iHeight    = TPicYUVRefCPP->get(ch).height;
 
+#if SVIDEO_CPPPSNR_MASK
+    const Int   iOrgShift  = iOutputBitShift[Int(toChannelType(ch))];
+    const Int   iRecShift  = iReferenceBitShift[Int(toChannelType(ch))];
+    const UChar *pMask     = m_validMask[Int(toChannelType(ch))].data();
+    int64_t     iSSD       = 0;
+
+    for (Int y = 0; y < iHeight; y++)
+    {
+      for (Int x = 0; x < iWidth; x++)
+      {
+        const int64_t iDiff = (pOrg[x] << iOrgShift) - (pRec[x] << iRecShift);
+        iSSD += pMask[x] * iDiff * iDiff;
+      }
+      pOrg  += iOrgStride;
+      pRec  += iRecStride;
+      pMask += iWidth;
+    }
+    SCPPDspsnr[chan] = (Double)iSSD / m_iNumValid[Int(toChannelType(ch))];
+#else
     Int   iSize            = 0;
     double fPhi, fLambda;
     double fIdxX, fIdxY;
@@ -528,6 +634,7 @@ Void TCPPPSNRMetric::xCalculateCPPPSNR( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcP
       pRec += iRecStride;
     }
     SCPPDspsnr[chan] /= iSize;
+#endif
   }
 
   for (Int ch_indx = 0; ch_indx < getNumberValidComponents(pcPicD->chromaFormat); ch_indx++)
@@ -539,6 +646,7 @@ Void TCPPPSNRMetric::xCalculateCPPPSNR( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcP
     m_dCPPPSNR[ch_indx] = ( SCPPDspsnr[ch_indx] ? 10.0 * log10( fReflpsnr / (Double)SCPPDspsnr[ch_indx] ) : 999.99 );
   }
 
+#if !SVIDEO_CPPPSNR_MASK
   if(TPicYUVRefCPP)
   {
     TPicYUVRefCPP->destroy();
@@ -551,6 +659,7 @@ Void TCPPPSNRMetric::xCalculateCPPPSNR( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcP
     delete TPicYUVOutCPP;
     TPicYUVOutCPP = nullptr;
   }
+#endif
 }
 
 #endif // SVIDEO_CPPPSNR
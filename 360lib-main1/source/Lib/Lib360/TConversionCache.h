@@ -0,0 +1,110 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TConversionCache.h
+    \brief    Per-picture cache of the converted face buffers shared by the 360 metrics (header)
+*/
+
+#ifndef __TCONVERSIONCACHE__
+#define __TCONVERSIONCACHE__
+#include "TGeometry.h"
+
+#include <list>
+#include <vector>
+#if SVIDEO_PARALLEL_METRICS
+#include <condition_variable>
+#include <mutex>
+#endif
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+#if EXTENSION_360_VIDEO
+#if SVIDEO_CONVERSION_CACHE
+
+/// Several metrics convert the same original/reconstructed picture into geometries with the same configuration.
+/// The first geometry converting a picture is remembered; later geometries with the same conversion key copy its
+/// face buffers (and its sphere padding, if the padding configuration matches) instead of converting again.
+/// An entry becomes stale as soon as its geometry receives another picture (see TGeometry::getFacesStamp()).
+/// With SVIDEO_PARALLEL_METRICS the metrics may call in from several threads. The mutex only guards the entry list:
+/// a conversion is registered as in progress, runs (sphere padding included) without the lock and is published when
+/// done, so that different pictures or keys convert concurrently and a metric needing a conversion in progress waits
+/// for it. The faces of a published geometry are never written again while other metrics copy them.
+class TConversionCache
+{
+private:
+  struct Entry
+  {
+    const Pel         *pSrc;              //identifies the source picture;
+    Int                iSrcWidth;
+    Int                iSrcHeight;
+    std::vector<UChar> convKey;
+    std::vector<UChar> padKey;
+    TGeometry         *pGeo;
+    UInt               uiFacesStamp;
+#if SVIDEO_PARALLEL_METRICS
+    Bool               bReady;            //false while pGeo is being converted;
+    Int                iNumReaders;       //metrics copying the faces of pGeo;
+#endif
+  };
+  std::list<Entry>   m_entries;
+#if SVIDEO_PARALLEL_METRICS
+  std::mutex              m_mutex;
+  std::condition_variable m_cvChanged;    //an entry was published or its last reader finished;
+#endif
+
+  Entry* xFind(PelUnitBuf *pSrcYuv, const std::vector<UChar> &convKey);
+#if SVIDEO_PARALLEL_METRICS
+  Void   xRelease(TGeometry *pGeo, std::unique_lock<std::mutex> &lock);
+#else
+  Void   xRelease(TGeometry *pGeo);
+#endif
+
+public:
+  TConversionCache() {}
+  virtual ~TConversionCache() {}
+
+  Void newPicture() { m_entries.clear(); }                 ///< call before the metrics of a picture are computed;
+#if SVIDEO_PARALLEL_METRICS
+  Void convertYuv(TGeometry *pGeo, PelUnitBuf *pSrcYuv);   ///< (compact) convertYuv() and spherePadding() of pGeo, or a copy of a cached conversion;
+#else
+  Void convertYuv(TGeometry *pGeo, PelUnitBuf *pSrcYuv);   ///< (compact) convertYuv() of pGeo, or a copy of a cached conversion;
+#endif
+  Void spherePadding(TGeometry *pGeo);                     ///< spherePadding(true) unless pGeo already holds the padded picture;
+  Void release(TGeometry *pGeo);                           ///< to be called before a registered geometry is deleted;
+};
+
+#endif
+#endif
+#endif // __TCONVERSIONCACHE__
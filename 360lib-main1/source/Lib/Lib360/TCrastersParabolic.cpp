@@ -94,6 +94,24 @@ Void TCrastersParabolic::map3DTo2D(SPos *pSPosIn, SPos *pSPosOut)
 {
 }
 
+#if SVIDEO_ROW_PROJECTION
+Void TCrastersParabolic::map2DTo3DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap2DTo3DRow(this, pSPosIn, pSPosOut, iNum);
+}
+
+Void TCrastersParabolic::map3DTo2DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap3DTo2DRow(this, pSPosIn, pSPosOut, iNum);
+}
+
+Void TCrastersParabolic::insideFaceRow(Int fId, Int x, Int iStepX, Int y, Int iNum, ComponentID chId, ComponentID origchId,
+                                            Bool *pbInside)
+{
+  xInsideFaceRow(this, fId, x, iStepX, y, iNum, chId, origchId, pbInside);
+}
+#endif
+
 #if SVIDEO_CPP_FIX
 Bool TCrastersParabolic::insideFace(Int fId, Int x, Int y, ComponentID chId, ComponentID origchId)
 {
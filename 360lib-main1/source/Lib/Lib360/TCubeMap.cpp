@@ -186,6 +186,18 @@ Void TCubeMap::map3DTo2D(SPos *pSPosIn, SPos *pSPosOut)
   pSPosOut->y = (POSType)((pv+1.0)*(m_sVideoInfo.iFaceHeight>>1)+ (-0.5));
 }
 
+#if SVIDEO_ROW_PROJECTION
+Void TCubeMap::map2DTo3DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap2DTo3DRow(this, pSPosIn, pSPosOut, iNum);
+}
+
+Void TCubeMap::map3DTo2DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap3DTo2DRow(this, pSPosIn, pSPosOut, iNum);
+}
+#endif
+
 Void TCubeMap::sPad(Pel *pSrc0, Int iHStep0, Int iStrideSrc0, Pel* pSrc1, Int iHStep1, Int iStrideSrc1, Int iNumSamples, Int hCnt, Int vCnt)
 {
   Pel *pSrc0Start = pSrc0 + iHStep0;
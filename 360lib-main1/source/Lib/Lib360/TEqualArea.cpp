@@ -97,5 +97,17 @@ Void TEqualArea::map3DTo2D(SPos *pSPosIn, SPos *pSPosOut)
   pSPosOut->y = (POSType)((len < S_EPS? 0.5 : (0.5-(y/len)*0.5))*m_sVideoInfo.iFaceHeight);
   pSPosOut->y -= 0.5;
 }
+
+#if SVIDEO_ROW_PROJECTION
+Void TEqualArea::map2DTo3DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap2DTo3DRow(this, pSPosIn, pSPosOut, iNum);
+}
+
+Void TEqualArea::map3DTo2DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap3DTo2DRow(this, pSPosIn, pSPosOut, iNum);
+}
+#endif
 #endif
 #endif
\ No newline at end of file
@@ -50,12 +50,24 @@
 #if SVIDEO_EQUIANGULAR_CUBEMAP
 class TEquiAngularCubeMap : public TCubeMap
 {
+#if SVIDEO_SEPARABLE_MAPPING
+private:
+  Void xPlaneTo3D(Int faceIdx, POSType pu, POSType pv, SPos *pSPosOut);
+
+#endif
 public:
   TEquiAngularCubeMap(SVideoInfo& sVideoInfo, InputGeoParam *pInGeoParam);
   virtual ~TEquiAngularCubeMap();
 
   virtual Void map2DTo3D(SPos& IPosIn, SPos *pSPosOut); 
   virtual Void map3DTo2D(SPos *pSPosIn, SPos *pSPosOut); 
+#if SVIDEO_ROW_PROJECTION
+  virtual Void map2DTo3DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum);
+  virtual Void map3DTo2DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum);
+#endif
+#if SVIDEO_SEPARABLE_MAPPING
+  virtual Void map2DTo3DRowMemo(SPos *pSPosIn, SPos *pSPosOut, Int iNum, const Int *pCol, SeparableMemo &memo);
+#endif
 };
 #endif
 #endif
@@ -65,6 +65,27 @@ TEquiRect::~TEquiRect()
 {
 }
 
+// folds a position of the left/right or top/bottom margins back into the picture;
+inline Void TEquiRect::xFoldMargins(POSType &u, POSType &v)
+{
+  if ((u < 0 || u >= m_sVideoInfo.iFaceWidth) && ( v >= 0 && v < m_sVideoInfo.iFaceHeight))
+  {
+    u = u < 0 ? m_sVideoInfo.iFaceWidth+u : (u - m_sVideoInfo.iFaceWidth);
+  }
+  else if (v < 0)
+  {
+    v = -v;
+    u = u + (m_sVideoInfo.iFaceWidth>>1);
+    u = u >= m_sVideoInfo.iFaceWidth ? u - m_sVideoInfo.iFaceWidth : u;
+  }
+  else if(v >= m_sVideoInfo.iFaceHeight)
+  {
+    v = (m_sVideoInfo.iFaceHeight<<1)-v;
+    u = u + (m_sVideoInfo.iFaceWidth>>1);
+    u = u >= m_sVideoInfo.iFaceWidth ? u - m_sVideoInfo.iFaceWidth : u;
+  }
+}
+
 /**************************************
     -180                         180
 90                                   0
@@ -81,22 +102,7 @@ Void TEquiRect::map2DTo3D(SPos& IPosIn, SPos *pSPosOut)
   u = IPosIn.x + (POSType)(0.5);
   v = IPosIn.y + (POSType)(0.5);
 
-  if ((u < 0 || u >= m_sVideoInfo.iFaceWidth) && ( v >= 0 && v < m_sVideoInfo.iFaceHeight)) 
-  {
-    u = u < 0 ? m_sVideoInfo.iFaceWidth+u : (u - m_sVideoInfo.iFaceWidth);
-  }
-  else if (v < 0)
-  {
-    v = -v; 
-    u = u + (m_sVideoInfo.iFaceWidth>>1);
-    u = u >= m_sVideoInfo.iFaceWidth ? u - m_sVideoInfo.iFaceWidth : u;
-  }
-  else if(v >= m_sVideoInfo.iFaceHeight)
-  {
-    v = (m_sVideoInfo.iFaceHeight<<1)-v; 
-    u = u + (m_sVideoInfo.iFaceWidth>>1);
-    u = u >= m_sVideoInfo.iFaceWidth ? u - m_sVideoInfo.iFaceWidth : u;
-  }
+  xFoldMargins(u, v);
 
   POSType yaw, pitch;
   pSPosOut->faceIdx =IPosIn.faceIdx;
@@ -142,6 +148,118 @@ Void TEquiRect::map3DTo2D(SPos *pSPosIn, SPos *pSPosOut)
   pSPosOut->y -= 0.5;
 }
 
+#if SVIDEO_ROW_PROJECTION
+Void TEquiRect::map2DTo3DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap2DTo3DRow(this, pSPosIn, pSPosOut, iNum);
+}
+
+Void TEquiRect::map3DTo2DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap3DTo2DRow(this, pSPosIn, pSPosOut, iNum);
+}
+#endif
+
+#if SVIDEO_SEPARABLE_MAPPING
+/********************************
+//map2DTo3D() of a row with the latitude terms evaluated once per row and the longitude terms once per column;
+//the arithmetic is that of map2DTo3D();
+*********************************/
+Void TEquiRect::map2DTo3DRowMemo(SPos *pSPosIn, SPos *pSPosOut, Int iNum, const Int *pCol, SeparableMemo &memo)
+{
+#if SVIDEO_SUB_SPHERE
+  if (m_sVideoInfo.geoType != SVIDEO_EQUIRECT || m_sVideoInfo.subSphere.bPresent)
+#else
+  if (m_sVideoInfo.geoType != SVIDEO_EQUIRECT)
+#endif
+  {
+    map2DTo3DRow(pSPosIn, pSPosOut, iNum);
+    return;
+  }
+
+  for (Int k = 0; k < iNum; k++)
+  {
+    POSType u, v;
+    u = pSPosIn[k].x + (POSType)(0.5);
+    v = pSPosIn[k].y + (POSType)(0.5);
+
+    xFoldMargins(u, v);
+
+    if (!SeparableMemo::isSame(v, memo.rowArg))
+    {
+      POSType pitch = (POSType)(S_PI_2 - v*S_PI/m_sVideoInfo.iFaceHeight);
+      memo.rowArg    = v;
+      memo.rowVal[0] = scos(pitch);
+      memo.rowVal[1] = ssin(pitch);
+    }
+    Int c = pCol[k];
+    if (!SeparableMemo::isSame(u, memo.colArg[0][c]))
+    {
+      POSType yaw = (POSType)(u*S_PI*2/m_sVideoInfo.iFaceWidth - S_PI);
+      memo.colArg[0][c] = u;
+      memo.colVal[0][c] = scos(yaw);
+      memo.colVal[1][c] = ssin(yaw);
+    }
+    pSPosOut[k].faceIdx = pSPosIn[k].faceIdx;
+    pSPosOut[k].x = (POSType)(memo.rowVal[0]*memo.colVal[0][c]);
+    pSPosOut[k].y = (POSType)(memo.rowVal[1]);
+    pSPosOut[k].z = -(POSType)(memo.rowVal[0]*memo.colVal[1][c]);
+  }
+}
+
+/********************************
+//map3DTo2D() of a row with the longitude evaluated once per column as long as the column keeps its (x, z) direction,
+//as on the side faces of the cube maps without rotation;
+*********************************/
+Void TEquiRect::map3DTo2DRowMemo(SPos *pSPosIn, SPos *pSPosOut, Int iNum, const Int *pCol, SeparableMemo &memo)
+{
+  if (m_sVideoInfo.geoType != SVIDEO_EQUIRECT)
+  {
+    map3DTo2DRow(pSPosIn, pSPosOut, iNum);
+    return;
+  }
+
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+  if (TFastMath::isEnabled())
+  {
+    xMap3DTo2DRowMemo<true>(pSPosIn, pSPosOut, iNum, pCol, memo);
+    return;
+  }
+#endif
+  xMap3DTo2DRowMemo<false>(pSPosIn, pSPosOut, iNum, pCol, memo);
+}
+
+//the trigonometry is bound at compile time, so that the polynomials of the fast mapping are inlined into the loop;
+template<Bool bFast>
+Void TEquiRect::xMap3DTo2DRowMemo(SPos *pSPosIn, SPos *pSPosOut, Int iNum, const Int *pCol, SeparableMemo &memo)
+{
+  for (Int k = 0; k < iNum; k++)
+  {
+    POSType x = pSPosIn[k].x;
+    POSType y = pSPosIn[k].y;
+    POSType z = pSPosIn[k].z;
+
+    Int c = pCol[k];
+    if (!SeparableMemo::isSame(x, memo.colArg[0][c]) || !SeparableMemo::isSame(z, memo.colArg[1][c]))
+    {
+      memo.colArg[0][c] = x;
+      memo.colArg[1][c] = z;
+      memo.colVal[0][c] = (POSType)((S_PI-TTrig<bFast>::atan2(z, x))*m_sVideoInfo.iFaceWidth/(2*S_PI));
+    }
+    pSPosOut[k].faceIdx = 0;
+    pSPosOut[k].z = 0;
+    //yaw;
+    pSPosOut[k].x = memo.colVal[0][c];
+    pSPosOut[k].x -= 0.5;
+
+    POSType len = ssqrt(x*x + y*y + z*z);
+    //pitch;
+    pSPosOut[k].y = (POSType)((len < S_EPS? 0.5 : TTrig<bFast>::acos(y/len)/S_PI)*m_sVideoInfo.iFaceHeight);
+    pSPosOut[k].y -= 0.5;
+  }
+}
+#endif
+
 Void TEquiRect::convertYuv(PelUnitBuf *pSrcYuv)
 {
   Int nWidth = m_sVideoInfo.iFaceWidth;
@@ -152,6 +270,11 @@ Void TEquiRect::convertYuv(PelUnitBuf *pSrcYuv)
   assert(pSrcYuv->getNumberValidComponents() == getNumChannels());
 #endif
 
+#if SVIDEO_FUSED_FACE_IMPORT
+  // the faces are sphere padded while they are imported: a row gets its left and right margins as soon as it is
+  // written, the top and bottom margins follow once the channel is complete;
+  Int iNumPaddedChannels = 0;
+#endif
   if(pSrcYuv->chromaFormat==ChromaFormat::_420)
   {
     //memory allocation;
@@ -179,6 +302,9 @@ Void TEquiRect::convertYuv(PelUnitBuf *pSrcYuv)
       if(!ch || (m_chromaFormatIDC==ChromaFormat::_420 && !m_bResampleChroma))
 #endif
       {
+#if SVIDEO_FACE_VIEWS
+        Bool bFaceView = !m_sVideoInfo.bPERP && xViewFace(pSrcYuv->get(chId), pSrc, chId);
+#endif
         pDst = m_pFacesOrig[0][ch];
 #if SVIDEO_BLENDING
         if (m_sVideoInfo.bPERP)
@@ -198,6 +324,9 @@ Void TEquiRect::convertYuv(PelUnitBuf *pSrcYuv)
 
                 for (Int i = iPadWidth_L, k = 0; i < iPadWidth; i++, k ++)
                     pDst[k] = ((i * pSrcPadL[i] + (iPadWidth - i) * pSrcPadR[i]) + (iPadWidth >> 1)) / iPadWidth;
+#if SVIDEO_FUSED_FACE_IMPORT
+                sPadH(pDst, pDst + nWidth, m_iMarginX >> getComponentScaleX(chId));
+#endif
 
                 pDst += getStride(chId);
                 pDstR += getStride(chId);
@@ -211,14 +340,28 @@ Void TEquiRect::convertYuv(PelUnitBuf *pSrcYuv)
         {
           for(Int j=0; j<nHeight; j++)
           {
+#if SVIDEO_FACE_VIEWS
+            if (!bFaceView)
+#endif
             memcpy(pDst, pSrc, nWidth*sizeof(Pel));
+#if SVIDEO_FUSED_FACE_IMPORT
+            sPadH(pDst, pDst + nWidth, m_iMarginX >> getComponentScaleX(chId));
+#endif
             pDst +=  getStride(chId);
             pSrc += pSrcYuv->get(chId).stride;
           }
         }
+#if SVIDEO_FUSED_FACE_IMPORT
+        xPadTopBottom(ch);
+        iNumPaddedChannels++;
+#endif
         continue;
       }
 
+#if SVIDEO_FACE_VIEWS
+      // the resampled chroma is written to the own face buffer;
+      xDetachFaceView(ch);
+#endif
       //padding;
       //left and right; 
       pSrc = pSrcYuv->get(chId).bufAt(0, 0);
@@ -240,12 +383,16 @@ Void TEquiRect::convertYuv(PelUnitBuf *pSrcYuv)
           pSrc += iPadWidth_L;
 #endif
       pDst = pSrc + nWidth/2;
+#if SVIDEO_PADDING_GATHER_TABLE
+      sPadVRows(pSrc, pDst, iStrideTmpBuf, nMarginSizeTmpBuf, nWidth/2+2*nMarginSizeTmpBuf);
+#else
       for(Int i=-nMarginSizeTmpBuf; i<nWidth/2+nMarginSizeTmpBuf; i++)
       {
         sPadV(pSrc, pDst, iStrideTmpBuf, nMarginSizeTmpBuf);
         pSrc ++;
         pDst ++;
       }
+#endif
       //bottom;
       pSrc = pSrcYuv->get(chId).bufAt(0,0) + (nHeight-1)*iStrideTmpBuf-nMarginSizeTmpBuf;
 #if SVIDEO_ERP_PADDING
@@ -253,16 +400,26 @@ Void TEquiRect::convertYuv(PelUnitBuf *pSrcYuv)
           pSrc += iPadWidth_L;
 #endif
       pDst = pSrc + nWidth/2;
+#if SVIDEO_PADDING_GATHER_TABLE
+      sPadVRows(pSrc, pDst, -iStrideTmpBuf, nMarginSizeTmpBuf, nWidth/2+2*nMarginSizeTmpBuf);
+#else
       for(Int i=-nMarginSizeTmpBuf; i<nWidth/2+nMarginSizeTmpBuf; i++)
       {
         sPadV(pSrc, pDst, -iStrideTmpBuf, nMarginSizeTmpBuf);
         pSrc ++;
         pDst ++;
       }
+#endif
       if(m_chromaFormatIDC == ChromaFormat::_444)
       {
         //420->444;
+#if SVIDEO_FUSED_FACE_IMPORT
+        chromaUpsampleWrapPadded(pSrcYuv->get(chId).bufAt(0, 0), nWidth, nHeight, iStrideTmpBuf, 0, chId, m_iMarginX >> getComponentScaleX(chId));
+        xPadTopBottom(ch);
+        iNumPaddedChannels++;
+#else
         chromaUpsample(pSrcYuv->get(chId).bufAt(0, 0), nWidth, nHeight, iStrideTmpBuf, 0, chId);
+#endif
       }
 #if !SVIDEO_CHROMA_TYPES_SUPPORT
       else
@@ -285,14 +442,27 @@ Void TEquiRect::convertYuv(PelUnitBuf *pSrcYuv)
         Int iPadWidth_L = SVIDEO_ERP_PAD_L >> getComponentScaleX(chId);
         if (m_sVideoInfo.bPERP)
             pSrc += iPadWidth_L;
+#endif
+#if SVIDEO_FACE_VIEWS
+        Bool bFaceView = !m_sVideoInfo.bPERP && xViewFace(pSrcYuv->get(chId), pSrc, chId);
 #endif
         Pel *pDst = m_pFacesOrig[0][ch];
         for(Int j=0; j<nHeight; j++)
         {
+#if SVIDEO_FACE_VIEWS
+          if (!bFaceView)
+#endif
           memcpy(pDst, pSrc, nWidth*sizeof(Pel));
+#if SVIDEO_FUSED_FACE_IMPORT
+          sPadH(pDst, pDst + nWidth, m_iMarginX >> getComponentScaleX(chId));
+#endif
           pDst +=  getStride(chId);
           pSrc += pSrcYuv->get(chId).stride;
         }
+#if SVIDEO_FUSED_FACE_IMPORT
+        xPadTopBottom(ch);
+        iNumPaddedChannels++;
+#endif
       }
     }
     else
@@ -302,11 +472,24 @@ Void TEquiRect::convertYuv(PelUnitBuf *pSrcYuv)
     CHECK(true, "Not supported yet");
  
   //set padding flag;
+#if SVIDEO_FUSED_FACE_IMPORT
+  setPaddingFlag(iNumPaddedChannels == getNumChannels());
+#else
   setPaddingFlag(false);
+#endif
 }
 
 Void TEquiRect::sPadH(Pel *pSrc, Pel *pDst, Int iCount)
 {
+#if SVIDEO_PADDING_GATHER_TABLE
+  //the right margin continues the start of the row, the left margin the end of the row;
+  if(pDst-pSrc >= iCount)
+  {
+    memcpy(pDst, pSrc, iCount*sizeof(Pel));
+    memcpy(pSrc-iCount, pDst-iCount, iCount*sizeof(Pel));
+    return;
+  }
+#endif
   for(Int i=1; i<=iCount; i++)
   {
     pDst[i-1] = pSrc[i-1];
@@ -323,6 +506,57 @@ Void TEquiRect::sPadV(Pel *pSrc, Pel *pDst, Int iStride, Int iCount)
   }
 }
 
+#if SVIDEO_PADDING_GATHER_TABLE
+//sPadV() of iWidth consecutive columns, row by row; where the written ranges overlap, pSrc of the later column is the
+//last one written by the column loop and so is written last here too;
+Void TEquiRect::sPadVRows(Pel *pSrc, Pel *pDst, Int iStride, Int iCount, Int iWidth)
+{
+  for(Int i=1; i<=iCount; i++)
+  {
+    memcpy(pDst-i*iStride, pSrc+(i-1)*iStride, iWidth*sizeof(Pel));
+    memcpy(pSrc-i*iStride, pDst+(i-1)*iStride, iWidth*sizeof(Pel));
+  }
+}
+#endif
+
+// top and bottom margins of one channel, from the horizontally padded rows; only top and bottom padding is necessary
+// for the first stage vertical upsampling;
+Void TEquiRect::xPadTopBottom(Int ch)
+{
+  ComponentID chId = (ComponentID)ch;
+  Int nWidth = m_sVideoInfo.iFaceWidth >> getComponentScaleX(chId);
+  Int nHeight = m_sVideoInfo.iFaceHeight >> getComponentScaleY(chId);
+  Int nMarginX = m_iMarginX >> getComponentScaleX(chId);
+  Int nMarginY = m_iMarginY >> getComponentScaleY(chId);
+
+  //top;
+  Pel *pSrc = m_pFacesOrig[0][ch] - nMarginX;
+  Pel *pDst = pSrc + (nWidth>>1);
+#if SVIDEO_PADDING_GATHER_TABLE
+  sPadVRows(pSrc, pDst, getStride(chId), nMarginY, (nWidth>>1)+2*nMarginX);
+#else
+  for(Int i=-nMarginX; i<((nWidth>>1)+nMarginX); i++)
+  {
+    sPadV(pSrc, pDst, getStride(chId), nMarginY);
+    pSrc ++;
+    pDst ++;
+  }
+#endif
+  //bottom;
+  pSrc = m_pFacesOrig[0][ch] + (nHeight-1)*getStride(chId) - nMarginX;
+  pDst = pSrc + (nWidth>>1);
+#if SVIDEO_PADDING_GATHER_TABLE
+  sPadVRows(pSrc, pDst, -getStride(chId), nMarginY, (nWidth>>1)+2*nMarginX);
+#else
+  for(Int i=-nMarginX; i<((nWidth>>1)+nMarginX); i++)
+  {
+    sPadV(pSrc, pDst, -getStride(chId), nMarginY);
+    pSrc ++;
+    pDst ++;
+  }
+#endif
+}
+
 Void TEquiRect::spherePadding(Bool bEnforced)
 {
   if(!bEnforced && m_bPadded)
@@ -344,7 +578,6 @@ Void TEquiRect::spherePadding(Bool bEnforced)
     Int nWidth = m_sVideoInfo.iFaceWidth >> getComponentScaleX(chId);
     Int nHeight = m_sVideoInfo.iFaceHeight >> getComponentScaleY(chId);
     Int nMarginX = m_iMarginX >> getComponentScaleX(chId);
-    Int nMarginY = m_iMarginY >> getComponentScaleY(chId);
 
     //left and right;
     Pel *pSrc = m_pFacesOrig[0][ch];
@@ -355,24 +588,7 @@ Void TEquiRect::spherePadding(Bool bEnforced)
       pSrc += getStride(ComponentID(ch));
       pDst += getStride(ComponentID(ch));
     }
-    //top;
-    pSrc = m_pFacesOrig[0][ch] - nMarginX;
-    pDst = pSrc + (nWidth>>1);
-    for(Int i=-nMarginX; i<((nWidth>>1)+nMarginX); i++)  //only top and bottom padding is necessary for the first stage vertical upsampling;
-    {
-      sPadV(pSrc, pDst, getStride(ComponentID(ch)), nMarginY);
-      pSrc ++;
-      pDst ++;
-    }
-    //bottom;
-    pSrc = m_pFacesOrig[0][ch] + (nHeight-1)*getStride(ComponentID(ch)) - nMarginX;
-    pDst = pSrc + (nWidth>>1);
-    for(Int i=-nMarginX; i<((nWidth>>1)+nMarginX); i++) //only top and bottom padding is necessary for the first stage vertical upsampling;
-    {
-      sPadV(pSrc, pDst, -getStride(ComponentID(ch)), nMarginY);
-      pSrc ++;
-      pDst ++;
-    }
+    xPadTopBottom(ch);
   }
   m_bPadded = true;
 
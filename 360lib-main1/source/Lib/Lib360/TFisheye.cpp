@@ -61,6 +61,18 @@ Void TFisheye::map3DTo2D(SPos *pSPosIn, SPos *pSPosOut)
   }
 }
 
+#if SVIDEO_ROW_PROJECTION
+Void TFisheye::map2DTo3DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap2DTo3DRow(this, pSPosIn, pSPosOut, iNum);
+}
+
+Void TFisheye::map3DTo2DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap3DTo2DRow(this, pSPosIn, pSPosOut, iNum);
+}
+#endif
+
 Void TFisheye::convertYuv(PelUnitBuf *pSrcYuv)
 {
   Int nWidth = m_sVideoInfo.iFaceWidth;
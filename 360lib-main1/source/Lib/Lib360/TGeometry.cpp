@@ -36,6 +36,9 @@
 */
 
 #include <math.h>
+#include <algorithm>
+#include <memory>
+#include <mutex>
 #include "../CommonLib/ChromaFormat.h"
 #include "TGeometry.h"
 #include "TEquiRect.h"
@@ -81,6 +84,21 @@
 #if SVIDEO_GENERALIZED_CUBEMAP
 #include "TGeneralizedCubeMap.h"
 #endif
+#if SVIDEO_PARALLEL_PROCESSING
+#include "TThreadPool.h"
+#endif
+#if SVIDEO_WEIGHT_MAP_CACHE
+#include "TWeightMapCache.h"
+#endif
+#if SVIDEO_CONVERSION_CACHE
+#include "TGeometryKey.h"
+#endif
+#if SVIDEO_CHROMA_RESAMPLE_KERNELS
+#include "../CommonLib/Resample360.h"
+#endif
+#if SVIDEO_WSPSNR_WEIGHT_PLANE
+#include "../CommonLib/Metric360.h"
+#endif
 
 #if EXTENSION_360_VIDEO
 
@@ -97,6 +115,27 @@ template<typename T> static inline Int filter1D(T *pSrc, Int iStride, Filter1DIn
   return ret;
 }
 
+#if SVIDEO_COMPACT_WEIGHT_MAP
+// weight tables of the geometries that compact their weight maps; a table depends on the interpolation type only, so
+// it is built once for the process and freed at exit;
+static struct SharedWeightLuts
+{
+  std::mutex mutex;
+  Int      **pLut[SI_TYPE_NUM] = { nullptr };
+  ~SharedWeightLuts()
+  {
+    for (Int i = 0; i < SI_TYPE_NUM; i++)
+    {
+      if (pLut[i])
+      {
+        delete[] pLut[i][0];
+        delete[] pLut[i];
+      }
+    }
+  }
+} s_sharedWeightLuts;
+#endif
+
 TChar TGeometry::m_strGeoName[SVIDEO_TYPE_NUM][256] = { { "Equirectangular" },
                                                         { "Cubemap" },
 #if SVIDEO_ADJUSTED_EQUALAREA
@@ -177,6 +216,13 @@ TGeometry::TGeometry()
   m_pFaceRotBuf           = nullptr;
 
   m_bPadded               = false;
+#if SVIDEO_CONVERSION_CACHE
+  m_uiFacesStamp          = 0;
+#endif
+#if SVIDEO_FACE_VIEWS
+  m_iFaceViewSrcMargin    = 0;
+  memset(m_bFaceView, 0, sizeof(m_bFaceView));
+#endif
   m_pUpsTempBuf           = nullptr;
   m_iUpsTempBufMarginSize = 0;
   m_iStrideUpsTempBuf     = 0;
@@ -200,6 +246,25 @@ TGeometry::TGeometry()
   memset(m_pWeightLut, 0, sizeof(m_pWeightLut));
   memset(m_iInterpFilterTaps, 0, sizeof(m_iInterpFilterTaps));
   m_bConvOutputPaddingNeeded = false;
+#if SVIDEO_PARALLEL_PROCESSING
+  m_iNumThreads = 1;
+#endif
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+  m_bFastGeometryMapping = false;
+#endif
+#if SVIDEO_COMPACT_WEIGHT_MAP
+  m_bCompactWeightMap = false;
+  m_bSharedWeightLut  = false;
+  memset(m_pCompactWeightMap, 0, sizeof(m_pCompactWeightMap));
+  memset(m_bCompactWeightMapTried, 0, sizeof(m_bCompactWeightMapTried));
+#endif
+#if SVIDEO_FRAME_PIPELINE
+  m_bSharedWeightMaps               = false;
+  m_bSharedWeightMaps4SpherePadding = false;
+#endif
+#if SVIDEO_PADDING_GATHER_TABLE
+  memset(m_pPaddingTable, 0, sizeof(m_pPaddingTable));
+#endif
 }
 
 Void TGeometry::geoInit(SVideoInfo &sVideoInfo, InputGeoParam *pInGeoParam)
@@ -213,6 +278,22 @@ Void TGeometry::geoInit(SVideoInfo &sVideoInfo, InputGeoParam *pInGeoParam)
 #endif
   m_bPadded                   = false;
   m_WeightMap_NumOfBits4Faces = S_log2NumFaces[m_sVideoInfo.iNumFaces];
+#if SVIDEO_PARALLEL_PROCESSING
+  setNumThreads(pInGeoParam->iNumThreads);
+#endif
+#if SVIDEO_WEIGHT_MAP_CACHE
+  m_sWeightMapCacheDir   = pInGeoParam->sWeightMapCacheDir;
+  m_iWeightMapCacheMaxMB = pInGeoParam->iWeightMapCacheMaxMB;
+#endif
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+  m_bFastGeometryMapping = pInGeoParam->bFastGeometryMapping;
+#endif
+#if SVIDEO_COMPACT_WEIGHT_MAP
+  // the viewport keeps the full maps of the recent orientations in its map cache;
+  m_bCompactWeightMap = pInGeoParam->bCompactWeightMap && m_sVideoInfo.geoType != SVIDEO_VIEWPORT;
+  m_bSharedWeightLut  = pInGeoParam->bCompactWeightMap;
+#endif
+  initSimdOps();
   initInterpolation(pInGeoParam->iInterp);
 
   initFilterWeightLut();
@@ -306,35 +387,62 @@ TGeometry::~TGeometry()
     xFree(m_pUpsTempBuf);
     m_pUpsTempBuf = nullptr;
   }
+#if SVIDEO_FRAME_PIPELINE
+  // the owner frees the shared maps;
+  if (m_bSharedWeightMaps)
+  {
+    memset(m_pPixelWeight, 0, sizeof(m_pPixelWeight));
+#if SVIDEO_COMPACT_WEIGHT_MAP
+    memset(m_pCompactWeightMap, 0, sizeof(m_pCompactWeightMap));
+#endif
+  }
+  if (m_bSharedWeightMaps4SpherePadding)
+  {
+    memset(m_pPixelWeight4SherePadding, 0, sizeof(m_pPixelWeight4SherePadding));
+  }
+#endif
   for (Int i = 0; i < SV_MAX_NUM_FACES; i++)
   {
-    if (m_pPixelWeight[i])
+    for (Int j = 0; j < 2; j++)
     {
-      for (Int j = 0; j < 2; j++)
+      if (m_pPixelWeight[i][j])
       {
-        if (m_pPixelWeight[i][j])
-        {
-          delete[] m_pPixelWeight[i][j];
-          m_pPixelWeight[i][j] = nullptr;
-        }
+        delete[] m_pPixelWeight[i][j];
+        m_pPixelWeight[i][j] = nullptr;
       }
+#if SVIDEO_COMPACT_WEIGHT_MAP
+      delete m_pCompactWeightMap[i][j];
+      m_pCompactWeightMap[i][j]     = nullptr;
+      m_bCompactWeightMapTried[i][j] = false;
+#endif
     }
-    if (m_pPixelWeight4SherePadding[i])
+    for (Int j = 0; j < 2; j++)
     {
-      for (Int j = 0; j < 2; j++)
+      if (m_pPixelWeight4SherePadding[i][j])
       {
         if (m_pPixelWeight4SherePadding[i][j])
         {
-          if (m_pPixelWeight4SherePadding[i][j])
-          {
-            delete[] m_pPixelWeight4SherePadding[i][j];
-            m_pPixelWeight4SherePadding[i][j] = nullptr;
-          }
+          delete[] m_pPixelWeight4SherePadding[i][j];
+          m_pPixelWeight4SherePadding[i][j] = nullptr;
         }
       }
     }
+#if SVIDEO_PADDING_GATHER_TABLE
+    for (Int j = 0; j < 2; j++)
+    {
+      delete m_pPaddingTable[i][j];
+      m_pPaddingTable[i][j] = nullptr;
+    }
+#endif
   }
 
+#if SVIDEO_COMPACT_WEIGHT_MAP
+  // the shared weight tables are freed at exit, see initFilterWeightLut();
+  if (m_bSharedWeightLut)
+  {
+    memset(m_pWeightLut, 0, sizeof(m_pWeightLut));
+  }
+#endif
   for (Int j = 0; j < 2; j++)
   {
     if (m_pWeightLut[j])
@@ -375,6 +483,27 @@ TGeometry::~TGeometry()
   }
 }
 
+/**
+ * Selects the SIMD kernels of the 360 function tables once per process; the tables are shared by all geometries
+ * and threads, so they must not be rewritten while another conversion runs (as EncLib/DecLib do for g_pelBufOP).
+ */
+Void TGeometry::initSimdOps()
+{
+  static std::once_flag s_simdOpsInit;
+  std::call_once(s_simdOpsInit, []()
+  {
+#if SVIDEO_INTERP_KERNELS && ENABLE_SIMD_OPT_INTERP360
+    g_interp360OP.initInterp360OpsX86();
+#endif
+#if SVIDEO_CHROMA_RESAMPLE_KERNELS && ENABLE_SIMD_OPT_RESAMPLE360
+    g_resample360OP.initResample360OpsX86();
+#endif
+#if SVIDEO_WSPSNR_WEIGHT_PLANE && ENABLE_SIMD_OPT_METRIC360
+    g_metric360OP.initMetric360OpsX86();
+#endif
+  });
+}
+
 TGeometry *TGeometry::create(SVideoInfo &sVideoInfo, InputGeoParam *pInGeoParam)
 {
   TGeometry *pRet = nullptr;
@@ -450,6 +579,62 @@ Void TGeometry::clamp(IPos *pIPos)
   pIPos->v = Clip3(0, m_sVideoInfo.iFaceHeight - 1, (Int) pIPos->v);
 }
 
+#if SVIDEO_CHROMA_RESAMPLE_KERNELS
+// runs func(iRowStart, iRowEnd) on the bands of S_PARALLEL_ROW_BAND rows of [0, iNumRows);
+template<typename F> static Void forRowBands(Int iNumThreads, Int iNumRows, const F &func)
+{
+  Int iNumBands = (iNumRows + S_PARALLEL_ROW_BAND - 1) / S_PARALLEL_ROW_BAND;
+  TThreadPool::runTasks(iNumThreads, iNumBands, [&](Int iBand) {
+    func(iBand * S_PARALLEL_ROW_BAND, std::min(iNumRows, (iBand + 1) * S_PARALLEL_ROW_BAND));
+  });
+}
+
+// 1->2 upsampling of the source rows [iRowStart, iRowEnd) into pDstBuf, as chromaUpsample(): the two output rows of a
+// source row are filtered horizontally while their vertical intermediate is in cache; nMarginX samples of horizontal
+// wrap-around padding are added to each output row (ERP);
+Void TGeometry::xChromaUpsampleRows(Pel *pSrcBuf, Int nWidthC, Int iStrideSrc, Pel *pDstBuf, Int iStrideDst, Int iRowStart, Int iRowEnd, Int nMarginX)
+{
+  Int nWidth     = nWidthC << 1;
+  Int iMarginTmp = std::max(m_filterUps[0].nTaps, m_filterUps[1].nTaps) >> 1;
+  Int iStrideTmp = nWidthC + iMarginTmp * 2;
+  Int iWidthTmp  = nWidthC + 2 * iMarginTmp - 1;
+  std::vector<Int> tmpRows(iStrideTmp * 2);
+
+  // the kernels take the first tap: the centre of filter1D() less (nTaps-1)>>1 samples;
+  Pel *pSrc0 = pSrcBuf + iRowStart * iStrideSrc - iMarginTmp + 1 + (m_filterUps[2].nTaps > 1 ? -iStrideSrc : 0)
+               - ((m_filterUps[2].nTaps - 1) >> 1) * iStrideSrc;
+  Pel *pSrc1 = pSrcBuf + iRowStart * iStrideSrc - iMarginTmp + 1 - ((m_filterUps[3].nTaps - 1) >> 1) * iStrideSrc;
+  Int *pTmp0 = tmpRows.data() + 1;
+  Int *pTmp1 = pTmp0 + iStrideTmp;
+  Int  iOff0 = iMarginTmp + (m_filterUps[0].nTaps > 1 ? -1 : 0) - ((m_filterUps[0].nTaps - 1) >> 1);
+  Int  iOff1 = iMarginTmp - ((m_filterUps[1].nTaps - 1) >> 1);
+  Pel *pOut  = pDstBuf + (iRowStart << 1) * iStrideDst;
+  Int  iBitShift = m_filterUps[0].nlog2Norm + m_filterUps[2].nlog2Norm;
+  for (Int j = iRowStart; j < iRowEnd; j++)
+  {
+    // vertical upsampling;
+    g_resample360OP.filterVer(pSrc0, iStrideSrc, pTmp0, iWidthTmp, m_filterUps[2].iFilterCoeff, m_filterUps[2].nTaps);
+    g_resample360OP.filterVer(pSrc1, iStrideSrc, pTmp1, iWidthTmp, m_filterUps[3].iFilterCoeff, m_filterUps[3].nTaps);
+    pSrc0 += iStrideSrc;
+    pSrc1 += iStrideSrc;
+
+    // horizontal filtering;
+    for (Int k = 0; k < 2; k++)
+    {
+      const Int *pRow = tmpRows.data() + k * iStrideTmp;
+      g_resample360OP.filterHorUp(pRow + iOff0, pRow + iOff1, pOut, nWidthC, m_filterUps[0].iFilterCoeff, m_filterUps[0].nTaps,
+                                  m_filterUps[1].iFilterCoeff, m_filterUps[1].nTaps, iBitShift, m_nBitDepth);
+      for (Int i = 1; i <= nMarginX; i++)
+      {
+        pOut[nWidth + i - 1] = pOut[i - 1];
+        pOut[-i]             = pOut[nWidth - i];
+      }
+      pOut += iStrideDst;
+    }
+  }
+}
+#endif
+
 // 1->2 upsampling;
 Void TGeometry::chromaUpsample(Pel *pSrcBuf, Int nWidthC, Int nHeightC, Int iStrideSrc, Int iFaceId, ComponentID chId)
 {
@@ -457,6 +642,11 @@ Void TGeometry::chromaUpsample(Pel *pSrcBuf, Int nWidthC, Int nHeightC, Int iStr
   Int nHeight = nHeightC << 1;
   CHECK(m_sVideoInfo.iFaceWidth != nWidth, "");
   CHECK(m_sVideoInfo.iFaceHeight != nHeight, "");
+#if SVIDEO_CHROMA_RESAMPLE_KERNELS
+  forRowBands(m_iNumThreads, nHeightC, [&](Int iRowStart, Int iRowEnd) {
+    xChromaUpsampleRows(pSrcBuf, nWidthC, iStrideSrc, m_pFacesOrig[iFaceId][chId], getStride(chId), iRowStart, iRowEnd, 0);
+  });
+#else
   // vertical upsampling;  [-2, 16, 54, -4]; [-4, 54, 16, -2];
   Int iStrideDst = getStride(chId);
 
@@ -502,12 +692,137 @@ Void TGeometry::chromaUpsample(Pel *pSrcBuf, Int nWidthC, Int nHeightC, Int iStr
     pDst0 += m_iStrideUpsTempBuf;
     pDst1 += m_iStrideUpsTempBuf;
   }
+#endif
+}
+
+#if SVIDEO_FUSED_FACE_IMPORT
+// 1->2 upsampling as chromaUpsample(), one source row at a time: the two output rows are filtered horizontally while
+// their vertical intermediate is still in cache, then get nMarginX samples of horizontal wrap-around padding (ERP);
+Void TGeometry::chromaUpsampleWrapPadded(Pel *pSrcBuf, Int nWidthC, Int nHeightC, Int iStrideSrc, Int iFaceId, ComponentID chId, Int nMarginX)
+{
+  Int nWidth  = nWidthC << 1;
+  Int nHeight = nHeightC << 1;
+  CHECK(m_sVideoInfo.iFaceWidth != nWidth, "");
+  CHECK(m_sVideoInfo.iFaceHeight != nHeight, "");
+#if SVIDEO_CHROMA_RESAMPLE_KERNELS
+  forRowBands(m_iNumThreads, nHeightC, [&](Int iRowStart, Int iRowEnd) {
+    xChromaUpsampleRows(pSrcBuf, nWidthC, iStrideSrc, m_pFacesOrig[iFaceId][chId], getStride(chId), iRowStart, iRowEnd, nMarginX);
+  });
+#else
+  Int iStrideDst = getStride(chId);
+
+  Int iMarginTmp = std::max(m_filterUps[0].nTaps, m_filterUps[1].nTaps) >> 1;
+  Int iStrideTmp = nWidthC + iMarginTmp * 2;
+  std::vector<Int> tmpRows(iStrideTmp * 2);
+
+  Pel *pSrc0     = pSrcBuf - iMarginTmp + 1 + (m_filterUps[2].nTaps > 1 ? -iStrideSrc : 0);
+  Pel *pSrc1     = pSrcBuf - iMarginTmp + 1;
+  Pel *pOut      = m_pFacesOrig[iFaceId][chId];
+  Int  iBitShift = m_filterUps[0].nlog2Norm + m_filterUps[2].nlog2Norm;
+  Int  iOffset   = iBitShift ? (1 << (iBitShift - 1)) : 0;
+  for (Int j = 0; j < nHeightC; j++)
+  {
+    // vertical upsampling;  [-2, 16, 54, -4]; [-4, 54, 16, -2];
+    Int *pDst0 = tmpRows.data() + 1;
+    Int *pDst1 = pDst0 + iStrideTmp;
+    for (Int i = 0; i < nWidthC + 2 * iMarginTmp - 1; i++)
+    {
+      pDst0[i] = filter1D(pSrc0 + i, iStrideSrc, m_filterUps + 2);
+      pDst1[i] = filter1D(pSrc1 + i, iStrideSrc, m_filterUps + 3);
+    }
+    pSrc0 += iStrideSrc;
+    pSrc1 += iStrideSrc;
+
+    // horizontal filtering; [-4, 36, 36, -4]
+    for (Int k = 0; k < 2; k++)
+    {
+      Int *pRow0 = tmpRows.data() + k * iStrideTmp + iMarginTmp + (m_filterUps[0].nTaps > 1 ? -1 : 0);
+      Int *pRow1 = tmpRows.data() + k * iStrideTmp + iMarginTmp;
+      for (Int i = 0; i < nWidthC; i++)
+      {
+        Int val              = filter1D(pRow0 + i, 1, m_filterUps);
+        pOut[(i << 1)]       = ClipBD<Int>((val + iOffset) >> iBitShift, m_nBitDepth);
+        val                  = filter1D(pRow1 + i, 1, m_filterUps + 1);
+        pOut[((i << 1) + 1)] = ClipBD<Int>((val + iOffset) >> iBitShift, m_nBitDepth);
+      }
+      for (Int i = 1; i <= nMarginX; i++)
+      {
+        pOut[nWidth + i - 1] = pOut[i - 1];
+        pOut[-i]             = pOut[nWidth - i];
+      }
+      pOut += iStrideDst;
+    }
+  }
+#endif
+}
+#endif
+
+#if SVIDEO_FACE_VIEWS
+// lets face 0 of a channel reference the source picture at pSrc, which becomes the top-left sample of the face;
+// the weight maps address the faces as y*getStride()+x, so only a source with the same stride and at least the face
+// margins (which receive the sphere padding) can be referenced; otherwise the face falls back to its own buffer;
+Bool TGeometry::xViewFace(const PelBuf &srcBuf, Pel *pSrc, ComponentID chId)
+{
+  Int ch = (Int)chId;
+  if (m_sVideoInfo.iNumFaces != 1 || m_iFaceViewSrcMargin < std::max(m_iMarginX, m_iMarginY)
+      || (Int) srcBuf.stride != getStride(chId))
+  {
+    xDetachFaceView(ch);
+    return false;
+  }
+  if (m_pFacesBuf[0][ch])
+  {
+    xFree(m_pFacesBuf[0][ch]);
+    m_pFacesBuf[0][ch] = nullptr;
+  }
+  m_pFacesOrig[0][ch] = pSrc;
+  m_bFaceView[ch]     = true;
+  return true;
+}
+
+// face 0 of the channel gets its own buffer back, e.g. before it is written as a conversion destination;
+Void TGeometry::xDetachFaceView(Int ch)
+{
+  if (!m_bFaceView[ch])
+  {
+    return;
+  }
+  ComponentID chId = ComponentID(ch);
+  if (!m_pFacesBuf[0][ch])
+  {
+    Int iTotalHeight   = (m_sVideoInfo.iFaceHeight + (m_iMarginY << 1)) >> getComponentScaleY(chId);
+    m_pFacesBuf[0][ch] = (Pel *) xMalloc(Pel, getStride(chId) * iTotalHeight);
+  }
+  m_pFacesOrig[0][ch] = m_pFacesBuf[0][ch] + getStride(chId) * getMarginY(chId) + getMarginX(chId);
+  m_bFaceView[ch]     = false;
+}
+
+Void TGeometry::xDetachFaceViews()
+{
+  for (Int ch = 0; ch < getNumChannels(); ch++)
+  {
+    xDetachFaceView(ch);
+  }
 }
+#endif
 
 // horizontal 2:1 downsampling; //[1,6,1]
 Void TGeometry::chromaDonwsampleH(Pel *pSrcBuf, Int iWidth, Int iHeight, Int iStrideSrc, Int iNumPels, Pel *pDstBuf,
                                   Int iStrideDst)
 {
+#if SVIDEO_CHROMA_RESAMPLE_KERNELS
+  if (iNumPels == 1)
+  {
+    forRowBands(m_iNumThreads, iHeight, [&](Int iRowStart, Int iRowEnd) {
+      for (Int j = iRowStart; j < iRowEnd; j++)
+      {
+        g_resample360OP.filterHorDown(pSrcBuf + j * iStrideSrc - ((m_filterDs[0].nTaps - 1) >> 1), pDstBuf + j * iStrideDst,
+                                      iWidth >> 1, m_filterDs[0].iFilterCoeff, m_filterDs[0].nTaps);
+      }
+    });
+    return;
+  }
+#endif
   Pel *pSrc = pSrcBuf;
   Pel *pDst = pDstBuf;
   for (Int j = 0; j < iHeight; j++)
@@ -527,6 +842,20 @@ Void TGeometry::chromaDonwsampleV(Pel *pSrcBuf, Int iWidth, Int iHeight, Int iSt
                                   Int iStrideDst)
 {
   Int  iBitShift = m_filterDs[0].nlog2Norm + m_filterDs[1].nlog2Norm + (m_nBitDepth - m_nOutputBitDepth);   // 3+1;
+#if SVIDEO_CHROMA_RESAMPLE_KERNELS
+  if (iNumPels == 1)
+  {
+    forRowBands(m_iNumThreads, iHeight >> 1, [&](Int iRowStart, Int iRowEnd) {
+      for (Int j = iRowStart; j < iRowEnd; j++)
+      {
+        g_resample360OP.filterVerClip(pSrcBuf + ((j << 1) - ((m_filterDs[1].nTaps - 1) >> 1)) * iStrideSrc, iStrideSrc,
+                                      pDstBuf + j * iStrideDst, iWidth, m_filterDs[1].iFilterCoeff, m_filterDs[1].nTaps,
+                                      iBitShift, m_nOutputBitDepth);
+      }
+    });
+    return;
+  }
+#endif
   Int  iOffset   = iBitShift ? (1 << (iBitShift - 1)) : 0;
   Pel *pSrc      = pSrcBuf;
   // Pel *pSrc1 = pSrcBuf+iStrideSrc;
@@ -619,6 +948,18 @@ Void TGeometry::initFilterWeightLut()
     Int iNumWLuts = (m_chromaFormatIDC == ChromaFormat::_400 || (m_InterpolationType[0] == m_InterpolationType[1])) ? 1 : 2;
     for (Int i = 0; i < iNumWLuts; i++)
     {
+#if SVIDEO_COMPACT_WEIGHT_MAP
+      std::unique_lock<std::mutex> lock(s_sharedWeightLuts.mutex, std::defer_lock);
+      if (m_bSharedWeightLut)
+      {
+        lock.lock();
+        if (s_sharedWeightLuts.pLut[m_InterpolationType[i]])
+        {
+          m_pWeightLut[i] = s_sharedWeightLuts.pLut[m_InterpolationType[i]];
+          continue;
+        }
+      }
+#endif
       Int iFilterSize    = getFilterSize(m_InterpolationType[i]);
       m_pWeightLut[i]    = new Int *[(S_LANCZOS_LUT_SCALE + 1) * (S_LANCZOS_LUT_SCALE + 1)];
       m_pWeightLut[i][0] = new Int[(S_LANCZOS_LUT_SCALE + 1) * (S_LANCZOS_LUT_SCALE + 1) * iFilterSize];
@@ -736,6 +1077,12 @@ Void TGeometry::initFilterWeightLut()
           }
         }
       }
+#if SVIDEO_COMPACT_WEIGHT_MAP
+      if (m_bSharedWeightLut)
+      {
+        s_sharedWeightLuts.pLut[m_InterpolationType[i]] = m_pWeightLut[i];
+      }
+#endif
     }
   }
 }
@@ -870,6 +1217,22 @@ Void TGeometry::convertYuv(PelUnitBuf *pSrcYuv)
   CHECK(true, "override");
 }
 
+#if SVIDEO_ROT_FIX
+/***************************************************
+//rotation of the mapping from pGeoSrc: the rotation of this geometry, or the inverse rotation of pGeoSrc when
+//the reconstruction is mapped back to the source geometry (bRec);
+****************************************************/
+TGeometry::RotationFunc TGeometry::xGetMappingRotation(TGeometry *pGeoSrc, Bool bRec, Int pRot[3])
+{
+  const Int *pDegree = bRec ? pGeoSrc->m_sVideoInfo.sVideoRotation.degree : m_sVideoInfo.sVideoRotation.degree;
+  for (Int i = 0; i < 3; i++)
+  {
+    pRot[i] = bRec ? -pDegree[i] : pDegree[i];
+  }
+  return bRec ? &TGeometry::invRotate3D : &TGeometry::rotate3D;
+}
+#endif
+
 #if SVIDEO_ROT_FIX
 Void TGeometry::geometryMapping(TGeometry *pGeoSrc, Bool bRec)
 #else
@@ -884,21 +1247,7 @@ Void TGeometry::geometryMapping(TGeometry *pGeoSrc)
                    : 2;
 #if SVIDEO_ROT_FIX
   Int pRot[3];
-  Void (TGeometry::*pfuncRotation)(SPos & sPos, Int iRoll, Int iPitch, Int iYaw) = nullptr;
-  if (bRec)
-  {
-    pfuncRotation = &TGeometry::invRotate3D;
-    pRot[0]       = -pGeoSrc->m_sVideoInfo.sVideoRotation.degree[0];
-    pRot[1]       = -pGeoSrc->m_sVideoInfo.sVideoRotation.degree[1];
-    pRot[2]       = -pGeoSrc->m_sVideoInfo.sVideoRotation.degree[2];
-  }
-  else
-  {
-    pfuncRotation = &TGeometry::rotate3D;
-    pRot[0]       = m_sVideoInfo.sVideoRotation.degree[0];
-    pRot[1]       = m_sVideoInfo.sVideoRotation.degree[1];
-    pRot[2]       = m_sVideoInfo.sVideoRotation.degree[2];
-  }
+  RotationFunc pfuncRotation = xGetMappingRotation(pGeoSrc, bRec, pRot);
 #else
   Int *pRot = m_sVideoInfo.sVideoRotation.degree;
 #endif
@@ -932,6 +1281,19 @@ Void TGeometry::geometryMapping(TGeometry *pGeoSrc)
   }
 #endif
 
+#if SVIDEO_WEIGHT_MAP_CACHE
+  TWeightMapCache wmCache(m_sWeightMapCacheDir, m_iWeightMapCacheMaxMB);
+  if (wmCache.isEnabled())
+  {
+    wmCache.addKey(Int(0));   //0: conversion map; 1: sphere padding map;
+    xAddWeightMapCacheKey(wmCache);
+    pGeoSrc->xAddWeightMapCacheKey(wmCache);
+#if SVIDEO_ROT_FIX
+    wmCache.addKey(bRec);
+#endif
+    wmCache.addKey(pRot, 3 * sizeof(Int));
+  }
+#endif
   for (Int fIdx = 0; fIdx < m_sVideoInfo.iNumFaces; fIdx++)
   {
 #if SVIDEO_GENERALIZED_CUBEMAP
@@ -954,6 +1316,9 @@ Void TGeometry::geometryMapping(TGeometry *pGeoSrc)
       {
         m_pPixelWeight[fIdx][ch] = new PxlFltLut[iWidthPW * iHeightPW];
       }
+#if SVIDEO_WEIGHT_MAP_CACHE
+      wmCache.addMap(m_pPixelWeight[fIdx][ch], (int64_t) iWidthPW * iHeightPW);
+#endif
     }
   }
 
@@ -963,7 +1328,32 @@ Void TGeometry::geometryMapping(TGeometry *pGeoSrc)
     ((TViewPort *) this)->setRotMat();
     ((TViewPort *) this)->setInvK();
   }
+#if SVIDEO_WEIGHT_MAP_CACHE
+  if (wmCache.load())
+  {
+    m_bGeometryMapping = true;
+    return;
+  }
+#endif
   // generate the map;
+#if SVIDEO_PARALLEL_PROCESSING
+  std::vector<RowBand> rowBands;
+  xGetRowBands(iNumMaps, -1, rowBands);
+  TThreadPool::runTasks(m_iNumThreads, (Int) rowBands.size(), [&](Int iTask) {
+    const RowBand &band = rowBands[iTask];
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+    TFastMath::Scope fastMath(m_bFastGeometryMapping);
+#endif
+#if SVIDEO_ROT_FIX
+    xGeometryMappingRows(pGeoSrc, band.fIdx, band.ch, band.iRowStart, band.iRowEnd, pfuncRotation, pRot);
+#else
+    xGeometryMappingRows(pGeoSrc, band.fIdx, band.ch, band.iRowStart, band.iRowEnd, pRot);
+#endif
+  });
+#else
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+  TFastMath::Scope fastMath(m_bFastGeometryMapping);
+#endif
   for (Int fIdx = 0; fIdx < m_sVideoInfo.iNumFaces; fIdx++)
   {
 #if SVIDEO_GENERALIZED_CUBEMAP
@@ -1060,65 +1450,461 @@ Void TGeometry::geometryMapping(TGeometry *pGeoSrc)
         }
     }
   }
+#endif
+#if SVIDEO_WEIGHT_MAP_CACHE
+  wmCache.store();
+#endif
   m_bGeometryMapping = true;
 }
 
+#if SVIDEO_ROW_PROJECTION
 /***************************************************
-//convert source geometry to destination geometry;
+//row-at-a-time projection; the geometries bind their own per-sample functions statically;
 ****************************************************/
-Void TGeometry::geoConvert(TGeometry *pGeoDst
-#if SVIDEO_ROT_FIX
-                           ,
-                           Bool bRec
+Void TGeometry::map2DTo3DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  for (Int i = 0; i < iNum; i++)
+  {
+    map2DTo3D(pSPosIn[i], pSPosOut + i);
+  }
+}
+
+Void TGeometry::map3DTo2DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  for (Int i = 0; i < iNum; i++)
+  {
+    map3DTo2D(pSPosIn + i, pSPosOut + i);
+  }
+}
+
+Void TGeometry::insideFaceRow(Int fId, Int x, Int iStepX, Int y, Int iNum, ComponentID chId, ComponentID origchId,
+                              Bool *pbInside)
+{
+  xInsideFaceRow(this, fId, x, iStepX, y, iNum, chId, origchId, pbInside);
+}
 #endif
-)
+
+#if SVIDEO_SEPARABLE_MAPPING
+Void SeparableMemo::init(Int iNumColumns)
 {
-  // padding;
-  spherePadding();
+  // NaN never matches an argument, every entry starts empty;
+  rowArg = std::numeric_limits<POSType>::quiet_NaN();
+  for (Int k = 0; k < 2; k++)
+  {
+    colArg[k].assign(iNumColumns, std::numeric_limits<POSType>::quiet_NaN());
+    colVal[k].assign(iNumColumns, 0);
+  }
+}
 
-  if (!pGeoDst->m_bGeometryMapping)
+Void TGeometry::map2DTo3DRowMemo(SPos *pSPosIn, SPos *pSPosOut, Int iNum, const Int *, SeparableMemo &)
+{
+  map2DTo3DRow(pSPosIn, pSPosOut, iNum);
+}
+
+Void TGeometry::map3DTo2DRowMemo(SPos *pSPosIn, SPos *pSPosOut, Int iNum, const Int *, SeparableMemo &)
+{
+  map3DTo2DRow(pSPosIn, pSPosOut, iNum);
+}
+#endif
+
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+/***************************************************
+//compare the luma source positions of the fast mapping with the double-precision ones;
+****************************************************/
 #if SVIDEO_ROT_FIX
-    pGeoDst->geometryMapping(this, bRec);
+Void TGeometry::checkFastGeometryMapping(TGeometry *pGeoSrc, GeoMappingError &err, Bool bRec)
 #else
-    pGeoDst->geometryMapping(this);
+Void TGeometry::checkFastGeometryMapping(TGeometry *pGeoSrc, GeoMappingError &err)
 #endif
+{
+  memset(&err, 0, sizeof(err));
+  if (m_sVideoInfo.geoType == SVIDEO_VIEWPORT)
+  {
+    ((TViewPort *) this)->setRotMat();
+    ((TViewPort *) this)->setInvK();
+  }
+#if SVIDEO_ROT_FIX
+  Int pRot[3];
+  RotationFunc pfuncRotation = xGetMappingRotation(pGeoSrc, bRec, pRot);
+#else
+  Int *pRot    = m_sVideoInfo.sVideoRotation.degree;
+#endif
+  Int  iWidth  = m_sVideoInfo.iFaceWidth;
+  Int  iHeight = m_sVideoInfo.iFaceHeight;
+  Int  iWrap   = pGeoSrc->m_sVideoInfo.iFaceWidth;
 
-  Int nFaces             = pGeoDst->m_sVideoInfo.iNumFaces;
-  Int iBDPrecision       = S_INTERPOLATE_PrecisionBD;
-  Int iWeightMapFaceMask = (1 << m_WeightMap_NumOfBits4Faces) - 1;
-  Int iOffset            = 1 << (iBDPrecision - 1);
-
-  for (Int fIdx = 0; fIdx < nFaces; fIdx++)
+  for (Int fIdx = 0; fIdx < m_sVideoInfo.iNumFaces; fIdx++)
   {
 #if SVIDEO_GENERALIZED_CUBEMAP
-    if (pGeoDst->m_sVideoInfo.geoType == SVIDEO_GENERALIZEDCUBEMAP
-        && (pGeoDst->m_sVideoInfo.iGCMPPackingType == 4 || pGeoDst->m_sVideoInfo.iGCMPPackingType == 5))
+    if (m_sVideoInfo.geoType == SVIDEO_GENERALIZEDCUBEMAP
+        && (m_sVideoInfo.iGCMPPackingType == 4 || m_sVideoInfo.iGCMPPackingType == 5))
     {
-      Int virtualFaceIdx = pGeoDst->m_sVideoInfo.iGCMPPackingType == 4
-                             ? pGeoDst->m_sVideoInfo.framePackStruct.faces[0][5].id
-                             : pGeoDst->m_sVideoInfo.framePackStruct.faces[5][0].id;
+      Int virtualFaceIdx = m_sVideoInfo.iGCMPPackingType == 4 ? m_sVideoInfo.framePackStruct.faces[0][5].id
+                                                              : m_sVideoInfo.framePackStruct.faces[5][0].id;
       if (fIdx == virtualFaceIdx)
         continue;
     }
 #endif
-    for (Int ch = 0; ch < pGeoDst->getNumChannels(); ch++)
-    {
-      ComponentID chId    = (ComponentID) ch;
-      Int         nWidth  = pGeoDst->m_sVideoInfo.iFaceWidth >> pGeoDst->getComponentScaleX(chId);
-      Int         nHeight = pGeoDst->m_sVideoInfo.iFaceHeight >> pGeoDst->getComponentScaleY(chId);
-
-      Int nMarginX = pGeoDst->m_iMarginX >> pGeoDst->getComponentScaleX(chId);
-      Int nMarginY = pGeoDst->m_iMarginY >> pGeoDst->getComponentScaleY(chId);
-      Int iWidthPW = pGeoDst->getStride(chId);
-      Int mapIdx =
-        (pGeoDst->m_chromaFormatIDC == ChromaFormat::_444
-         && pGeoDst->m_InterpolationType[Int(ChannelType::LUMA)] == pGeoDst->m_InterpolationType[Int(ChannelType::CHROMA)])
-          ? 0
-          : (ch > 0 ? 1 : 0);
-      ChannelType chType = toChannelType(chId);
-
-      for (Int j = -nMarginY; j < nHeight + nMarginY; j++)
-        for (Int i = -nMarginX; i < nWidth + nMarginX; i++)
+    for (Int j = 0; j < iHeight; j++)
+      for (Int i = 0; i < iWidth; i++)
+      {
+        if (!insideFace(fIdx, i, j, COMPONENT_Y, COMPONENT_Y))
+          continue;
+#if SVIDEO_FISHEYE
+        if (m_sVideoInfo.geoType == SVIDEO_FISHEYE_CIRCULAR)
+        {
+          Double cnt_x = m_sVideoInfo.sFisheyeInfo.fCircularRegionCentre_x;
+          Double cnt_y = m_sVideoInfo.sFisheyeInfo.fCircularRegionCentre_y;
+          Double dist  = ssqrt((i + 0.5 - cnt_x) * (i + 0.5 - cnt_x) + (j + 0.5 - cnt_y) * (j + 0.5 - cnt_y));
+          if (dist >= (Double)(m_sVideoInfo.sFisheyeInfo.fCircularRegionRadius) - 0.5)
+            continue;
+        }
+#endif
+        SPos in(fIdx, i, j, 0), pos[2];
+        for (Int k = 0; k < 2; k++)
+        {
+          TFastMath::Scope fastMath(k == 1);
+          map2DTo3D(in, pos + k);
+#if SVIDEO_ROT_FIX
+          (this->*pfuncRotation)(pos[k], pRot[0], pRot[1], pRot[2]);
+#else
+          rotate3D(pos[k], pRot[0], pRot[1], pRot[2]);
+#endif
+          pGeoSrc->map3DTo2D(pos + k, pos + k);
+        }
+        Bool bValid[2];
+        for (Int k = 0; k < 2; k++)
+        {
+          bValid[k] = std::isfinite(pos[k].x) && std::isfinite(pos[k].y);
+        }
+        if (!bValid[0] && !bValid[1])
+          continue;   // not mapped by either (e.g. outside of a hemisphere);
+        err.iNumSamples++;
+        if (pos[0].faceIdx != pos[1].faceIdx || bValid[0] != bValid[1])
+        {
+          err.iNumFaceMismatch++;
+          continue;
+        }
+        // the positions may wrap around the face horizontally (e.g. at the longitude +/-180 of ERP);
+        Double dx = sfabs(pos[0].x - pos[1].x);
+        Double dy = sfabs(pos[0].y - pos[1].y);
+        dx        = std::min(dx, sfabs(iWrap - dx));
+        Double d  = ssqrt(dx * dx + dy * dy);
+        err.dSumPosError += d;
+        err.dMaxPosError = std::max(err.dMaxPosError, d);
+      }
+  }
+}
+#endif
+
+#if SVIDEO_PARALLEL_PROCESSING
+/***************************************************
+//split the faces into bands of S_PARALLEL_ROW_BAND rows per channel, margins included;
+****************************************************/
+Void TGeometry::xGetRowBands(Int iNumChannels, Int iFaceIdx, std::vector<RowBand> &rowBands)
+{
+  rowBands.clear();
+  for (Int fIdx = (iFaceIdx < 0 ? 0 : iFaceIdx); fIdx < (iFaceIdx < 0 ? m_sVideoInfo.iNumFaces : iFaceIdx + 1); fIdx++)
+  {
+#if SVIDEO_GENERALIZED_CUBEMAP
+    if (m_sVideoInfo.geoType == SVIDEO_GENERALIZEDCUBEMAP
+        && (m_sVideoInfo.iGCMPPackingType == 4 || m_sVideoInfo.iGCMPPackingType == 5))
+    {
+      Int virtualFaceIdx = m_sVideoInfo.iGCMPPackingType == 4 ? m_sVideoInfo.framePackStruct.faces[0][5].id
+                                                              : m_sVideoInfo.framePackStruct.faces[5][0].id;
+      if (fIdx == virtualFaceIdx)
+        continue;
+    }
+#endif
+    for (Int ch = 0; ch < iNumChannels; ch++)
+    {
+      Int nHeight  = m_sVideoInfo.iFaceHeight >> getComponentScaleY(ComponentID(ch));
+      Int nMarginY = m_iMarginY >> getComponentScaleY(ComponentID(ch));
+      for (Int j = -nMarginY; j < nHeight + nMarginY; j += S_PARALLEL_ROW_BAND)
+      {
+        RowBand band = { fIdx, ch, j, std::min(j + S_PARALLEL_ROW_BAND, nHeight + nMarginY) };
+        rowBands.push_back(band);
+      }
+    }
+  }
+}
+
+/***************************************************
+//generate the weight map of rows [iRowStart, iRowEnd) of one face channel;
+****************************************************/
+#if SVIDEO_ROT_FIX
+Void TGeometry::xGeometryMappingRows(TGeometry *pGeoSrc, Int fIdx, Int ch, Int iRowStart, Int iRowEnd,
+                                     Void (TGeometry::*pfuncRotation)(SPos &sPos, Int iRoll, Int iPitch, Int iYaw),
+                                     const Int *pRot)
+#else
+Void TGeometry::xGeometryMappingRows(TGeometry *pGeoSrc, Int fIdx, Int ch, Int iRowStart, Int iRowEnd, const Int *pRot)
+#endif
+{
+  ComponentID chId      = (ComponentID) ch;
+  Int         iStridePW = getStride(chId);
+  Int         iWidth    = m_sVideoInfo.iFaceWidth >> getComponentScaleX(chId);
+  Int         nMarginX  = m_iMarginX >> getComponentScaleX(chId);
+  Int         nMarginY  = m_iMarginY >> getComponentScaleY(chId);
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+  Double chromaOffsetSrc[2] = { 0.0, 0.0 };   //[0: X; 1: Y];
+  Double chromaOffsetDst[2] = { 0.0, 0.0 };   //[0: X; 1: Y];
+  getFaceChromaOffset(chromaOffsetDst, fIdx, chId);
+#endif
+#if SVIDEO_ROW_PROJECTION
+  // one row at a time: collect the samples to be mapped, then project the whole row through each geometry;
+  Int               nRowLen = iWidth + 2 * nMarginX;
+  std::vector<Int>  rowIdx(nRowLen);
+  std::vector<SPos> posIn(nRowLen), pos3D(nRowLen);
+  std::unique_ptr<Bool[]> bInside(new Bool[nRowLen]);
+#if SVIDEO_SEPARABLE_MAPPING
+  // the memos live for the rows of the band: the terms of a column are evaluated on its first row only;
+  std::vector<Int> rowCol(nRowLen);
+  SeparableMemo     memoDst, memoSrc;
+  memoDst.init(nRowLen);
+  memoSrc.init(nRowLen);
+#endif
+
+  for (Int j = iRowStart; j < iRowEnd; j++)
+  {
+    if (m_bConvOutputPaddingNeeded)
+    {
+      std::fill(bInside.get(), bInside.get() + nRowLen, true);
+    }
+    else
+    {
+      insideFaceRow(fIdx, (-nMarginX) << getComponentScaleX(chId), 1 << getComponentScaleX(chId),
+                    j << getComponentScaleY(chId), nRowLen, COMPONENT_Y, chId, bInside.get());
+    }
+
+    Int iNum = 0;
+    for (Int i = -nMarginX; i < iWidth + nMarginX; i++)
+    {
+      if (!bInside[i + nMarginX])
+        continue;
+
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+      POSType x = (i) * (1 << getComponentScaleX(chId)) + chromaOffsetDst[0];
+      POSType y = (j) * (1 << getComponentScaleY(chId)) + chromaOffsetDst[1];
+#else
+      POSType x = (i) * (1 << getComponentScaleX(chId));
+      POSType y = (j) * (1 << getComponentScaleY(chId));
+#endif
+#if SVIDEO_FISHEYE
+      if (this->m_sVideoInfo.geoType == SVIDEO_FISHEYE_CIRCULAR)
+      {
+        Double cnt_x = this->m_sVideoInfo.sFisheyeInfo.fCircularRegionCentre_x;
+        Double cnt_y = this->m_sVideoInfo.sFisheyeInfo.fCircularRegionCentre_y;
+        Double dist  = ssqrt((x + 0.5 - cnt_x) * (x + 0.5 - cnt_x) + (y + 0.5 - cnt_y) * (y + 0.5 - cnt_y));
+        if (dist >= (Double)(this->m_sVideoInfo.sFisheyeInfo.fCircularRegionRadius) - 0.5)
+        {
+          // outside of the circular region;
+          SPos pos(0, 0, 0, 0);
+          (pGeoSrc->*pGeoSrc->m_interpolateWeight[Int(toChannelType(chId))])(
+            chId, &pos, m_pPixelWeight[fIdx][ch][(j + nMarginY) * iStridePW + i + nMarginX]);
+          continue;
+        }
+      }
+#endif
+      rowIdx[iNum] = i;
+#if SVIDEO_SEPARABLE_MAPPING
+      rowCol[iNum] = i + nMarginX;
+#endif
+      posIn[iNum]  = SPos(fIdx, x, y, 0);
+      pos3D[iNum]  = SPos();
+      iNum++;
+    }
+
+#if SVIDEO_SEPARABLE_MAPPING
+    map2DTo3DRowMemo(posIn.data(), pos3D.data(), iNum, rowCol.data(), memoDst);
+#else
+    map2DTo3DRow(posIn.data(), pos3D.data(), iNum);
+#endif
+    for (Int k = 0; k < iNum; k++)
+    {
+#if SVIDEO_ROT_FIX
+      (this->*pfuncRotation)(pos3D[k], pRot[0], pRot[1], pRot[2]);
+#else
+      rotate3D(pos3D[k], pRot[0], pRot[1], pRot[2]);
+#endif
+    }
+#if SVIDEO_SEPARABLE_MAPPING
+    pGeoSrc->map3DTo2DRowMemo(pos3D.data(), pos3D.data(), iNum, rowCol.data(), memoSrc);
+#else
+    pGeoSrc->map3DTo2DRow(pos3D.data(), pos3D.data(), iNum);
+#endif
+
+    for (Int k = 0; k < iNum; k++)
+    {
+      SPos &pos = pos3D[k];
+#if SVIDEO_HEMI_PROJECTIONS
+      if (((Int)(pGeoSrc->getType()) == SVIDEO_HCMP || (Int)(pGeoSrc->getType()) == SVIDEO_HEAC) && pos.faceIdx == 7)
+      {
+        pos.faceIdx = 0;
+        pos.x       = 0;
+        pos.y       = 0;
+      }
+#endif
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+      pGeoSrc->getFaceChromaOffset(chromaOffsetSrc, pos.faceIdx, chId);
+      pos.x = (pos.x - chromaOffsetSrc[0]) / POSType(1 << getComponentScaleX(chId));
+      pos.y = (pos.y - chromaOffsetSrc[1]) / POSType(1 << getComponentScaleY(chId));
+#else
+      pos.x = pos.x / POSType(1 << getComponentScaleX(chId));
+      pos.y = pos.y / POSType(1 << getComponentScaleY(chId));
+#endif
+      PxlFltLut &wList = m_pPixelWeight[fIdx][ch][(j + nMarginY) * iStridePW + rowIdx[k] + nMarginX];
+      (pGeoSrc->*pGeoSrc->m_interpolateWeight[Int(toChannelType(chId))])(chId, &pos, wList);
+    }
+  }
+#else
+  for (Int j = iRowStart; j < iRowEnd; j++)
+    for (Int i = -nMarginX; i < iWidth + nMarginX; i++)
+    {
+      if (!m_bConvOutputPaddingNeeded
+          && !insideFace(fIdx, (i << getComponentScaleX(chId)), (j << getComponentScaleY(chId)), COMPONENT_Y, chId))
+        continue;
+
+      Int xOrg = (i + nMarginX);
+      Int yOrg = (j + nMarginY);
+      Int ic   = i;
+      Int jc   = j;
+      {
+        PxlFltLut &wList = m_pPixelWeight[fIdx][ch][yOrg * iStridePW + xOrg];
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+        POSType x = (ic) * (1 << getComponentScaleX(chId)) + chromaOffsetDst[0];
+        POSType y = (jc) * (1 << getComponentScaleY(chId)) + chromaOffsetDst[1];
+#else
+        POSType x = (ic) * (1 << getComponentScaleX(chId));
+        POSType y = (jc) * (1 << getComponentScaleY(chId));
+#endif
+        SPos in(fIdx, x, y, 0), pos3D;
+
+#if SVIDEO_FISHEYE
+        Double cnt_x = this->m_sVideoInfo.sFisheyeInfo.fCircularRegionCentre_x;
+        Double cnt_y = this->m_sVideoInfo.sFisheyeInfo.fCircularRegionCentre_y;
+        Double dist  = ssqrt((x + 0.5 - cnt_x) * (x + 0.5 - cnt_x) + (y + 0.5 - cnt_y) * (y + 0.5 - cnt_y));
+
+        if (this->m_sVideoInfo.geoType != SVIDEO_FISHEYE_CIRCULAR
+            || (/*this->m_sVideoInfo.geoType == SVIDEO_FISHEYE_CIRCULAR &&*/ dist
+                < (Double)(this->m_sVideoInfo.sFisheyeInfo.fCircularRegionRadius) - 0.5))
+        {
+#endif
+          map2DTo3D(in, &pos3D);
+#if SVIDEO_ROT_FIX
+          (this->*pfuncRotation)(pos3D, pRot[0], pRot[1], pRot[2]);
+#else
+        rotate3D(pos3D, pRot[0], pRot[1], pRot[2]);
+#endif
+          pGeoSrc->map3DTo2D(&pos3D, &pos3D);
+#if SVIDEO_HEMI_PROJECTIONS
+          if (((Int)(pGeoSrc->getType()) == SVIDEO_HCMP || (Int)(pGeoSrc->getType()) == SVIDEO_HEAC)
+              && pos3D.faceIdx == 7)
+          {
+            pos3D.faceIdx = 0;
+            pos3D.x       = 0;
+            pos3D.y       = 0;
+          }
+#endif
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+          pGeoSrc->getFaceChromaOffset(chromaOffsetSrc, pos3D.faceIdx, chId);
+          pos3D.x = (pos3D.x - chromaOffsetSrc[0]) / POSType(1 << getComponentScaleX(chId));
+          pos3D.y = (pos3D.y - chromaOffsetSrc[1]) / POSType(1 << getComponentScaleY(chId));
+#else
+        pos3D.x = pos3D.x / POSType(1 << getComponentScaleX(chId));
+        pos3D.y = pos3D.y / POSType(1 << getComponentScaleY(chId));
+#endif
+          (pGeoSrc->*pGeoSrc->m_interpolateWeight[Int(toChannelType(chId))])(chId, &pos3D, wList);
+#if SVIDEO_FISHEYE
+        }
+        else if (this->m_sVideoInfo.geoType == SVIDEO_FISHEYE_CIRCULAR)
+        {
+          pos3D.faceIdx = 0;
+          pos3D.x       = 0;
+          pos3D.y       = 0;
+          (pGeoSrc->*pGeoSrc->m_interpolateWeight[Int(toChannelType(chId))])(chId, &pos3D, wList);
+        }
+#endif
+      }
+    }
+#endif
+}
+#endif
+
+
+/***************************************************
+//convert source geometry to destination geometry;
+****************************************************/
+Void TGeometry::geoConvert(TGeometry *pGeoDst
+#if SVIDEO_ROT_FIX
+                           ,
+                           Bool bRec
+#endif
+)
+{
+  // padding;
+  spherePadding();
+#if SVIDEO_FACE_VIEWS
+  pGeoDst->xDetachFaceViews();
+#endif
+
+  if (!pGeoDst->m_bGeometryMapping)
+#if SVIDEO_ROT_FIX
+    pGeoDst->geometryMapping(this, bRec);
+#else
+    pGeoDst->geometryMapping(this);
+#endif
+#if SVIDEO_COMPACT_WEIGHT_MAP
+  if (pGeoDst->m_bCompactWeightMap)
+  {
+    pGeoDst->xCompactWeightMaps(this);
+  }
+#endif
+
+#if SVIDEO_PARALLEL_PROCESSING
+  // split the destination into (face, channel, row band) tasks; every output sample is written by exactly one task;
+  std::vector<RowBand> rowBands;
+  pGeoDst->xGetRowBands(pGeoDst->getNumChannels(), -1, rowBands);
+  TThreadPool::runTasks(m_iNumThreads, (Int) rowBands.size(), [&](Int iTask) {
+    const RowBand &band = rowBands[iTask];
+    xGeoConvertRows(pGeoDst, band.fIdx, band.ch, band.iRowStart, band.iRowEnd);
+  });
+#else
+  Int nFaces             = pGeoDst->m_sVideoInfo.iNumFaces;
+  Int iBDPrecision       = S_INTERPOLATE_PrecisionBD;
+  Int iWeightMapFaceMask = (1 << m_WeightMap_NumOfBits4Faces) - 1;
+  Int iOffset            = 1 << (iBDPrecision - 1);
+
+  for (Int fIdx = 0; fIdx < nFaces; fIdx++)
+  {
+#if SVIDEO_GENERALIZED_CUBEMAP
+    if (pGeoDst->m_sVideoInfo.geoType == SVIDEO_GENERALIZEDCUBEMAP
+        && (pGeoDst->m_sVideoInfo.iGCMPPackingType == 4 || pGeoDst->m_sVideoInfo.iGCMPPackingType == 5))
+    {
+      Int virtualFaceIdx = pGeoDst->m_sVideoInfo.iGCMPPackingType == 4
+                             ? pGeoDst->m_sVideoInfo.framePackStruct.faces[0][5].id
+                             : pGeoDst->m_sVideoInfo.framePackStruct.faces[5][0].id;
+      if (fIdx == virtualFaceIdx)
+        continue;
+    }
+#endif
+    for (Int ch = 0; ch < pGeoDst->getNumChannels(); ch++)
+    {
+      ComponentID chId    = (ComponentID) ch;
+      Int         nWidth  = pGeoDst->m_sVideoInfo.iFaceWidth >> pGeoDst->getComponentScaleX(chId);
+      Int         nHeight = pGeoDst->m_sVideoInfo.iFaceHeight >> pGeoDst->getComponentScaleY(chId);
+
+      Int nMarginX = pGeoDst->m_iMarginX >> pGeoDst->getComponentScaleX(chId);
+      Int nMarginY = pGeoDst->m_iMarginY >> pGeoDst->getComponentScaleY(chId);
+      Int iWidthPW = pGeoDst->getStride(chId);
+      Int mapIdx =
+        (pGeoDst->m_chromaFormatIDC == ChromaFormat::_444
+         && pGeoDst->m_InterpolationType[Int(ChannelType::LUMA)] == pGeoDst->m_InterpolationType[Int(ChannelType::CHROMA)])
+          ? 0
+          : (ch > 0 ? 1 : 0);
+      ChannelType chType = toChannelType(chId);
+
+      for (Int j = -nMarginY; j < nHeight + nMarginY; j++)
+        for (Int i = -nMarginX; i < nWidth + nMarginX; i++)
         {
           if (!pGeoDst->m_bConvOutputPaddingNeeded
               && !pGeoDst->insideFace(fIdx, (i << pGeoDst->getComponentScaleX(chId)),
@@ -1142,45 +1928,380 @@ Void TGeometry::geoConvert(TGeometry *pGeoDst
                     < (Double)(pGeoDst->m_sVideoInfo.sFisheyeInfo.fCircularRegionRadius) - 0.5))
             {
 #endif
-
-              PxlFltLut *pPelWeight = pGeoDst->m_pPixelWeight[fIdx][mapIdx] + y * iWidthPW + x;
-              Int        face       = (pPelWeight->facePos) & iWeightMapFaceMask;
-              Int        iTLPos     = (pPelWeight->facePos) >> m_WeightMap_NumOfBits4Faces;
-              Int        iWLutIdx =
-                (m_chromaFormatIDC == ChromaFormat::_400 || (m_InterpolationType[0] == m_InterpolationType[1])) ? 0 : Int(chType);
-              Int *pWLut    = m_pWeightLut[iWLutIdx][pPelWeight->weightIdx];
-              Pel *pPelLine = m_pFacesOrig[face][ch] + iTLPos
-                              - ((m_iInterpFilterTaps[Int(chType)][1] - 1) >> 1) * getStride(chId)
-                              - ((m_iInterpFilterTaps[Int(chType)][0] - 1) >> 1);
-              for (Int m = 0; m < m_iInterpFilterTaps[Int(chType)][1]; m++)
-              {
-                for (Int n = 0; n < m_iInterpFilterTaps[Int(chType)][0]; n++)
-                  sum += pPelLine[n] * pWLut[n];
-                pPelLine += getStride(chId);
-                pWLut += m_iInterpFilterTaps[Int(chType)][0];
-              }
-
-              Int iPos = j * pGeoDst->getStride(chId) + i;
+
+              PxlFltLut *pPelWeight = pGeoDst->m_pPixelWeight[fIdx][mapIdx] + y * iWidthPW + x;
+              Int        face       = (pPelWeight->facePos) & iWeightMapFaceMask;
+              Int        iTLPos     = (pPelWeight->facePos) >> m_WeightMap_NumOfBits4Faces;
+              Int        iWLutIdx =
+                (m_chromaFormatIDC == ChromaFormat::_400 || (m_InterpolationType[0] == m_InterpolationType[1])) ? 0 : Int(chType);
+              Int *pWLut    = m_pWeightLut[iWLutIdx][pPelWeight->weightIdx];
+              Pel *pPelLine = m_pFacesOrig[face][ch] + iTLPos
+                              - ((m_iInterpFilterTaps[Int(chType)][1] - 1) >> 1) * getStride(chId)
+                              - ((m_iInterpFilterTaps[Int(chType)][0] - 1) >> 1);
+#if SVIDEO_INTERP_KERNELS
+              sum = g_interp360OP.filter2D[m_iInterpFilterTaps[Int(chType)][0]](pPelLine, getStride(chId), pWLut);
+#else
+              for (Int m = 0; m < m_iInterpFilterTaps[Int(chType)][1]; m++)
+              {
+                for (Int n = 0; n < m_iInterpFilterTaps[Int(chType)][0]; n++)
+                  sum += pPelLine[n] * pWLut[n];
+                pPelLine += getStride(chId);
+                pWLut += m_iInterpFilterTaps[Int(chType)][0];
+              }
+#endif
+
+              Int iPos = j * pGeoDst->getStride(chId) + i;
+#if SVIDEO_GEOCONVERT_CLIP
+              pGeoDst->m_pFacesOrig[fIdx][ch][iPos] = ClipBD((sum + iOffset) >> iBDPrecision, m_nBitDepth);
+#else
+          pGeoDst->m_pFacesOrig[fIdx][ch][iPos] = (sum + iOffset) >> iBDPrecision;
+#endif
+#if SVIDEO_FISHEYE
+            }
+            else if (pGeoDst->m_sVideoInfo.geoType == SVIDEO_FISHEYE_CIRCULAR)
+            {
+              Int iPos                              = j * pGeoDst->getStride(chId) + i;
+              pGeoDst->m_pFacesOrig[fIdx][ch][iPos] = 1 << (m_nBitDepth - 1);
+            }
+          }
+#endif
+        }
+    }
+  }
+
+#endif
+
+  pGeoDst->setPaddingFlag(pGeoDst->m_bConvOutputPaddingNeeded ? true : false);
+}
+
+#if SVIDEO_PARALLEL_PROCESSING
+/***************************************************
+//convert rows [iRowStart, iRowEnd) of one destination face channel;
+****************************************************/
+Void TGeometry::xGeoConvertRows(TGeometry *pGeoDst, Int fIdx, Int ch, Int iRowStart, Int iRowEnd)
+{
+  Int iBDPrecision       = S_INTERPOLATE_PrecisionBD;
+  Int iWeightMapFaceMask = (1 << m_WeightMap_NumOfBits4Faces) - 1;
+  Int iOffset            = 1 << (iBDPrecision - 1);
+
+  ComponentID chId    = (ComponentID) ch;
+  Int         nWidth  = pGeoDst->m_sVideoInfo.iFaceWidth >> pGeoDst->getComponentScaleX(chId);
+
+  Int nMarginX = pGeoDst->m_iMarginX >> pGeoDst->getComponentScaleX(chId);
+  Int nMarginY = pGeoDst->m_iMarginY >> pGeoDst->getComponentScaleY(chId);
+  Int iWidthPW = pGeoDst->getStride(chId);
+  Int mapIdx =
+    (pGeoDst->m_chromaFormatIDC == ChromaFormat::_444
+     && pGeoDst->m_InterpolationType[Int(ChannelType::LUMA)] == pGeoDst->m_InterpolationType[Int(ChannelType::CHROMA)])
+      ? 0
+      : (ch > 0 ? 1 : 0);
+  ChannelType chType = toChannelType(chId);
+#if SVIDEO_COMPACT_WEIGHT_MAP
+  if (pGeoDst->m_pCompactWeightMap[fIdx][mapIdx])
+  {
+    xGeoConvertRowsCompact(pGeoDst, fIdx, ch, iRowStart, iRowEnd, *pGeoDst->m_pCompactWeightMap[fIdx][mapIdx]);
+    return;
+  }
+#endif
+
+  for (Int j = iRowStart; j < iRowEnd; j++)
+    for (Int i = -nMarginX; i < nWidth + nMarginX; i++)
+    {
+      if (!pGeoDst->m_bConvOutputPaddingNeeded
+          && !pGeoDst->insideFace(fIdx, (i << pGeoDst->getComponentScaleX(chId)),
+                                  (j << pGeoDst->getComponentScaleY(chId)), COMPONENT_Y, chId))
+        continue;
+
+      Int x   = i + nMarginX;
+      Int y   = j + nMarginY;
+      Int sum = 0;
+
+#if SVIDEO_FISHEYE
+      {
+        Int    xx    = i << pGeoDst->getComponentScaleX(chId);
+        Int    yy    = j << pGeoDst->getComponentScaleY(chId);
+        Double cnt_x = pGeoDst->m_sVideoInfo.sFisheyeInfo.fCircularRegionCentre_x;
+        Double cnt_y = pGeoDst->m_sVideoInfo.sFisheyeInfo.fCircularRegionCentre_y;
+        Double dist  = ssqrt((xx + 0.5 - cnt_x) * (xx + 0.5 - cnt_x) + (yy + 0.5 - cnt_y) * (yy + 0.5 - cnt_y));
+
+        if (pGeoDst->m_sVideoInfo.geoType != SVIDEO_FISHEYE_CIRCULAR
+            || (/*pGeoDst->m_sVideoInfo.geoType == SVIDEO_FISHEYE_CIRCULAR &&*/ dist
+                < (Double)(pGeoDst->m_sVideoInfo.sFisheyeInfo.fCircularRegionRadius) - 0.5))
+        {
+#endif
+
+          PxlFltLut *pPelWeight = pGeoDst->m_pPixelWeight[fIdx][mapIdx] + y * iWidthPW + x;
+          Int        face       = (pPelWeight->facePos) & iWeightMapFaceMask;
+          Int        iTLPos     = (pPelWeight->facePos) >> m_WeightMap_NumOfBits4Faces;
+          Int        iWLutIdx =
+            (m_chromaFormatIDC == ChromaFormat::_400 || (m_InterpolationType[0] == m_InterpolationType[1])) ? 0 : Int(chType);
+          Int *pWLut    = m_pWeightLut[iWLutIdx][pPelWeight->weightIdx];
+          Pel *pPelLine = m_pFacesOrig[face][ch] + iTLPos
+                          - ((m_iInterpFilterTaps[Int(chType)][1] - 1) >> 1) * getStride(chId)
+                          - ((m_iInterpFilterTaps[Int(chType)][0] - 1) >> 1);
+#if SVIDEO_INTERP_KERNELS
+          sum = g_interp360OP.filter2D[m_iInterpFilterTaps[Int(chType)][0]](pPelLine, getStride(chId), pWLut);
+#else
+          for (Int m = 0; m < m_iInterpFilterTaps[Int(chType)][1]; m++)
+          {
+            for (Int n = 0; n < m_iInterpFilterTaps[Int(chType)][0]; n++)
+              sum += pPelLine[n] * pWLut[n];
+            pPelLine += getStride(chId);
+            pWLut += m_iInterpFilterTaps[Int(chType)][0];
+          }
+#endif
+
+          Int iPos = j * pGeoDst->getStride(chId) + i;
+#if SVIDEO_GEOCONVERT_CLIP
+          pGeoDst->m_pFacesOrig[fIdx][ch][iPos] = ClipBD((sum + iOffset) >> iBDPrecision, m_nBitDepth);
+#else
+      pGeoDst->m_pFacesOrig[fIdx][ch][iPos] = (sum + iOffset) >> iBDPrecision;
+#endif
+#if SVIDEO_FISHEYE
+        }
+        else if (pGeoDst->m_sVideoInfo.geoType == SVIDEO_FISHEYE_CIRCULAR)
+        {
+          Int iPos                              = j * pGeoDst->getStride(chId) + i;
+          pGeoDst->m_pFacesOrig[fIdx][ch][iPos] = 1 << (m_nBitDepth - 1);
+        }
+      }
+#endif
+    }
+}
+
+#if SVIDEO_COMPACT_WEIGHT_MAP
+// how geoConvert() writes a sample of the destination face; 0: not written, 1: interpolated with the weight map,
+// 2: constant (outside the circle of a circular fisheye);
+Int TGeometry::xGetConvertSampleType(Int fIdx, ComponentID chId, Int i, Int j)
+{
+  if (!m_bConvOutputPaddingNeeded
+      && !insideFace(fIdx, (i << getComponentScaleX(chId)), (j << getComponentScaleY(chId)), COMPONENT_Y, chId))
+    return 0;
+#if SVIDEO_FISHEYE
+  if (m_sVideoInfo.geoType == SVIDEO_FISHEYE_CIRCULAR)
+  {
+    Int    xx    = i << getComponentScaleX(chId);
+    Int    yy    = j << getComponentScaleY(chId);
+    Double cnt_x = m_sVideoInfo.sFisheyeInfo.fCircularRegionCentre_x;
+    Double cnt_y = m_sVideoInfo.sFisheyeInfo.fCircularRegionCentre_y;
+    Double dist  = ssqrt((xx + 0.5 - cnt_x) * (xx + 0.5 - cnt_x) + (yy + 0.5 - cnt_y) * (yy + 0.5 - cnt_y));
+    if (!(dist < (Double)(m_sVideoInfo.sFisheyeInfo.fCircularRegionRadius) - 0.5))
+      return 2;
+  }
+#endif
+  return 1;
+}
+
+// replaces the full weight maps by compact ones; only the interpolated samples are kept, in the order xGeoConvertRowsCompact()
+// visits them; a map shared by channels that disagree on the converted samples stays in the full format; the facePos
+// values are packed with the face bits of pGeoSrc, the geometry the maps were generated for;
+Void TGeometry::xCompactWeightMaps(TGeometry *pGeoSrc)
+{
+  Int iNumMaps = (m_chromaFormatIDC == ChromaFormat::_400
+                  || (m_chromaFormatIDC == ChromaFormat::_444 && m_InterpolationType[0] == m_InterpolationType[1]))
+                   ? 1
+                   : 2;
+  Int iNumFaceBits       = pGeoSrc->m_WeightMap_NumOfBits4Faces;
+  Int iWeightMapFaceMask = (1 << iNumFaceBits) - 1;
+
+  for (Int fIdx = 0; fIdx < m_sVideoInfo.iNumFaces; fIdx++)
+  {
+    for (Int m = 0; m < iNumMaps; m++)
+    {
+      // a map that could not be compacted is not scanned again;
+      if (!m_pPixelWeight[fIdx][m] || m_bCompactWeightMapTried[fIdx][m])
+      {
+        continue;
+      }
+      m_bCompactWeightMapTried[fIdx][m] = true;
+      std::vector<ComponentID> channels;
+      for (Int ch = 0; ch < getNumChannels(); ch++)
+      {
+        if ((iNumMaps == 1 ? 0 : (ch > 0 ? 1 : 0)) == m)
+        {
+          channels.push_back(ComponentID(ch));
+        }
+      }
+      if (channels.empty())
+      {
+        continue;
+      }
+      ComponentID chId     = channels[0];
+      Int         nWidth   = m_sVideoInfo.iFaceWidth >> getComponentScaleX(chId);
+      Int         nHeight  = m_sVideoInfo.iFaceHeight >> getComponentScaleY(chId);
+      Int         nMarginX = m_iMarginX >> getComponentScaleX(chId);
+      Int         nMarginY = m_iMarginY >> getComponentScaleY(chId);
+      Int         iWidthPW = getStride(chId);
+
+      CompactWeightMap *pMap       = new CompactWeightMap;
+      Bool              bConsistent = true;
+      pMap->rowStart.resize(nHeight + (nMarginY << 1));
+      for (Int j = -nMarginY; j < nHeight + nMarginY && bConsistent; j++)
+      {
+        pMap->rowStart[j + nMarginY] = (UInt) pMap->words.size();
+        Int iPrevPos  = 0;
+        Int iPrevFace = -1;
+        for (Int i = -nMarginX; i < nWidth + nMarginX; i++)
+        {
+          Int iType = xGetConvertSampleType(fIdx, chId, i, j);
+          for (size_t k = 1; k < channels.size(); k++)
+          {
+            bConsistent &= (xGetConvertSampleType(fIdx, channels[k], i, j) == iType);
+          }
+          if (iType != 1)
+          {
+            continue;
+          }
+          const PxlFltLut &wList  = m_pPixelWeight[fIdx][m][(j + nMarginY) * iWidthPW + i + nMarginX];
+          Int              iFace  = wList.facePos & iWeightMapFaceMask;
+          Int              iPos   = wList.facePos >> iNumFaceBits;
+          UInt             uPhase = ((wList.weightIdx / (S_LANCZOS_LUT_SCALE + 1)) << S_COMPACT_MAP_PHASE_BITS)
+                        | (wList.weightIdx % (S_LANCZOS_LUT_SCALE + 1));
+          int64_t iDelta = (int64_t) iPos - iPrevPos;
+          if (iFace != iPrevFace || iDelta <= S_COMPACT_MAP_ESCAPE || iDelta > -(S_COMPACT_MAP_ESCAPE + 1))
+          {
+            pMap->words.push_back(((UInt) S_COMPACT_MAP_ESCAPE << S_COMPACT_MAP_DELTA_SHIFT) | uPhase);
+            pMap->words.push_back((UInt) wList.facePos);
+          }
+          else
+          {
+            pMap->words.push_back(((UInt) iDelta << S_COMPACT_MAP_DELTA_SHIFT) | uPhase);
+          }
+          iPrevPos  = iPos;
+          iPrevFace = iFace;
+        }
+      }
+      if (!bConsistent)
+      {
+        delete pMap;
+        continue;
+      }
+      pMap->words.shrink_to_fit();
+      delete m_pCompactWeightMap[fIdx][m];
+      m_pCompactWeightMap[fIdx][m] = pMap;
+      delete[] m_pPixelWeight[fIdx][m];
+      m_pPixelWeight[fIdx][m] = nullptr;
+    }
+  }
+}
+#endif
+
+#if SVIDEO_FRAME_PIPELINE
+// lets several geometries of the same format convert different pictures with one set of weight maps; the maps are
+// only read by geoConvert() and spherePadding(), a map pGeoOwner has not generated yet is generated by this geometry;
+// so are the maps of a destination whose margins grew in geometryMapping() (PGCMP padding type 3);
+Void TGeometry::shareWeightMaps(TGeometry *pGeoOwner)
+{
+  CHECK(m_sVideoInfo.geoType == SVIDEO_VIEWPORT, "the weight maps of a viewport follow its orientation");
+  CHECK(pGeoOwner->m_sVideoInfo.geoType != m_sVideoInfo.geoType
+          || pGeoOwner->m_sVideoInfo.iFaceWidth != m_sVideoInfo.iFaceWidth
+          || pGeoOwner->m_sVideoInfo.iFaceHeight != m_sVideoInfo.iFaceHeight
+          || pGeoOwner->m_chromaFormatIDC != m_chromaFormatIDC,
+        "weight maps can only be shared by geometries of the same format");
+  CHECK(m_bGeometryMapping || m_bGeometryMapping4SpherePadding, "the geometry has generated weight maps already");
+  if (pGeoOwner->m_iMarginX != m_iMarginX || pGeoOwner->m_iMarginY != m_iMarginY)
+  {
+    return;
+  }
+
+  if (pGeoOwner->m_bGeometryMapping)
+  {
+    memcpy(m_pPixelWeight, pGeoOwner->m_pPixelWeight, sizeof(m_pPixelWeight));
+#if SVIDEO_COMPACT_WEIGHT_MAP
+    memcpy(m_pCompactWeightMap, pGeoOwner->m_pCompactWeightMap, sizeof(m_pCompactWeightMap));
+    m_bCompactWeightMap = false;   //the owner has compacted its maps in its first geoConvert();
+#endif
+    m_bConvOutputPaddingNeeded = pGeoOwner->m_bConvOutputPaddingNeeded;   //set along with the maps;
+    m_bGeometryMapping         = true;
+    m_bSharedWeightMaps        = true;
+  }
+  if (pGeoOwner->m_bGeometryMapping4SpherePadding)
+  {
+    memcpy(m_pPixelWeight4SherePadding, pGeoOwner->m_pPixelWeight4SherePadding, sizeof(m_pPixelWeight4SherePadding));
+    m_bGeometryMapping4SpherePadding  = true;
+    m_bSharedWeightMaps4SpherePadding = true;
+  }
+}
+#endif
+
+#if SVIDEO_COMPACT_WEIGHT_MAP
+// xGeoConvertRows() with a compact weight map; the words of a row are decoded in the order of the samples;
+Void TGeometry::xGeoConvertRowsCompact(TGeometry *pGeoDst, Int fIdx, Int ch, Int iRowStart, Int iRowEnd,
+                                       const CompactWeightMap &map)
+{
+  Int iBDPrecision       = S_INTERPOLATE_PrecisionBD;
+  Int iWeightMapFaceMask = (1 << m_WeightMap_NumOfBits4Faces) - 1;
+  Int iOffset            = 1 << (iBDPrecision - 1);
+  Int iPhaseMask         = (1 << S_COMPACT_MAP_PHASE_BITS) - 1;
+
+  ComponentID chId     = (ComponentID) ch;
+  ChannelType chType   = toChannelType(chId);
+  Int         nWidth   = pGeoDst->m_sVideoInfo.iFaceWidth >> pGeoDst->getComponentScaleX(chId);
+  Int         nMarginX = pGeoDst->m_iMarginX >> pGeoDst->getComponentScaleX(chId);
+  Int         nMarginY = pGeoDst->m_iMarginY >> pGeoDst->getComponentScaleY(chId);
+  Int         iWLutIdx =
+    (m_chromaFormatIDC == ChromaFormat::_400 || (m_InterpolationType[0] == m_InterpolationType[1])) ? 0 : Int(chType);
+  Int iStride    = getStride(chId);
+  Int iTapsX     = m_iInterpFilterTaps[Int(chType)][0];
+  Int iTapsY     = m_iInterpFilterTaps[Int(chType)][1];
+  Int iTapOffset = ((iTapsY - 1) >> 1) * iStride + ((iTapsX - 1) >> 1);
+
+  for (Int j = iRowStart; j < iRowEnd; j++)
+  {
+    const UInt *pWord   = map.words.data() + map.rowStart[j + nMarginY];
+    Pel        *pDstRow = pGeoDst->m_pFacesOrig[fIdx][ch] + j * pGeoDst->getStride(chId);
+    Int         face    = 0;
+    Int         iTLPos  = 0;
+    for (Int i = -nMarginX; i < nWidth + nMarginX; i++)
+    {
+      Int iType = pGeoDst->xGetConvertSampleType(fIdx, chId, i, j);
+      if (!iType)
+      {
+        continue;
+      }
+      if (iType == 2)
+      {
+        pDstRow[i] = 1 << (m_nBitDepth - 1);
+        continue;
+      }
+      Int iWord  = (Int) *pWord++;
+      Int iDelta = iWord >> S_COMPACT_MAP_DELTA_SHIFT;
+      if (iDelta == S_COMPACT_MAP_ESCAPE)
+      {
+        Int iFacePos = (Int) *pWord++;
+        face         = iFacePos & iWeightMapFaceMask;
+        iTLPos       = iFacePos >> m_WeightMap_NumOfBits4Faces;
+      }
+      else
+      {
+        iTLPos += iDelta;
+      }
+      Int *pWLut =
+        m_pWeightLut[iWLutIdx][((iWord >> S_COMPACT_MAP_PHASE_BITS) & iPhaseMask) * (S_LANCZOS_LUT_SCALE + 1) + (iWord & iPhaseMask)];
+      Pel *pPelLine = m_pFacesOrig[face][ch] + iTLPos - iTapOffset;
+      Int  sum      = 0;
+#if SVIDEO_INTERP_KERNELS
+      sum = g_interp360OP.filter2D[iTapsX](pPelLine, iStride, pWLut);
+#else
+      for (Int m = 0; m < iTapsY; m++)
+      {
+        for (Int n = 0; n < iTapsX; n++)
+          sum += pPelLine[n] * pWLut[n];
+        pPelLine += iStride;
+        pWLut += iTapsX;
+      }
+#endif
 #if SVIDEO_GEOCONVERT_CLIP
-              pGeoDst->m_pFacesOrig[fIdx][ch][iPos] = ClipBD((sum + iOffset) >> iBDPrecision, m_nBitDepth);
+      pDstRow[i] = ClipBD((sum + iOffset) >> iBDPrecision, m_nBitDepth);
 #else
-          pGeoDst->m_pFacesOrig[fIdx][ch][iPos] = (sum + iOffset) >> iBDPrecision;
-#endif
-#if SVIDEO_FISHEYE
-            }
-            else if (pGeoDst->m_sVideoInfo.geoType == SVIDEO_FISHEYE_CIRCULAR)
-            {
-              Int iPos                              = j * pGeoDst->getStride(chId) + i;
-              pGeoDst->m_pFacesOrig[fIdx][ch][iPos] = 1 << (m_nBitDepth - 1);
-            }
-          }
+      pDstRow[i] = (sum + iOffset) >> iBDPrecision;
 #endif
-        }
     }
   }
-
-  pGeoDst->setPaddingFlag(pGeoDst->m_bConvOutputPaddingNeeded ? true : false);
 }
+#endif
+#endif
+
 
 Void TGeometry::geoToFramePack(IPos *posIn, IPos2D *posOut)
 {
@@ -1442,6 +2563,62 @@ Void TGeometry::spherePadding(Bool bEnforced)
   if (!m_bGeometryMapping4SpherePadding)
     geometryMapping4SpherePadding();
 
+#if SVIDEO_PADDING_GATHER_TABLE
+  Int iNumMaps = (m_chromaFormatIDC == ChromaFormat::_400
+                  || (m_chromaFormatIDC == ChromaFormat::_444 && m_InterpolationType[0] == m_InterpolationType[1]))
+                   ? 1
+                   : 2;
+  // the tables are built at the first padding; faces without a padding map (the virtual GCMP face) have none;
+  std::vector<std::pair<Int, Int>> newTables;
+  for (Int fIdx = 0; fIdx < m_sVideoInfo.iNumFaces; fIdx++)
+  {
+    for (Int mapIdx = 0; mapIdx < iNumMaps; mapIdx++)
+    {
+      if (m_pPixelWeight4SherePadding[fIdx][mapIdx] && !m_pPaddingTable[fIdx][mapIdx])
+      {
+        newTables.push_back(std::make_pair(fIdx, mapIdx));
+      }
+    }
+  }
+  if (!newTables.empty())
+  {
+    TThreadPool::runTasks(m_iNumThreads, (Int) newTables.size(),
+                          [&](Int iTask) { xBuildPaddingTable(newTables[iTask].first, newTables[iTask].second); });
+  }
+
+  // the faces are padded in order since a face may read the margins of the earlier ones; the channels and, unless the
+  // face reads its own margin, the bands of rows of a face are independent;
+  std::vector<RowBand> rowBands;
+  for (Int fIdx = 0; fIdx < m_sVideoInfo.iNumFaces; fIdx++)
+  {
+    rowBands.clear();
+    for (Int ch = 0; ch < getNumChannels(); ch++)
+    {
+      ComponentID chId   = (ComponentID) ch;
+      Int         mapIdx = (iNumMaps == 1 || ch == 0) ? 0 : 1;
+      if (!m_pPaddingTable[fIdx][mapIdx])
+      {
+        continue;
+      }
+      Int nHeight   = m_sVideoInfo.iFaceHeight >> getComponentScaleY(chId);
+      Int nMarginY  = m_iMarginY >> getComponentScaleY(chId);
+      Int iBandRows = m_pPaddingTable[fIdx][mapIdx]->bSelfReference ? nHeight + (nMarginY << 1) : S_PARALLEL_ROW_BAND;
+      for (Int j = -nMarginY; j < nHeight + nMarginY; j += iBandRows)
+      {
+        RowBand band = { fIdx, ch, j, std::min(j + iBandRows, nHeight + nMarginY) };
+        rowBands.push_back(band);
+      }
+    }
+    if (!rowBands.empty())
+    {
+      TThreadPool::runTasks(m_iNumThreads, (Int) rowBands.size(), [&](Int iTask) {
+        const RowBand &band = rowBands[iTask];
+        xSpherePaddingRows(band.fIdx, band.ch, band.iRowStart, band.iRowEnd);
+      });
+    }
+  }
+#else
+
   Int iBDPrecision       = S_INTERPOLATE_PrecisionBD;
   Int iWeightMapFaceMask = (1 << m_WeightMap_NumOfBits4Faces) - 1;
   Int iOffset            = 1 << (iBDPrecision - 1);
@@ -1502,6 +2679,9 @@ Void TGeometry::spherePadding(Bool bEnforced)
           Pel *pPelLine = m_pFacesOrig[face][ch] + iTLPos
                           - ((m_iInterpFilterTaps[Int(chType)][1] - 1) >> 1) * getStride(chId)
                           - ((m_iInterpFilterTaps[Int(chType)][0] - 1) >> 1);
+#if SVIDEO_INTERP_KERNELS
+          sum = g_interp360OP.filter2D[m_iInterpFilterTaps[Int(chType)][0]](pPelLine, getStride(chId), pWLut);
+#else
           for (Int m = 0; m < m_iInterpFilterTaps[Int(chType)][1]; m++)
           {
             for (Int n = 0; n < m_iInterpFilterTaps[Int(chType)][0]; n++)
@@ -1509,12 +2689,14 @@ Void TGeometry::spherePadding(Bool bEnforced)
             pPelLine += getStride(chId);
             pWLut += m_iInterpFilterTaps[Int(chType)][0];
           }
+#endif
 
           m_pFacesOrig[fIdx][ch][j * getStride(chId) + i] = ClipBD((sum + iOffset) >> iBDPrecision, m_nBitDepth);
         }
       }
     }
   }
+#endif
   m_bPadded = true;
 
 #if SVIDEO_DEBUG
@@ -1537,6 +2719,14 @@ Void TGeometry::geometryMapping4SpherePadding()
                   || (m_chromaFormatIDC == ChromaFormat::_444 && m_InterpolationType[0] == m_InterpolationType[1]))
                    ? 1
                    : 2;
+#if SVIDEO_WEIGHT_MAP_CACHE
+  TWeightMapCache wmCache(m_sWeightMapCacheDir, m_iWeightMapCacheMaxMB);
+  if (wmCache.isEnabled())
+  {
+    wmCache.addKey(Int(1));   //0: conversion map; 1: sphere padding map;
+    xAddWeightMapCacheKey(wmCache);
+  }
+#endif
   for (Int fIdx = 0; fIdx < m_sVideoInfo.iNumFaces; fIdx++)
   {
 #if SVIDEO_GENERALIZED_CUBEMAP
@@ -1584,6 +2774,11 @@ Void TGeometry::geometryMapping4SpherePadding()
           m_pPixelWeight4SherePadding[fIdx][ch] =
             new PxlFltLut[iWidthPW * iHeightPW
                           - (iWidth >> getComponentScaleX(chId)) * (iHeight >> getComponentScaleY(chId))];
+#if SVIDEO_WEIGHT_MAP_CACHE
+          wmCache.addMap(m_pPixelWeight4SherePadding[fIdx][ch],
+                         (int64_t) iWidthPW * iHeightPW
+                           - (iWidth >> getComponentScaleX(chId)) * (iHeight >> getComponentScaleY(chId)));
+#endif
         }
         else if (m_sVideoInfo.geoType == SVIDEO_OCTAHEDRON || (m_sVideoInfo.geoType == SVIDEO_ICOSAHEDRON)
 #if SVIDEO_SEGMENTED_SPHERE
@@ -1598,6 +2793,9 @@ Void TGeometry::geometryMapping4SpherePadding()
         )
         {
           m_pPixelWeight4SherePadding[fIdx][ch] = new PxlFltLut[iWidthPW * iHeightPW];
+#if SVIDEO_WEIGHT_MAP_CACHE
+          wmCache.addMap(m_pPixelWeight4SherePadding[fIdx][ch], (int64_t) iWidthPW * iHeightPW);
+#endif
         }
         else
           CHECK(true, "Not supported yet!");
@@ -1605,9 +2803,38 @@ Void TGeometry::geometryMapping4SpherePadding()
     }
   }
 
+#if SVIDEO_WEIGHT_MAP_CACHE
+  if (wmCache.load())
+  {
+    m_bGeometryMapping4SpherePadding = true;
+    return;
+  }
+#endif
+
   // generate the map;
   Bool bPadded[SV_MAX_NUM_FACES];
   memset(bPadded, 0, sizeof(bPadded));
+#if SVIDEO_PARALLEL_PROCESSING
+  // the faces are processed in order since a face may only be sampled by the later ones once it is padded;
+  std::vector<RowBand> rowBands;
+  for (Int fIdx = 0; fIdx < m_sVideoInfo.iNumFaces; fIdx++)
+  {
+    xGetRowBands(iNumMaps, fIdx, rowBands);
+    if (rowBands.empty())
+      continue;
+    TThreadPool::runTasks(m_iNumThreads, (Int) rowBands.size(), [&](Int iTask) {
+      const RowBand &band = rowBands[iTask];
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+      TFastMath::Scope fastMath(m_bFastGeometryMapping);
+#endif
+      xSpherePaddingMappingRows(band.fIdx, band.ch, band.iRowStart, band.iRowEnd, bPadded);
+    });
+    bPadded[fIdx] = true;
+  }
+#else
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+  TFastMath::Scope fastMath(m_bFastGeometryMapping);
+#endif
   for (Int fIdx = 0; fIdx < m_sVideoInfo.iNumFaces; fIdx++)
   {
 #if SVIDEO_GENERALIZED_CUBEMAP
@@ -1704,10 +2931,265 @@ Void TGeometry::geometryMapping4SpherePadding()
 
     bPadded[fIdx] = true;
   }
+#endif
+#if SVIDEO_WEIGHT_MAP_CACHE
+  wmCache.store();
+#endif
 
   m_bGeometryMapping4SpherePadding = true;
 }
 
+#if SVIDEO_PARALLEL_PROCESSING
+/***************************************************
+//generate the sphere padding map of rows [iRowStart, iRowEnd) of one face channel;
+****************************************************/
+Void TGeometry::xSpherePaddingMappingRows(Int fIdx, Int ch, Int iRowStart, Int iRowEnd, const Bool *bPadded)
+{
+  ComponentID chId     = (ComponentID) ch;
+  Int         nWidth   = m_sVideoInfo.iFaceWidth >> getComponentScaleX(chId);
+  Int         nHeight  = m_sVideoInfo.iFaceHeight >> getComponentScaleY(chId);
+  Int         nMarginX = m_iMarginX >> getComponentScaleX(chId);
+
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+  Double chromaOffsetSrc[2] = { 0.0, 0.0 };   //[0: X; 1: Y];
+  Double chromaOffsetDst[2] = { 0.0, 0.0 };   //[0: X; 1: Y];
+  getFaceChromaOffset(chromaOffsetDst, fIdx, chId);
+#endif
+
+  for (Int j = iRowStart; j < iRowEnd; j++)
+  {
+    for (Int i = -nMarginX; i < nWidth + nMarginX; i++)
+    {
+#if SVIDEO_HEMI_PROJECTIONS
+      if ((m_sVideoInfo.geoType == SVIDEO_HCMP) || (m_sVideoInfo.geoType == SVIDEO_HEAC))
+      {
+        if (TGeometry::insideFace(fIdx, (i << getComponentScaleX(chId)), (j << getComponentScaleY(chId)),
+                                  COMPONENT_Y, chId))
+          continue;
+      }
+      else
+#endif
+      {
+        if (insideFace(fIdx, (i << getComponentScaleX(chId)), (j << getComponentScaleY(chId)), COMPONENT_Y, chId))
+          continue;
+      }
+
+      Int iLutIdx;
+      getSPLutIdx(ch, i, j, iLutIdx);
+
+      PxlFltLut &wList = m_pPixelWeight4SherePadding[fIdx][ch][iLutIdx];
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+      POSType x = (i) * (1 << getComponentScaleX(chId)) + chromaOffsetDst[0];
+      POSType y = (j) * (1 << getComponentScaleY(chId)) + chromaOffsetDst[1];
+#else
+      POSType x = (i) * (1 << getComponentScaleX(chId));
+      POSType y = (j) * (1 << getComponentScaleY(chId));
+#endif
+      SPos in(fIdx, x, y, 0), pos3D;
+#if SVIDEO_HEMI_PROJECTIONS
+      if ((m_sVideoInfo.geoType == SVIDEO_HCMP) || (m_sVideoInfo.geoType == SVIDEO_HEAC))
+        ((THCMP *) this)->map2DTo3D_org(in, &pos3D);
+      else
+        map2DTo3D(in, &pos3D);
+#else
+      map2DTo3D(in, &pos3D);
+#endif
+      map3DTo2D(&pos3D, &pos3D);
+#if SVIDEO_HEMI_PROJECTIONS
+      if ((m_sVideoInfo.geoType == SVIDEO_HCMP) || (m_sVideoInfo.geoType == SVIDEO_HEAC))
+      {
+        if (pos3D.faceIdx == 7)
+        {
+          pos3D.faceIdx = fIdx;
+        }
+      }
+#endif
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+      getFaceChromaOffset(chromaOffsetSrc, pos3D.faceIdx, chId);
+      pos3D.x = (pos3D.x - chromaOffsetSrc[0]) / (1 << getComponentScaleX(chId));
+      pos3D.y = (pos3D.y - chromaOffsetSrc[0]) / (1 << getComponentScaleY(chId));
+#else
+      pos3D.x /= (1 << getComponentScaleX(chId));
+      pos3D.y /= (1 << getComponentScaleY(chId));
+#endif
+      if ((bPadded[pos3D.faceIdx] || validPosition4Interp(chId, pos3D.x, pos3D.y)))
+        (this->*m_interpolateWeight[Int(toChannelType(chId))])(chId, &pos3D, wList);
+      else
+      {
+        pos3D.x = Clip3((POSType) 0.0, (POSType)(nWidth - 1), pos3D.x);
+        pos3D.y = Clip3((POSType) 0.0, (POSType)(nHeight - 1), pos3D.y);
+        interpolate_nn_weight(chId, &pos3D, wList);
+      }
+    }
+  }
+}
+#endif
+
+#if SVIDEO_PADDING_GATHER_TABLE
+/***************************************************
+//resolve the sphere padding map of one face and map into a table of the margin samples;
+****************************************************/
+Void TGeometry::xBuildPaddingTable(Int fIdx, Int mapIdx)
+{
+  ComponentID chId      = (ComponentID) mapIdx;
+  ChannelType chType    = toChannelType(chId);
+  Int         nWidth    = m_sVideoInfo.iFaceWidth >> getComponentScaleX(chId);
+  Int         nHeight   = m_sVideoInfo.iFaceHeight >> getComponentScaleY(chId);
+  Int         nMarginX  = m_iMarginX >> getComponentScaleX(chId);
+  Int         nMarginY  = m_iMarginY >> getComponentScaleY(chId);
+  Int         iStride   = getStride(chId);
+  Int         iFaceMask = (1 << m_WeightMap_NumOfBits4Faces) - 1;
+  Int         iWLutIdx =
+    (m_chromaFormatIDC == ChromaFormat::_400 || (m_InterpolationType[0] == m_InterpolationType[1])) ? 0 : Int(chType);
+  Int iTapsX     = m_iInterpFilterTaps[Int(chType)][0];
+  Int iTapsY     = m_iInterpFilterTaps[Int(chType)][1];
+  Int iTapOffset = ((iTapsY - 1) >> 1) * iStride + ((iTapsX - 1) >> 1);
+  Int iUnity     = 1 << S_INTERPOLATE_PrecisionBD;
+
+  auto inside = [&](Int i, Int j) {
+#if SVIDEO_HEMI_PROJECTIONS
+    if ((m_sVideoInfo.geoType == SVIDEO_HCMP) || (m_sVideoInfo.geoType == SVIDEO_HEAC))
+      return TGeometry::insideFace(fIdx, (i << getComponentScaleX(chId)), (j << getComponentScaleY(chId)), COMPONENT_Y, chId);
+#endif
+    return insideFace(fIdx, (i << getComponentScaleX(chId)), (j << getComponentScaleY(chId)), COMPONENT_Y, chId);
+  };
+  // a block of the face itself is harmless unless it reaches a sample this face pads;
+  auto readsMargin = [&](Int iSrc, Int iWidth, Int iHeight) {
+    Int iPos = iSrc + nMarginY * iStride + nMarginX;
+    Int x0   = iPos % iStride - nMarginX;
+    Int y0   = iPos / iStride - nMarginY;
+    for (Int y = y0; y < y0 + iHeight; y++)
+    {
+      for (Int x = x0; x < x0 + iWidth; x++)
+      {
+        if (x < -nMarginX || x >= nWidth + nMarginX || y < -nMarginY || y >= nHeight + nMarginY || !inside(x, y))
+          return true;
+      }
+    }
+    return false;
+  };
+
+  PaddingGatherTable *pTable = new PaddingGatherTable;
+  pTable->bSelfReference     = false;
+  pTable->rowStart.reserve(nHeight + (nMarginY << 1) + 1);
+  for (Int j = -nMarginY; j < nHeight + nMarginY; j++)
+  {
+    Int iRowStart = (Int) pTable->segments.size();
+    pTable->rowStart.push_back(iRowStart);
+    for (Int i = -nMarginX; i < nWidth + nMarginX; i++)
+    {
+      if (inside(i, j))
+        continue;
+
+      Int iLutIdx;
+      getSPLutIdx(mapIdx, i, j, iLutIdx);
+      const PxlFltLut &wList = m_pPixelWeight4SherePadding[fIdx][mapIdx][iLutIdx];
+      Int        face  = wList.facePos & iFaceMask;
+      Int        iSrc  = (wList.facePos >> m_WeightMap_NumOfBits4Faces) - iTapOffset;
+      const Int *pWLut = m_pWeightLut[iWLutIdx][wList.weightIdx];
+      Int        iDst  = j * iStride + i;
+
+      // a single tap of unit weight copies that sample, the rounding and the clipping leave it unchanged;
+      Int iCopyTap = -1, iNumTaps = 0;
+      for (Int k = 0; k < iTapsX * iTapsY; k++)
+      {
+        if (pWLut[k])
+        {
+          iNumTaps++;
+          iCopyTap = (pWLut[k] == iUnity) ? k : -1;
+        }
+      }
+      if (iNumTaps != 1)
+        iCopyTap = -1;
+
+      PaddingSegment *pLast = (Int) pTable->segments.size() > iRowStart ? &pTable->segments.back() : nullptr;
+      if (iCopyTap >= 0)
+      {
+        Int iSrcCopy = iSrc + (iCopyTap / iTapsX) * iStride + iCopyTap % iTapsX;
+        if (face == fIdx && !pTable->bSelfReference)
+          pTable->bSelfReference = readsMargin(iSrcCopy, 1, 1);
+        if (pLast && pLast->iSrcFace == face && pLast->iDst + pLast->iLength == iDst
+            && (pLast->iLength == 1 || iSrcCopy == pLast->iSrc + pLast->iLength * pLast->iSrcStep))
+        {
+          if (pLast->iLength == 1)
+            pLast->iSrcStep = iSrcCopy - pLast->iSrc;
+          pLast->iLength++;
+        }
+        else
+        {
+          PaddingSegment seg = { iDst, 1, face, iSrcCopy, 1 };
+          pTable->segments.push_back(seg);
+        }
+      }
+      else
+      {
+        if (face == fIdx && !pTable->bSelfReference)
+          pTable->bSelfReference = readsMargin(iSrc, iTapsX, iTapsY);
+        if (pLast && pLast->iSrcFace < 0)
+        {
+          pLast->iLength++;
+        }
+        else
+        {
+          PaddingSegment seg = { 0, 1, -1, (Int) pTable->samples.size(), 0 };
+          pTable->segments.push_back(seg);
+        }
+        Interp360GatherSample sample = { iDst, face, iSrc, pWLut };
+        pTable->samples.push_back(sample);
+      }
+    }
+  }
+  pTable->rowStart.push_back((Int) pTable->segments.size());
+  m_pPaddingTable[fIdx][mapIdx] = pTable;
+}
+
+/***************************************************
+//sphere padding of rows [iRowStart, iRowEnd) of one face channel from its table;
+****************************************************/
+Void TGeometry::xSpherePaddingRows(Int fIdx, Int ch, Int iRowStart, Int iRowEnd)
+{
+  ComponentID chId     = (ComponentID) ch;
+  Int         mapIdx   = (ch == 0 || m_chromaFormatIDC == ChromaFormat::_400
+                  || (m_chromaFormatIDC == ChromaFormat::_444 && m_InterpolationType[0] == m_InterpolationType[1]))
+                           ? 0
+                           : 1;
+  Int         nMarginY = m_iMarginY >> getComponentScaleY(chId);
+  Int         iStride  = getStride(chId);
+  const PaddingGatherTable &table = *m_pPaddingTable[fIdx][mapIdx];
+
+  Pel *pFaces[SV_MAX_NUM_FACES];
+  for (Int f = 0; f < m_sVideoInfo.iNumFaces; f++)
+  {
+    pFaces[f] = m_pFacesOrig[f][ch];
+  }
+  Pel *pDst = pFaces[fIdx];
+  auto gather2D = g_interp360OP.gather2D[m_iInterpFilterTaps[Int(toChannelType(chId))][0]];
+
+  for (Int iSeg = table.rowStart[iRowStart + nMarginY]; iSeg < table.rowStart[iRowEnd + nMarginY]; iSeg++)
+  {
+    const PaddingSegment &seg = table.segments[iSeg];
+    if (seg.iSrcFace < 0)
+    {
+      gather2D(pDst, pFaces, iStride, table.samples.data() + seg.iSrc, seg.iLength, S_INTERPOLATE_PrecisionBD, m_nBitDepth);
+    }
+    else if (seg.iSrcStep == 1 && seg.iSrcFace != fIdx)
+    {
+      memcpy(pDst + seg.iDst, pFaces[seg.iSrcFace] + seg.iSrc, seg.iLength * sizeof(Pel));
+    }
+    else
+    {
+      // rotated or mirrored neighbour, or a run within the face itself that must be copied in order;
+      const Pel *pSrc    = pFaces[seg.iSrcFace] + seg.iSrc;
+      Pel       *pDstRun = pDst + seg.iDst;
+      for (Int k = 0; k < seg.iLength; k++, pSrc += seg.iSrcStep)
+      {
+        pDstRun[k] = *pSrc;
+      }
+    }
+  }
+}
+#endif
+
 // the origin for (x, y) cooridates is the topleft of picture;
 Void TGeometry::getSPLutIdx(Int ch, Int x, Int y, Int &iIdx)
 {
@@ -2337,16 +3819,37 @@ Void TGeometry::initInterpolation(Int *pInterpolateType)
 }
 
 #if SVIDEO_SPSNR_I
+// interpolation of one sample from the top-left sample of its filter support; shared by getPelValue() and getPelValues();
+static inline Pel filterPelValue(const Pel *pPelLine, Int iStride, const Int *pWLut, Int iTapsX, Int iTapsY, Int iBitDepth)
+{
+  Int iBDPrecision = S_INTERPOLATE_PrecisionBD;
+  Int iOffset      = 1 << (iBDPrecision - 1);
+  Int sum          = 0;
+#if SVIDEO_INTERP_KERNELS
+  sum = g_interp360OP.filter2D[iTapsX](pPelLine, iStride, pWLut);
+#else
+  for (Int m = 0; m < iTapsY; m++)
+  {
+    for (Int n = 0; n < iTapsX; n++)
+      sum += pPelLine[n] * pWLut[n];
+    pPelLine += iStride;
+    pWLut += iTapsX;
+  }
+#endif
+#if SVIDEO_GEOCONVERT_CLIP
+  return ClipBD((sum + iOffset) >> iBDPrecision, iBitDepth);
+#else
+  return (sum + iOffset) >> iBDPrecision;
+#endif
+}
+
 Pel TGeometry::getPelValue(ComponentID chId, SPos inPos)
 {
-  Int         sum                = 0;
   ChannelType chType             = toChannelType(chId);
   Int         iWidthPW           = getStride(chId);
   Int         iWeightMapFaceMask = (1 << m_WeightMap_NumOfBits4Faces) - 1;
-  Pel         pVal;
-  Int         iBDPrecision = S_INTERPOLATE_PrecisionBD;
-  Int         iOffset      = 1 << (iBDPrecision - 1);
-  // Int x, y;
+  Int         iTapsX             = m_iInterpFilterTaps[Int(chType)][0];
+  Int         iTapsY             = m_iInterpFilterTaps[Int(chType)][1];
   PxlFltLut wList;
 
   (this->*m_interpolateWeight[Int(chType)])(chId, &inPos, wList);
@@ -2355,25 +3858,38 @@ Pel TGeometry::getPelValue(ComponentID chId, SPos inPos)
   Int  iTLPos   = (wList.facePos) >> m_WeightMap_NumOfBits4Faces;
   Int  iWLutIdx = (m_chromaFormatIDC == ChromaFormat::_400 || (m_InterpolationType[0] == m_InterpolationType[1])) ? 0 : Int(chType);
   Int *pWLut    = m_pWeightLut[iWLutIdx][wList.weightIdx];
-  Pel *pPelLine = m_pFacesOrig[face][chId] + iTLPos - ((m_iInterpFilterTaps[Int(chType)][1] - 1) >> 1) * iWidthPW
-                  - ((m_iInterpFilterTaps[Int(chType)][0] - 1) >> 1);
+  Pel *pPelLine = m_pFacesOrig[face][chId] + iTLPos - ((iTapsY - 1) >> 1) * iWidthPW - ((iTapsX - 1) >> 1);
+
+  return filterPelValue(pPelLine, iWidthPW, pWLut, iTapsX, iTapsY, m_nBitDepth);
+}
+
+#if SVIDEO_SPSNR_I_POINT_MAP
+Void TGeometry::getPelWeight(ComponentID chId, SPos inPos, PxlFltLut &wList)
+{
+  (this->*m_interpolateWeight[Int(toChannelType(chId))])(chId, &inPos, wList);
+}
+
+Void TGeometry::getPelValues(ComponentID chId, const PxlFltLut *pWList, Int iNumPos, Pel *pDst)
+{
+  ChannelType chType             = toChannelType(chId);
+  Int         iWidthPW           = getStride(chId);
+  Int         iWeightMapFaceMask = (1 << m_WeightMap_NumOfBits4Faces) - 1;
+  Int         iWLutIdx           = (m_chromaFormatIDC == ChromaFormat::_400 || (m_InterpolationType[0] == m_InterpolationType[1])) ? 0 : Int(chType);
+  Int         iTapsX             = m_iInterpFilterTaps[Int(chType)][0];
+  Int         iTapsY             = m_iInterpFilterTaps[Int(chType)][1];
+  Int         iTLOffset          = ((iTapsY - 1) >> 1) * iWidthPW + ((iTapsX - 1) >> 1);
 
-  for (Int m = 0; m < m_iInterpFilterTaps[Int(chType)][1]; m++)
+  for (Int i = 0; i < iNumPos; i++)
   {
-    for (Int n = 0; n < m_iInterpFilterTaps[Int(chType)][0]; n++)
-      sum += pPelLine[n] * pWLut[n];
-    pPelLine += iWidthPW;
-    pWLut += m_iInterpFilterTaps[Int(chType)][0];
+    Int  face     = (pWList[i].facePos) & iWeightMapFaceMask;
+    Int  iTLPos   = (pWList[i].facePos) >> m_WeightMap_NumOfBits4Faces;
+    Int *pWLut    = m_pWeightLut[iWLutIdx][pWList[i].weightIdx];
+    Pel *pPelLine = m_pFacesOrig[face][chId] + iTLPos - iTLOffset;
+    pDst[i]       = filterPelValue(pPelLine, iWidthPW, pWLut, iTapsX, iTapsY, m_nBitDepth);
   }
-#if SVIDEO_GEOCONVERT_CLIP
-  pVal = ClipBD((sum + iOffset) >> iBDPrecision, m_nBitDepth);
-#else
-  pVal  = (sum + iOffset) >> iBDPrecision;
-#endif
-
-  return pVal;
 }
 #endif
+#endif
 
 Void TGeometry::setChromaResamplingFilter(Int iChromaSampleLocType)
 {
@@ -2942,4 +4458,88 @@ Void TGeometry::getFaceChromaOffset(Double dChromaOffset[2], Int iFaceIdx, Compo
 }
 #endif
 
+#if SVIDEO_WEIGHT_MAP_CACHE
+/***************************************************
+//add everything the weight maps of this geometry depend on to the cache key;
+****************************************************/
+Void TGeometry::xAddWeightMapCacheKey(TWeightMapCache &cache)
+{
+  cache.addKey(m_sVideoInfo);
+  cache.addKey(Int(m_chromaFormatIDC));
+  for (Int ch = 0; ch < MAX_NUM_CHANNEL_TYPE; ch++)
+  {
+    cache.addKey(Int(m_InterpolationType[ch]));
+  }
+  cache.addKey(m_iMarginX);
+  cache.addKey(m_iMarginY);
+  cache.addKey(m_WeightMap_NumOfBits4Faces);
+  cache.addKey(m_bConvOutputPaddingNeeded);
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+  cache.addKey(m_bFastGeometryMapping);
+#endif
+#if !SVIDEO_CHROMA_TYPES_SUPPORT
+  cache.addKey(m_bResampleChroma);
+  cache.addKey(m_iChromaSampleLocType);
+#endif
+}
+#endif
+
+#if SVIDEO_CONVERSION_CACHE
+/***************************************************
+//key of everything the face buffers written by convertYuv() depend on;
+//with bPadding, the sphere padding is included as well;
+****************************************************/
+Void TGeometry::getConversionKey(std::vector<UChar> &key, Bool bPadding)
+{
+  TGeometryKey keyBuilder;
+  keyBuilder.addKey(m_sVideoInfo);
+  keyBuilder.addKey(Int(m_chromaFormatIDC));
+  keyBuilder.addKey(m_nBitDepth);
+  keyBuilder.addKey(m_iMarginX);
+  keyBuilder.addKey(m_iMarginY);
+#if !SVIDEO_CHROMA_TYPES_SUPPORT
+  keyBuilder.addKey(m_bResampleChroma);
+  keyBuilder.addKey(m_iChromaSampleLocType);
+#endif
+  if (bPadding)
+  {
+    for (Int ch = 0; ch < MAX_NUM_CHANNEL_TYPE; ch++)
+    {
+      keyBuilder.addKey(Int(m_InterpolationType[ch]));
+    }
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+    keyBuilder.addKey(m_bFastGeometryMapping);
+#endif
+  }
+  key = keyBuilder.getKey();
+}
+
+/***************************************************
+//take over the face buffers (including the margins) of a geometry with the same conversion key;
+****************************************************/
+Void TGeometry::copyFaces(TGeometry *pGeoSrc, Bool bPadded)
+{
+  CHECK(m_iMarginX != pGeoSrc->m_iMarginX || m_iMarginY != pGeoSrc->m_iMarginY, "face layouts differ");
+#if SVIDEO_FACE_VIEWS
+  xDetachFaceViews();
+#endif
+  for (Int fIdx = 0; fIdx < m_sVideoInfo.iNumFaces; fIdx++)
+  {
+    for (Int ch = 0; ch < getNumChannels(); ch++)
+    {
+      ComponentID chId         = ComponentID(ch);
+      Int         iTotalHeight = (m_sVideoInfo.iFaceHeight + (m_iMarginY << 1)) >> getComponentScaleY(chId);
+#if SVIDEO_FACE_VIEWS
+      // the source face may reference a picture; both layouts have the same stride and margins;
+      const Pel *pSrcBuf = pGeoSrc->m_pFacesOrig[fIdx][ch] - getStride(chId) * getMarginY(chId) - getMarginX(chId);
+      memcpy(m_pFacesBuf[fIdx][ch], pSrcBuf, getStride(chId) * iTotalHeight * sizeof(Pel));
+#else
+      memcpy(m_pFacesBuf[fIdx][ch], pGeoSrc->m_pFacesBuf[fIdx][ch], getStride(chId) * iTotalHeight * sizeof(Pel));
+#endif
+    }
+  }
+  setPaddingFlag(bPadded);
+}
+#endif
+
 #endif
@@ -40,6 +40,7 @@
 #include <math.h>
 #include "../CommonLib/CommonDef.h"
 #include "../Utilities/VideoIOYuv.h"
+#include "../CommonLib/Interpolation360.h"
 
 
 // ====================================================================================================================
@@ -203,6 +204,35 @@
 #endif
 // 360Lib-12.0;
 #define SVIDEO_GCMP_BLENDING                             1      //JVET-T0118
+// 360Lib-13.x performance;
+#define SVIDEO_PARALLEL_PROCESSING                       1      // multi-threaded geometry conversion;
+#define SVIDEO_WEIGHT_MAP_CACHE                          1      // on-disk cache of the geometry weight maps;
+#define SVIDEO_INTERP_KERNELS                            1      // tap-specialised (SIMD) interpolation kernels;
+#define SVIDEO_ROW_PROJECTION                            1      // row-at-a-time projection without per-sample virtual calls;
+#define SVIDEO_FAST_GEOMETRY_MAPPING                     1      // opt-in single-precision trigonometry for the weight map generation;
+#define SVIDEO_VIEWPORT_MAP_CACHE                        1      // viewport: camera set up once, weight maps reused for repeated orientations;
+#if SVIDEO_VIEWPORT_MAP_CACHE
+#define SVIDEO_VIEWPORT_MAP_CACHE_SIZE                   2      // number of orientations kept besides the current one;
+#endif
+#define SVIDEO_CONVERSION_CACHE                          1      // per-picture cache of the converted face buffers shared by the metrics;
+#define SVIDEO_PARALLEL_METRICS                          1      // concurrent evaluation of the metrics of a picture; depends on SVIDEO_PARALLEL_PROCESSING and SVIDEO_CONVERSION_CACHE;
+#define SVIDEO_SPSNR_NN_POINT_LIST                       1      // S-PSNR-NN: per-sequence sample position lists, fisheye inclusion test done once;
+#define SVIDEO_SPSNR_I_POINT_MAP                         1      // S-PSNR-I: geometries and interpolation records of the sphere points kept for the sequence;
+#define SVIDEO_CPPPSNR_MASK                              1      // CPP-PSNR: CPP pictures kept for the sequence, valid sample mask built once;
+#define SVIDEO_WSPSNR_WEIGHT_PLANE                       1      // WS-PSNR: weights of the packed frame resolved once in createTable, SIMD weighted SSE per row;
+#define SVIDEO_FUSED_FACE_IMPORT                         1      // ERP family: convertYuv pads each face row as it is written, chroma upsampled and padded by row pairs; depends on SVIDEO_CHROMA_TYPES_SUPPORT;
+#define SVIDEO_FACE_VIEWS                                1      // ERP family: opt-in, the face references the source picture in place when its stride and margins fit; depends on SVIDEO_FUSED_FACE_IMPORT;
+#define SVIDEO_COMPACT_WEIGHT_MAP                        1      // opt-in 4-byte delta coded weight maps of the converted samples only, weight tables shared by all geometries; depends on SVIDEO_PARALLEL_PROCESSING;
+#define SVIDEO_FRAME_PIPELINE                            1      // 360ConvertApp: opt-in reader, frame conversion workers and ordered writer run concurrently, the workers share the weight maps; depends on SVIDEO_PARALLEL_PROCESSING;
+#define SVIDEO_VIEWPORT_RENDERER                         1      // batch rendering of many viewports from one imported and padded picture, viewport geometries cached by pose; depends on SVIDEO_PARALLEL_PROCESSING;
+#define SVIDEO_SEPARABLE_MAPPING                         1      // weight map generation: ERP longitude/latitude terms and EAC tangents evaluated once per column and row of a band (bit-exact); depends on SVIDEO_ROW_PROJECTION;
+#define SVIDEO_CHROMA_RESAMPLE_KERNELS                   1      // chroma up/downsampling: SIMD row kernels of the resampling filters (Resample360Ops), bands of rows of a face run in parallel; depends on SVIDEO_PARALLEL_PROCESSING;
+#define SVIDEO_COMPACT_COPY_PLAN                         1      // OHP/ISP compact frame packing: samples copied by triangleFaceCopy resolved once per layout into row spans, bands of spans run in parallel; depends on SVIDEO_PARALLEL_PROCESSING;
+#define SVIDEO_INPUT_LOOKAHEAD                           1      // encoder: opt-in thread reading and converting the next input pictures into a ring of buffers while the encoder codes; depends on SVIDEO_PARALLEL_PROCESSING;
+#define SVIDEO_DECODER_RENDER_THREAD                     1      // decoder: opt-in thread rendering the queued output pictures to the source geometry (AppDecHelper360) while the decoder goes on; depends on SVIDEO_PARALLEL_PROCESSING;
+#define SVIDEO_PADDING_GATHER_TABLE                      1      // sphere padding: margin samples resolved once into border-only tables, pure copies run as block copies, the rest through a batch filter kernel, bands of a face in parallel; ERP/SSP/RSP margins copied by rows; depends on SVIDEO_PARALLEL_PROCESSING and SVIDEO_INTERP_KERNELS;
+// 360Lib-13.x fixes;
+#define SVIDEO_SSP_GUARD_BAND_FIX                        1      // SSP: the guard band between the stacked poles must not be written below a one-row picture;
 
 //#define SV_MAX_NUM_SAMPLING          64
 #define SV_MAX_NUM_FACES             20
@@ -210,16 +240,29 @@
 
 #define SVIDEO_DEBUG                 0
 
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+#define scos(x)         (TFastMath::isEnabled() ? TFastMath::cos((Double)(x)) : cos((Double)(x)))
+#define ssin(x)         (TFastMath::isEnabled() ? TFastMath::sin((Double)(x)) : sin((Double)(x)))
+#define satan(x)        (TFastMath::isEnabled() ? TFastMath::atan((Double)(x)) : atan((Double)(x)))
+#define satan2(y, x)    (TFastMath::isEnabled() ? TFastMath::atan2((Double)(y), (Double)(x)) : atan2((Double)(y), (Double)(x)))
+#define sacos(x)        (TFastMath::isEnabled() ? TFastMath::acos((Double)(x)) : acos((Double)(x)))
+#define sasin(x)        (TFastMath::isEnabled() ? TFastMath::asin((Double)(x)) : asin((Double)(x)))
+#else
 #define scos(x)         cos((Double)(x))
 #define ssin(x)         sin((Double)(x))
 #define satan(x)        atan((Double)(x))
 #define satan2(y, x)    atan2((Double)(y), (Double)(x))
 #define sacos(x)        acos((Double)(x))
 #define sasin(x)        asin((Double)(x))
+#endif
 #define ssqrt(x)        sqrt((Double)(x))
 #define sfloor(x)       floor((Double)(x))
 #define sfabs(x)        fabs((Double)(x))
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+#define stan(x)         (TFastMath::isEnabled() ? TFastMath::tan((Double)(x)) : tan((Double)(x)))
+#else
 #define stan(x)         tan((Double)(x))
+#endif
 
 // ====================================================================================================================
 // Basic type redefinition
@@ -257,6 +300,15 @@ static const Int  S_LANCZOS_LUT_SCALE = 100;
 #if SVIDEO_COHP1_PADDING
 static const Int  S_COHP1_PAD = 16;
 #endif
+#if SVIDEO_PARALLEL_PROCESSING
+static const Int  S_PARALLEL_ROW_BAND = 16;   //number of rows per task in multi-threaded conversion;
+#endif
+#include "TFastMath.h"
+#if SVIDEO_COMPACT_WEIGHT_MAP
+static const Int  S_COMPACT_MAP_PHASE_BITS  = 7;               //horizontal and vertical phase, [0, S_LANCZOS_LUT_SCALE];
+static const Int  S_COMPACT_MAP_DELTA_SHIFT = 14;              //the position delta takes the 18 MSBs;
+static const Int  S_COMPACT_MAP_ESCAPE      = -(1 << 17);      //delta value announcing an absolute facePos word;
+#endif
 
 enum GeometryType
 {
@@ -526,13 +578,81 @@ struct TriMesh
 };
 
 class TGeometry;
+#if SVIDEO_WEIGHT_MAP_CACHE
+class TWeightMapCache;
+#endif
 struct PxlFltLut
 {
   Int facePos;          //MSBs for pos; LSBs for faceIdx;
   UShort weightIdx; 
 };
 typedef Void (TGeometry::*interpolateWeightFP)(ComponentID chId, SPos *pSPosIn, PxlFltLut &wlist);
+#if SVIDEO_COMPACT_WEIGHT_MAP
+// weight map of one face holding the samples written by geoConvert only, row by row in raster order; one word each:
+// [31:14] source position delta to the previous sample of the row, [13:7] vertical phase, [6:0] horizontal phase;
+// the delta S_COMPACT_MAP_ESCAPE is followed by the absolute facePos (first sample of a row, change of the face);
+struct CompactWeightMap
+{
+  std::vector<UInt> words;
+  std::vector<UInt> rowStart;   //[row including the margin] index of the first word;
+};
+#endif
+#if SVIDEO_PADDING_GATHER_TABLE
+// margin samples of one face written by spherePadding(), resolved from m_pPixelWeight4SherePadding in the order of the
+// padding loop; a segment is either a copy run (consecutive samples of a row taking one source sample each, the source
+// advancing by a constant step: wrap-around, rotated or mirrored neighbours) or a run of filtered samples;
+struct PaddingSegment
+{
+  Int iDst;        //copy run: offset of the first sample to the face origin;
+  Int iLength;
+  Int iSrcFace;    //copy run: source face; -1: filtered samples [iSrc, iSrc + iLength) of PaddingGatherTable::samples;
+  Int iSrc;        //copy run: offset of the first source sample to the origin of the source face;
+  Int iSrcStep;
+};
+
+struct PaddingGatherTable
+{
+  std::vector<PaddingSegment>        segments;
+  std::vector<Interp360GatherSample> samples;
+  std::vector<Int>                   rowStart;         //[row including the margin] index of the first segment, one extra entry closing the last row;
+  Bool                               bSelfReference;   //a sample reads the face it pads, the rows are padded in order;
+};
+#endif
+#if SVIDEO_PARALLEL_PROCESSING
+struct RowBand
+{
+  Int fIdx;
+  Int ch;
+  Int iRowStart;        //rows [iRowStart, iRowEnd) including the margin, relative to the face origin;
+  Int iRowEnd;
+};
+#endif
 
+#if SVIDEO_SEPARABLE_MAPPING
+// terms of a projection that depend on one coordinate only (the longitude of an ERP column, the tangent of an EAC row, ...)
+// memoised while the rows of a band are mapped; a term is reused only for the very same argument (bit for bit), so the
+// weight maps are the same with and without the memo;
+struct SeparableMemo
+{
+  POSType              rowArg;
+  POSType              rowVal[2];
+  std::vector<POSType> colArg[2];
+  std::vector<POSType> colVal[2];
+
+  Void init(Int iNumColumns);
+  static Bool isSame(POSType a, POSType b) { return a == b && std::signbit(a) == std::signbit(b); }
+};
+#endif
+
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+struct GeoMappingError
+{
+  Double  dMaxPosError;        //largest distance between the fast and the double-precision source positions, in samples;
+  Double  dSumPosError;
+  int64_t iNumSamples;
+  int64_t iNumFaceMismatch;    //samples mapped to a different source face;
+};
+#endif
 
 struct InputGeoParam
 {
@@ -546,6 +666,19 @@ struct InputGeoParam
 #if !SVIDEO_CHROMA_TYPES_SUPPORT
   Int iChromaSampleLocType;
 #endif
+#if SVIDEO_PARALLEL_PROCESSING
+  Int iNumThreads;      //number of threads for geometry conversion; 1: serial;
+#endif
+#if SVIDEO_WEIGHT_MAP_CACHE
+  std::string sWeightMapCacheDir;   //directory of the weight map cache; empty: disabled;
+  Int iWeightMapCacheMaxMB;         //size limit of the weight map cache, the least recently used files are removed beyond it; 0: unlimited;
+#endif
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+  Bool bFastGeometryMapping;        //generate the weight maps with single-precision trigonometry;
+#endif
+#if SVIDEO_COMPACT_WEIGHT_MAP
+  Bool bCompactWeightMap;           //keep the weight maps in the compact format once they are generated;
+#endif
 };
 
 struct SpherePoints
@@ -590,6 +723,13 @@ protected:
   Pel **m_pFacesBufTempOrig;
 
   Bool m_bPadded;
+#if SVIDEO_CONVERSION_CACHE
+  UInt m_uiFacesStamp;     //changes whenever the face buffers receive a new picture;
+#endif
+#if SVIDEO_FACE_VIEWS
+  Int  m_iFaceViewSrcMargin;              //luma margin of the source pictures the faces may reference; 0: the faces are always copied;
+  Bool m_bFaceView[MAX_NUM_COMPONENT];    //face 0 of the channel references the source picture instead of m_pFacesBuf;
+#endif
   //interpolation;
   SInterpolationType m_InterpolationType[MAX_NUM_CHANNEL_TYPE];
   //frame packing;
@@ -613,12 +753,90 @@ protected:
   Bool m_bGeometryMapping4SpherePadding;
   PxlFltLut *m_pPixelWeight4SherePadding[SV_MAX_NUM_FACES][2];
   Bool m_bConvOutputPaddingNeeded;
+#if SVIDEO_ROT_FIX
+  typedef Void (TGeometry::*RotationFunc)(SPos &sPos, Int iRoll, Int iPitch, Int iYaw);
+  RotationFunc xGetMappingRotation(TGeometry *pGeoSrc, Bool bRec, Int pRot[3]);
+#endif
+#if SVIDEO_PARALLEL_PROCESSING
+  Int  m_iNumThreads;
+  Void xGetRowBands(Int iNumChannels, Int iFaceIdx, std::vector<RowBand> &rowBands);   //iFaceIdx < 0: all faces;
+  Void xGeoConvertRows(TGeometry *pGeoDst, Int fIdx, Int ch, Int iRowStart, Int iRowEnd);
+#if SVIDEO_ROT_FIX
+  Void xGeometryMappingRows(TGeometry *pGeoSrc, Int fIdx, Int ch, Int iRowStart, Int iRowEnd,
+                            Void (TGeometry::*pfuncRotation)(SPos &sPos, Int iRoll, Int iPitch, Int iYaw), const Int *pRot);
+#else
+  Void xGeometryMappingRows(TGeometry *pGeoSrc, Int fIdx, Int ch, Int iRowStart, Int iRowEnd, const Int *pRot);
+#endif
+  Void xSpherePaddingMappingRows(Int fIdx, Int ch, Int iRowStart, Int iRowEnd, const Bool *bPadded);
+#endif
+#if SVIDEO_PADDING_GATHER_TABLE
+  PaddingGatherTable *m_pPaddingTable[SV_MAX_NUM_FACES][2];   //[face][map], built from m_pPixelWeight4SherePadding;
+  Void xBuildPaddingTable(Int fIdx, Int mapIdx);
+  Void xSpherePaddingRows(Int fIdx, Int ch, Int iRowStart, Int iRowEnd);
+#endif
+#if SVIDEO_ROW_PROJECTION
+  template<class T> static Void xMap2DTo3DRow(T *pGeo, SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+  {
+    for (Int i = 0; i < iNum; i++)
+    {
+      pGeo->T::map2DTo3D(pSPosIn[i], pSPosOut + i);
+    }
+  }
+  template<class T> static Void xMap3DTo2DRow(T *pGeo, SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+  {
+    for (Int i = 0; i < iNum; i++)
+    {
+      pGeo->T::map3DTo2D(pSPosIn + i, pSPosOut + i);
+    }
+  }
+  template<class T>
+  static Void xInsideFaceRow(T *pGeo, Int fId, Int x, Int iStepX, Int y, Int iNum, ComponentID chId,
+                             ComponentID origchId, Bool *pbInside)
+  {
+    for (Int i = 0; i < iNum; i++, x += iStepX)
+    {
+      pbInside[i] = pGeo->T::insideFace(fId, x, y, chId, origchId);
+    }
+  }
+#endif
+#if SVIDEO_WEIGHT_MAP_CACHE
+  std::string m_sWeightMapCacheDir;
+  Int         m_iWeightMapCacheMaxMB;
+  Void xAddWeightMapCacheKey(TWeightMapCache &cache);
+#endif
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+  Bool m_bFastGeometryMapping;
+#endif
+#if SVIDEO_COMPACT_WEIGHT_MAP
+  Bool m_bCompactWeightMap;
+  Bool m_bSharedWeightLut;                                            //m_pWeightLut is shared by the geometries that compact their maps;
+  CompactWeightMap *m_pCompactWeightMap[SV_MAX_NUM_FACES][2];       //replaces m_pPixelWeight of the face once built;
+  Bool m_bCompactWeightMapTried[SV_MAX_NUM_FACES][2];
+  Int  xGetConvertSampleType(Int fIdx, ComponentID chId, Int i, Int j);
+  Void xCompactWeightMaps(TGeometry *pGeoSrc);
+  Void xGeoConvertRowsCompact(TGeometry *pGeoDst, Int fIdx, Int ch, Int iRowStart, Int iRowEnd, const CompactWeightMap &map);
+#endif
+#if SVIDEO_FRAME_PIPELINE
+  Bool m_bSharedWeightMaps;                 //m_pPixelWeight (and the compact maps) belong to another geometry;
+  Bool m_bSharedWeightMaps4SpherePadding;   //m_pPixelWeight4SherePadding belongs to another geometry;
+#endif
 
   Void geometryMapping4SpherePadding();
   Void getSPLutIdx(Int ch, Int x, Int y, Int& iIdx);
 
   Void initInterpolation(Int *pInterpolateType);
   Void chromaUpsample(Pel *pSrcBuf, Int nWidthC, Int nHeightC, Int iStrideSrc, Int iFaceId, ComponentID chId);
+#if SVIDEO_FUSED_FACE_IMPORT
+  Void chromaUpsampleWrapPadded(Pel *pSrcBuf, Int nWidthC, Int nHeightC, Int iStrideSrc, Int iFaceId, ComponentID chId, Int nMarginX);
+#endif
+#if SVIDEO_CHROMA_RESAMPLE_KERNELS
+  Void xChromaUpsampleRows(Pel *pSrcBuf, Int nWidthC, Int iStrideSrc, Pel *pDstBuf, Int iStrideDst, Int iRowStart, Int iRowEnd, Int nMarginX);
+#endif
+#if SVIDEO_FACE_VIEWS
+  Bool xViewFace(const PelBuf &srcBuf, Pel *pSrc, ComponentID chId);
+  Void xDetachFaceView(Int ch);
+  Void xDetachFaceViews();
+#endif
   Void rotOneFaceChannel(Pel *pSrc, Int iWidthSrc, Int iHeightSrc, Int iStrideSrc, Int iNumSamplesPerPixel, Int ch, Int rot, PelUnitBuf *pDstYuv, Int offsetX, Int offsetY, Int faceIdx, Int iBDAdjust);
   Void rotFaceChannelGeneral(Pel *pSrc, Int iWidthSrc, Int iHeightSrc, Int iStrideSrc, Int nSPPSrc, Int rot, Pel *pDst, Int iStrideDst, Int nSPPDst, Bool bInverse=false);
   Void chromaDonwsampleH(Pel *pSrcBuf, Int iWidth, Int iHeight, Int iStrideSrc, Int iNumPels, Pel *pDstBuf, Int iStrideDst); //horizontal 2:1 downsampling;
@@ -672,7 +890,23 @@ public:
   Int getComponentScaleY(const ComponentID id) const { return (::getComponentScaleY(id, m_chromaFormatIDC));  }
   Pel *getAddr(Int fId, Int compId) { return m_pFacesOrig[fId][compId]; }
   Int getMarginSize(Int bY) { return (bY? m_iMarginY : m_iMarginX); }
+#if SVIDEO_CONVERSION_CACHE
+  Void setPaddingFlag(Bool bFlag) { m_bPadded = bFlag; m_uiFacesStamp++; }
+  Bool getPaddingFlag()           { return m_bPadded; }
+  UInt getFacesStamp()            { return m_uiFacesStamp; }
+  Void getConversionKey(std::vector<UChar> &key, Bool bPadding);
+  Void copyFaces(TGeometry *pGeoSrc, Bool bPadded);
+#else
   Void setPaddingFlag(Bool bFlag) { m_bPadded = bFlag; }
+#endif
+#if SVIDEO_FACE_VIEWS
+  Void enableFaceViews(Int iSrcMargin) { m_iFaceViewSrcMargin = iSrcMargin; }   //the caller guarantees this margin around its source pictures;
+  Bool isFaceView(Int ch) const        { return m_bFaceView[ch]; }
+#endif
+#if SVIDEO_PARALLEL_PROCESSING
+  Int  getNumThreads() const { return m_iNumThreads; }
+  Void setNumThreads(Int iNumThreads) { m_iNumThreads = std::max(1, iNumThreads); }
+#endif
   TChar* getGeoName() 
   {
 #if SVIDEO_HEMI_PROJECTIONS
@@ -712,6 +946,19 @@ public:
   virtual Void clamp(IPos *pIPos);
   virtual Void map2DTo3D(SPos& IPosIn, SPos *pSPosOut) = 0; 
   virtual Void map3DTo2D(SPos *pSPosIn, SPos *pSPosOut) = 0; 
+#if SVIDEO_ROW_PROJECTION
+  // row-at-a-time versions of map2DTo3D(), map3DTo2D() and insideFace(); every geometry that overrides one of the
+  // per-sample functions overrides the row version as well (see xMap2DTo3DRow()), so the row loop binds statically;
+  virtual Void map2DTo3DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum);
+  virtual Void map3DTo2DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum);
+  virtual Void insideFaceRow(Int fId, Int x, Int iStepX, Int y, Int iNum, ComponentID chId, ComponentID origchId, Bool *pbInside);
+#endif
+#if SVIDEO_SEPARABLE_MAPPING
+  // row versions with the memo of the separable terms, pCol gives the column of each sample; the geometries without
+  // separable terms use the plain row versions;
+  virtual Void map2DTo3DRowMemo(SPos *pSPosIn, SPos *pSPosOut, Int iNum, const Int *pCol, SeparableMemo &memo);
+  virtual Void map3DTo2DRowMemo(SPos *pSPosIn, SPos *pSPosOut, Int iNum, const Int *pCol, SeparableMemo &memo);
+#endif
   virtual Void convertYuv(PelUnitBuf *pSrcYuv);
   virtual Void geoConvert(TGeometry *pGeoDst
 #if SVIDEO_ROT_FIX  
@@ -727,6 +974,10 @@ public:
   virtual Void geoToFramePack(IPos* posIn, IPos2D* posOut);
 #if SVIDEO_SPSNR_I
   virtual Pel  getPelValue(ComponentID chId, SPos in);
+#if SVIDEO_SPSNR_I_POINT_MAP
+  Void getPelWeight(ComponentID chId, SPos in, PxlFltLut &wList);                         ///< interpolation record of a position for getPelValues();
+  Void getPelValues(ComponentID chId, const PxlFltLut *pWList, Int iNumPos, Pel *pDst);   ///< getPelValue() of iNumPos precomputed records;
+#endif
 #endif
   virtual Void spherePadding(Bool bEnforced=false);
   virtual Bool insideFace(Int fId, Int x, Int y, ComponentID chId, ComponentID origchId) { return ( x>=0 && x<(m_sVideoInfo.iFaceWidth>>getComponentScaleX(chId)) && y>=0 && y<(m_sVideoInfo.iFaceHeight>>getComponentScaleY(chId)) ); }
@@ -736,6 +987,18 @@ public:
     , Bool bRec=false
 #endif
     );
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+  Bool getFastGeometryMapping() const { return m_bFastGeometryMapping; }
+  Void setFastGeometryMapping(Bool bFast) { m_bFastGeometryMapping = bFast; }
+#if SVIDEO_ROT_FIX
+  Void checkFastGeometryMapping(TGeometry *pGeoSrc, GeoMappingError &err, Bool bRec=false);
+#else
+  Void checkFastGeometryMapping(TGeometry *pGeoSrc, GeoMappingError &err);
+#endif
+#endif
+#if SVIDEO_FRAME_PIPELINE
+  Void shareWeightMaps(TGeometry *pGeoOwner);   ///< use the weight maps pGeoOwner has generated so far; they must outlive this geometry and stay unchanged;
+#endif
 
 #if SVIDEO_TSP_IMP
   virtual Bool insideTspFace(Int fId, Int xx, Int yy, ComponentID chId, ComponentID origchId) { return false; }
@@ -745,6 +1008,7 @@ public:
   Void framePadding(PelUnitBuf *pcPicYuv, Int* aiPad);
   
   static TGeometry* create(SVideoInfo& sVideoInfo, InputGeoParam *pInGeoParam);
+  static Void initSimdOps();
 #if SVIDEO_DYNAMIC_VIEWPORT_PSNR
   Void setGeometryMapping(Bool b)   {m_bGeometryMapping = b;};
 #endif
@@ -0,0 +1,126 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TGeometryKey.cpp
+    \brief    Byte key of the geometry parameters a conversion or a weight map depends on
+*/
+
+#include "TGeometryKey.h"
+
+#if EXTENSION_360_VIDEO
+#if SVIDEO_WEIGHT_MAP_CACHE || SVIDEO_CONVERSION_CACHE
+
+Void TGeometryKey::addKey(const Void *pData, size_t iSize)
+{
+  const UChar *p = (const UChar *) pData;
+  m_key.insert(m_key.end(), p, p + iSize);
+}
+
+// field by field, so that padding bytes never end up in the key;
+Void TGeometryKey::addKey(const SVideoInfo &sVideoInfo)
+{
+  addKey(sVideoInfo.geoType);
+#if SVIDEO_HEMI_PROJECTIONS
+  addKey(sVideoInfo.hemiFlag);
+#endif
+  const SVideoFPStruct &fp = sVideoInfo.framePackStruct;
+  addKey((Int) fp.chromaFormatIDC);
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+  addKey(fp.chromaSampleLocType);
+#endif
+  addKey(fp.rows);
+  addKey(fp.cols);
+  for (Int i = 0; i < fp.rows; i++)
+  {
+    for (Int j = 0; j < fp.cols; j++)
+    {
+      addKey(fp.faces[i][j].id);
+      addKey(fp.faces[i][j].rot);
+      addKey(fp.faces[i][j].width);
+      addKey(fp.faces[i][j].height);
+    }
+  }
+  addKey(sVideoInfo.sVideoRotation.degree, sizeof(sVideoInfo.sVideoRotation.degree));
+  addKey(sVideoInfo.iFaceWidth);
+  addKey(sVideoInfo.iFaceHeight);
+  addKey(sVideoInfo.iNumFaces);
+  addKey(sVideoInfo.viewPort.hFOV);
+  addKey(sVideoInfo.viewPort.vFOV);
+  addKey(sVideoInfo.viewPort.fYaw);
+  addKey(sVideoInfo.viewPort.fPitch);
+  addKey(sVideoInfo.iCompactFPStructure);
+#if SVIDEO_SUB_SPHERE
+  addKey(sVideoInfo.subSphere.iCenterYaw);
+  addKey(sVideoInfo.subSphere.iCenterPitch);
+  addKey(sVideoInfo.subSphere.iYawRange);
+  addKey(sVideoInfo.subSphere.iPitchRange);
+  addKey(sVideoInfo.subSphere.bPresent);
+#endif
+#if SVIDEO_ERP_PADDING
+  addKey(sVideoInfo.bPERP);
+#endif
+#if SVIDEO_HEMI_PROJECTIONS
+  addKey(sVideoInfo.bPCMP);
+#endif
+#if SVIDEO_FISHEYE
+  const FisheyeInfo &fisheye = sVideoInfo.sFisheyeInfo;
+  addKey(fisheye.fCentreAzimuth);
+  addKey(fisheye.fCentreElevation);
+  addKey(fisheye.fCentreTilt);
+  addKey(fisheye.fCircularRegionCentre_x);
+  addKey(fisheye.fCircularRegionCentre_y);
+  addKey(fisheye.fCircularRegionRadius);
+  addKey(fisheye.fFOV);
+  addKey(fisheye.iRectTop);
+  addKey(fisheye.iRectLeft);
+  addKey(fisheye.iRectWidth);
+  addKey(fisheye.iRectHeight);
+#endif
+#if SVIDEO_GENERALIZED_CUBEMAP
+  addKey(sVideoInfo.iGCMPPackingType);
+  addKey(sVideoInfo.iGCMPMappingType);
+  addKey(sVideoInfo.GCMPSettings.fCoeffU, sizeof(sVideoInfo.GCMPSettings.fCoeffU));
+  addKey(sVideoInfo.GCMPSettings.bUAffectedByV, sizeof(sVideoInfo.GCMPSettings.bUAffectedByV));
+  addKey(sVideoInfo.GCMPSettings.fCoeffV, sizeof(sVideoInfo.GCMPSettings.fCoeffV));
+  addKey(sVideoInfo.GCMPSettings.bVAffectedByU, sizeof(sVideoInfo.GCMPSettings.bVAffectedByU));
+  addKey(sVideoInfo.bPGCMP);
+#if SVIDEO_GCMP_PADDING_TYPE
+  addKey(sVideoInfo.iPGCMPPaddingType);
+#endif
+  addKey(sVideoInfo.bPGCMPBoundary);
+  addKey(sVideoInfo.iPGCMPSize);
+#endif
+}
+
+#endif
+#endif
@@ -40,6 +40,9 @@
 #include <map>
 #include "TViewPort.h"
 #include "THCMP.h"
+#if SVIDEO_WEIGHT_MAP_CACHE
+#include "TWeightMapCache.h"
+#endif
 
 #if EXTENSION_360_VIDEO
 #if SVIDEO_HEMI_PROJECTIONS
@@ -344,6 +347,24 @@ Void THCMP::map3DTo2D(SPos *pSPosIn, SPos *pSPosOut)
   }
 }
 
+#if SVIDEO_ROW_PROJECTION
+Void THCMP::map2DTo3DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap2DTo3DRow(this, pSPosIn, pSPosOut, iNum);
+}
+
+Void THCMP::map3DTo2DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap3DTo2DRow(this, pSPosIn, pSPosOut, iNum);
+}
+
+Void THCMP::insideFaceRow(Int fId, Int x, Int iStepX, Int y, Int iNum, ComponentID chId, ComponentID origchId,
+                               Bool *pbInside)
+{
+  xInsideFaceRow(this, fId, x, iStepX, y, iNum, chId, origchId, pbInside);
+}
+#endif
+
 Void THCMP::sPad(Pel *pSrc0, Int iHStep0, Int iStrideSrc0, Pel* pSrc1, Int iHStep1, Int iStrideSrc1, Int iNumSamples, Int hCnt, Int vCnt)
 {
   Pel *pSrc0Start = pSrc0 + iHStep0;
@@ -579,21 +600,7 @@ Void THCMP::geometryMapping(TGeometry *pGeoSrc)
   Int iNumMaps = (m_chromaFormatIDC == ChromaFormat::_400 || (m_chromaFormatIDC == ChromaFormat::_444 && m_InterpolationType[0] == m_InterpolationType[1])) ? 1 : 2;
 #if SVIDEO_ROT_FIX
   Int pRot[3];
-  Void(TGeometry::*pfuncRotation)(SPos& sPos, Int iRoll, Int iPitch, Int iYaw) = nullptr;
-  if (bRec)
-  {
-    pfuncRotation = &TGeometry::invRotate3D;
-    pRot[0] = -pGeoSrc->m_sVideoInfo.sVideoRotation.degree[0];
-    pRot[1] = -pGeoSrc->m_sVideoInfo.sVideoRotation.degree[1];
-    pRot[2] = -pGeoSrc->m_sVideoInfo.sVideoRotation.degree[2];
-  }
-  else
-  {
-    pfuncRotation = &TGeometry::rotate3D;
-    pRot[0] = m_sVideoInfo.sVideoRotation.degree[0];
-    pRot[1] = m_sVideoInfo.sVideoRotation.degree[1];
-    pRot[2] = m_sVideoInfo.sVideoRotation.degree[2];
-  }
+  RotationFunc pfuncRotation = xGetMappingRotation(pGeoSrc, bRec, pRot);
 #else
   Int *pRot = m_sVideoInfo.sVideoRotation.degree;
 #endif
@@ -605,6 +612,19 @@ Void THCMP::geometryMapping(TGeometry *pGeoSrc)
 #endif
     m_bConvOutputPaddingNeeded = true;
 
+#if SVIDEO_WEIGHT_MAP_CACHE
+  TWeightMapCache wmCache(m_sWeightMapCacheDir, m_iWeightMapCacheMaxMB);
+  if (wmCache.isEnabled())
+  {
+    wmCache.addKey(Int(0));   //0: conversion map; 1: sphere padding map;
+    xAddWeightMapCacheKey(wmCache);
+    pGeoSrc->xAddWeightMapCacheKey(wmCache);
+#if SVIDEO_ROT_FIX
+    wmCache.addKey(bRec);
+#endif
+    wmCache.addKey(pRot, 3 * sizeof(Int));
+  }
+#endif
   for (Int fIdx = 0; fIdx<m_sVideoInfo.iNumFaces; fIdx++)
   {
     for (Int ch = 0; ch<iNumMaps; ch++)
@@ -617,6 +637,9 @@ Void THCMP::geometryMapping(TGeometry *pGeoSrc)
       {
         m_pPixelWeight[fIdx][ch] = new PxlFltLut[iWidthPW*iHeightPW];
       }
+#if SVIDEO_WEIGHT_MAP_CACHE
+      wmCache.addMap(m_pPixelWeight[fIdx][ch], (int64_t)iWidthPW*iHeightPW);
+#endif
     }
   }
 
@@ -626,7 +649,17 @@ Void THCMP::geometryMapping(TGeometry *pGeoSrc)
     ((TViewPort*)this)->setRotMat();
     ((TViewPort*)this)->setInvK();
   }
+#if SVIDEO_WEIGHT_MAP_CACHE
+  if (wmCache.load())
+  {
+    m_bGeometryMapping = true;
+    return;
+  }
+#endif
   //generate the map;
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+  TFastMath::Scope fastMath(m_bFastGeometryMapping);
+#endif
   int div = 2;
   //int min_shift = 1;
 
@@ -728,6 +761,9 @@ Void THCMP::geometryMapping(TGeometry *pGeoSrc)
           }
       }
     }
+#if SVIDEO_WEIGHT_MAP_CACHE
+  wmCache.store();
+#endif
   m_bGeometryMapping = true;
 
 }
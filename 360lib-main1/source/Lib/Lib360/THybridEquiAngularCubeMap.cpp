@@ -59,15 +59,12 @@ THybridEquiAngularCubeMap::~THybridEquiAngularCubeMap()
 #if SVIDEO_HEC_PADDING && SVIDEO_HEC_PADDING_TYPE == 1
   for(int i = 0; i < 2; i++)
   {
-    if(m_blendingMap[i])
+    for(int j = 0; j < 6; j++)
     {
-      for(int j = 0; j < 6; j++)
+      if(m_blendingMap[i][j])
       {
-        if(m_blendingMap[i][j])
-        {
-          delete[] m_blendingMap[i][j];
-          m_blendingMap[i][j] = nullptr;
-        }
+        delete[] m_blendingMap[i][j];
+        m_blendingMap[i][j] = nullptr;
       }
     }
   }
@@ -213,6 +210,18 @@ Void THybridEquiAngularCubeMap::map3DTo2D(SPos *pSPosIn, SPos *pSPosOut)
   pSPosOut->y = (POSType)((pv+1.0)*(m_sVideoInfo.iFaceHeight>>1)+ (-0.5));
 }
 
+#if SVIDEO_ROW_PROJECTION
+Void THybridEquiAngularCubeMap::map2DTo3DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap2DTo3DRow(this, pSPosIn, pSPosOut, iNum);
+}
+
+Void THybridEquiAngularCubeMap::map3DTo2DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap3DTo2DRow(this, pSPosIn, pSPosOut, iNum);
+}
+#endif
+
 #if SVIDEO_HEC_PADDING
 #if SVIDEO_HEC_PADDING_TYPE == 1
 Void THybridEquiAngularCubeMap::FaceScaling2DTo3D(POSType& pu, POSType& pv, Int faceIdx)
@@ -578,6 +587,9 @@ Void THybridEquiAngularCubeMap::mapFaceToPadding(SPos& IPosIn, SPos *pSPosOut)
 
 Void THybridEquiAngularCubeMap::geometryMapping4Blending()
 {
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+  TFastMath::Scope fastMath(m_bFastGeometryMapping);
+#endif
   Int iNumMaps = (m_chromaFormatIDC==ChromaFormat::_400 || (m_chromaFormatIDC==ChromaFormat::_444 && m_InterpolationType[0]==m_InterpolationType[1]))? 1 : 2;
   for(Int ch=0; ch<iNumMaps; ch++)
   {
@@ -687,6 +699,9 @@ Void THybridEquiAngularCubeMap::convertYuv(PelUnitBuf *pSrcYuv)
       Int iWLutIdx = (m_chromaFormatIDC==ChromaFormat::_400 || (m_InterpolationType[0]==m_InterpolationType[1]))? 0 : Int(chType);
       Int *pWLut = m_pWeightLut[iWLutIdx][pPelWeight.weightIdx];
       Pel *pPelLine = m_pFacesOrig[face][ch] +iTLPos -((m_iInterpFilterTaps[Int(chType)][1]-1)>>1)*getStride(chId) -((m_iInterpFilterTaps[Int(chType)][0]-1)>>1);
+#if SVIDEO_INTERP_KERNELS
+      sum = g_interp360OP.filter2D[m_iInterpFilterTaps[Int(chType)][0]](pPelLine, getStride(chId), pWLut);
+#else
       for(Int m=0; m<m_iInterpFilterTaps[Int(chType)][1]; m++)
       {
         for(Int n=0; n<m_iInterpFilterTaps[Int(chType)][0]; n++)
@@ -694,6 +709,7 @@ Void THybridEquiAngularCubeMap::convertYuv(PelUnitBuf *pSrcYuv)
         pPelLine += getStride(chId);
         pWLut += m_iInterpFilterTaps[Int(chType)][0];
       }
+#endif
 
       Pel pCorrPxlVal = ClipBD((sum + iOffset)>>iBDPrecision, m_nBitDepth);
       bldPxl.value = (Pel)((pCorrPxlVal*(bldPxl.blendingWidth-bldPxl.dist) + m_pFacesOrig[bldPxl.faceIdx][ch][bldPxl.y*getStride(chId)+bldPxl.x]*bldPxl.dist) / bldPxl.blendingWidth + 0.5);
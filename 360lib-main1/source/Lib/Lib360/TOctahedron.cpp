@@ -37,6 +37,9 @@
 
 #include <math.h>
 #include "TOctahedron.h"
+#if SVIDEO_COMPACT_COPY_PLAN
+#include "TThreadPool.h"
+#endif
 
 #if EXTENSION_360_VIDEO
 
@@ -261,6 +264,24 @@ Void TOctahedron::map3DTo2D(SPos *pSPosIn, SPos *pSPosOut)
   pSPosOut->y = (POSType)(pv*(m_sVideoInfo.iFaceHeight)/ssqrt(3.0f)+ (-0.5));
 }
 
+#if SVIDEO_ROW_PROJECTION
+Void TOctahedron::map2DTo3DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap2DTo3DRow(this, pSPosIn, pSPosOut, iNum);
+}
+
+Void TOctahedron::map3DTo2DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap3DTo2DRow(this, pSPosIn, pSPosOut, iNum);
+}
+
+Void TOctahedron::insideFaceRow(Int fId, Int x, Int iStepX, Int y, Int iNum, ComponentID chId, ComponentID origchId,
+                                     Bool *pbInside)
+{
+  xInsideFaceRow(this, fId, x, iStepX, y, iNum, chId, origchId, pbInside);
+}
+#endif
+
 Void TOctahedron::clamp(IPos *pIPos)
 {
   Int x = pIPos->u;
@@ -2578,6 +2599,116 @@ Void TOctahedron::compactFramePackType2(PelUnitBuf *pDstYuv)
 }
 
 // rot is defined in the clock-wise rotation manner
+#if SVIDEO_COMPACT_COPY_PLAN
+// the samples of loop row iRow of triangleFaceCopy() that are inside the face, as runs; same inside tests and loop order as the per-sample copy;
+const TriangleCopyPlan& TOctahedron::xGetTriangleCopyPlan(Int iFaceWidth, Int iFaceHeight, Int iStartHorPos, Int iEndHorPos, Int iStartVerPos, Int iEndVerPos, ComponentID chId, Int rot, FaceFlipType eFaceFlipType, Int face)
+{
+  std::array<Int, 10> key = { { iFaceWidth, iFaceHeight, iStartHorPos, iEndHorPos, iStartVerPos, iEndVerPos, (Int)chId, rot, (Int)eFaceFlipType, face } };
+  auto it = m_triangleCopyPlans.find(key);
+  if(it != m_triangleCopyPlans.end())
+  {
+    return it->second;
+  }
+
+  Int iScaleX    = getComponentScaleX(chId);
+  Int iScaleY    = getComponentScaleY(chId);
+  Int iWidthSrc  = iEndHorPos - iStartHorPos + 1;
+  Int iHeightSrc = iEndVerPos - iStartVerPos + 1;
+  Int iNumRows   = 0;
+  Int iRowLength = 0;
+  if(!rot || rot == 180)
+  {
+    iNumRows   = iHeightSrc;
+    iRowLength = iWidthSrc;
+  }
+#if SVIDEO_MTK_MODIFIED_COHP1
+  else if((rot == 90 || rot == 270) && eFaceFlipType == FACE_NO_FLIP)
+  {
+    iNumRows   = iWidthSrc;
+    iRowLength = iHeightSrc;
+  }
+#endif
+
+  TriangleCopyPlan &plan = m_triangleCopyPlans[key];
+  for(Int r = 0; r < iNumRows; r++)
+  {
+    if(!(r % S_PARALLEL_ROW_BAND))
+    {
+      plan.bandStart.push_back((Int)plan.spans.size());
+    }
+    Int iRunStart = -1;
+    for(Int s = 0; s <= iRowLength; s++)
+    {
+      Bool bInside = false;
+      if(s < iRowLength)
+      {
+        Int x = 0, y = 0;
+        Bool bValid = true;
+        if(!rot)
+        {
+          x = eFaceFlipType == FACE_HOR_FLIP ? iFaceWidth - 1 - (iStartHorPos + s) : iStartHorPos + s;
+          y = eFaceFlipType == FACE_VER_FLIP ? iFaceHeight - 1 - (iStartVerPos + r) : iStartVerPos + r;
+          bValid = eFaceFlipType == FACE_NO_FLIP || eFaceFlipType == FACE_HOR_FLIP || eFaceFlipType == FACE_VER_FLIP;
+        }
+        else if(rot == 180)
+        {
+          x = eFaceFlipType == FACE_HOR_FLIP ? iStartHorPos + s : iFaceWidth - 1 - (iStartHorPos + s);
+          y = eFaceFlipType == FACE_VER_FLIP ? iStartVerPos + r : iFaceHeight - 1 - (iStartVerPos + r);
+          bValid = eFaceFlipType == FACE_NO_FLIP || eFaceFlipType == FACE_HOR_FLIP || eFaceFlipType == FACE_VER_FLIP;
+        }
+        else if(rot == 90)
+        {
+          x = iStartHorPos + r;
+          y = iStartVerPos + iHeightSrc - 1 - s;
+        }
+        else
+        {
+          x = iStartHorPos + iWidthSrc - 1 - r;
+          y = iStartVerPos + s;
+        }
+        bInside = bValid && insideFace(face, x << iScaleX, y << iScaleY, COMPONENT_Y, chId);
+      }
+      if(bInside && iRunStart < 0)
+      {
+        iRunStart = s;
+      }
+      else if(!bInside && iRunStart >= 0)
+      {
+        TriangleCopySpan span = { r, iRunStart, s - iRunStart };
+        plan.spans.push_back(span);
+        iRunStart = -1;
+      }
+    }
+  }
+  plan.bandStart.push_back((Int)plan.spans.size());
+  return plan;
+}
+
+Void TOctahedron::triangleFaceCopy(Int iFaceWidth, Int iFaceHeight, Pel *pSrcBuf, Int iStartHorPos, Int iEndHorPos, Int iStartVerPos, Int iEndVerPos, Int iStrideSrc, Pel *pDstBuf, Int iStrideDst, ComponentID chId, Int rot, FaceFlipType eFaceFlipType, Int face, Int iBDAdjust, Int iMaxBD)
+{
+  CHECK(iBDAdjust <0, "");
+#if SVIDEO_MTK_MODIFIED_COHP1
+  CHECK((rot == 90 || rot == 270) && eFaceFlipType != FACE_NO_FLIP, "");
+#else
+  assert(rot == 0 || rot == 180);
+#endif
+  Int iOffset = iBDAdjust>0? (1<<(iBDAdjust-1)) : 0;
+  const TriangleCopyPlan &plan = xGetTriangleCopyPlan(iFaceWidth, iFaceHeight, iStartHorPos, iEndHorPos, iStartVerPos, iEndVerPos, chId, rot, eFaceFlipType, face);
+
+  TThreadPool::runTasks(m_iNumThreads, (Int)plan.bandStart.size() - 1, [&](Int iBand) {
+    for(Int n = plan.bandStart[iBand]; n < plan.bandStart[iBand + 1]; n++)
+    {
+      const TriangleCopySpan &span = plan.spans[n];
+      const Pel *pSrc = pSrcBuf + span.iRow * iStrideSrc + span.iStart;
+      Pel *pDst = pDstBuf + span.iRow * iStrideDst + span.iStart;
+      for(Int i = 0; i < span.iLength; i++)
+      {
+        pDst[i] = ClipBD((pSrc[i] + iOffset) >> iBDAdjust, iMaxBD);
+      }
+    }
+  });
+}
+#else
 Void TOctahedron::triangleFaceCopy(Int iFaceWidth, Int iFaceHeight, Pel *pSrcBuf, Int iStartHorPos, Int iEndHorPos, Int iStartVerPos, Int iEndVerPos, Int iStrideSrc, Pel *pDstBuf, Int iStrideDst, ComponentID chId, Int rot, FaceFlipType eFaceFlipType, Int face, Int iBDAdjust, Int iMaxBD)
 {
   CHECK(iBDAdjust <0, "");
@@ -2716,6 +2847,7 @@ Void TOctahedron::triangleFaceCopy(Int iFaceWidth, Int iFaceHeight, Pel *pSrcBuf
   }
 #endif
 }
+#endif
 
 Void TOctahedron::rotFlipFaceChannelGeneral(Pel *pSrcBuf, Int iWidthSrc, Int iHeightSrc, Int iStrideSrc, Pel *pDstBuf, Int iStrideDst, Int rot, Bool bInverse, FaceFlipType eFaceFlipType)
 {
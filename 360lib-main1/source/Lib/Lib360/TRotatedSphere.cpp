@@ -109,11 +109,17 @@ static Void sPadH(Pel *pSrc, Pel *pDst, Int iCount, Int iVCnt, Int iStride)
 {
     for (Int j = 0; j < iVCnt; j++)
     {
+#if SVIDEO_PADDING_GATHER_TABLE
+        //pSrc and pDst are in different faces;
+        memcpy(pDst, pSrc, iCount * sizeof(Pel));
+        memcpy(pSrc - iCount, pDst - iCount, iCount * sizeof(Pel));
+#else
         for (Int i = 1; i <= iCount; i++)
         {
             pDst[i - 1] = pSrc[i - 1];
             pSrc[-i] = pDst[-i];
         }
+#endif
         pSrc += iStride;
         pDst += iStride;
     }
@@ -314,6 +320,24 @@ Void TRotatedSphere::map3DTo2D(SPos *pSPosIn, SPos *pSPosOut)
     setOutput3DPos( back_face ? rot_yaw : org_yaw, back_face ? rot_pitch: org_pitch, faceIdx, face_size, pSPosOut );
 }
 
+#if SVIDEO_ROW_PROJECTION
+Void TRotatedSphere::map2DTo3DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap2DTo3DRow(this, pSPosIn, pSPosOut, iNum);
+}
+
+Void TRotatedSphere::map3DTo2DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap3DTo2DRow(this, pSPosIn, pSPosOut, iNum);
+}
+
+Void TRotatedSphere::insideFaceRow(Int fId, Int x, Int iStepX, Int y, Int iNum, ComponentID chId, ComponentID origchId,
+                                        Bool *pbInside)
+{
+  xInsideFaceRow(this, fId, x, iStepX, y, iNum, chId, origchId, pbInside);
+}
+#endif
+
 Void TRotatedSphere::convertYuv(PelUnitBuf *pSrcYuv)
 {
     Int nWidth = m_sVideoInfo.iFaceWidth;
@@ -54,6 +54,14 @@ TSPSNRMetric::TSPSNRMetric()
 , m_pSamplePosCTable(nullptr)
 , m_pSamplePosCRecTable(nullptr)
 #endif
+#if SVIDEO_CONVERSION_CACHE
+, m_pcConversionCache(nullptr)
+#endif
+#if SVIDEO_SPSNR_NN_POINT_LIST
+, m_iPointListWidth(0)
+, m_iPointListHeight(0)
+, m_pointListChromaFormat(ChromaFormat::UNDEFINED)
+#endif
 {
   m_dSPSNR[0] = m_dSPSNR[1] = m_dSPSNR[2] = 0;
 }
@@ -179,6 +187,9 @@ void TSPSNRMetric::createTable(TGeometry *pcCodingGeomtry)
   CPos2D In2d;
   CPos3D Out3d;
   SPos posIn, posOut;
+#if SVIDEO_SPSNR_NN_POINT_LIST
+  m_iPointListWidth = 0;
+#endif
   m_fpTable = (IPos2D*)malloc(iNumPoints * sizeof(IPos2D));
 #if SVIDEO_CHROMA_TYPES_SUPPORT
   m_fpTableC = (IPos2D*)malloc(iNumPoints * sizeof(IPos2D));
@@ -222,6 +233,104 @@ void TSPSNRMetric::createTable(TGeometry *pcCodingGeomtry)
     }
 }
 
+#if SVIDEO_SPSNR_NN_POINT_LIST
+#if SVIDEO_FISHEYE
+Bool TSPSNRMetric::xIsFisheyeSubset()
+{
+  return m_refVideoInfo.geoType == SVIDEO_EQUIRECT && m_codingVideoInfo.geoType == SVIDEO_FISHEYE_CIRCULAR;
+}
+#endif
+
+// the point lists only depend on the sphere points and the picture size; they are built for the first picture
+// and kept as long as the size does not change;
+Void TSPSNRMetric::xBuildPointLists(PelUnitBuf& cPicD)
+{
+  Int iNumPoints = m_iSphNumPoints;
+#if SVIDEO_FISHEYE
+  Bool bFisheye = xIsFisheyeSubset();
+
+  // for fisheye center
+  Double  max_angle_rad = m_codingVideoInfo.sFisheyeInfo.fFOV / SVIDEO_ROT_PRECISION / 2.0 * S_PI / 180.0;
+
+  Double  ctr_yaw = m_codingVideoInfo.sFisheyeInfo.fCentreAzimuth / SVIDEO_ROT_PRECISION * S_PI / 180;
+  Double  ctr_pitch = -m_codingVideoInfo.sFisheyeInfo.fCentreElevation / SVIDEO_ROT_PRECISION * S_PI / 180;
+
+  // ERP 2D to 3D mapping
+  Double  ctr_sphere_x = bFisheye ? scos(ctr_pitch)*scos(ctr_yaw) : 0;
+  Double  ctr_sphere_y = bFisheye ? ssin(ctr_pitch) : 0;
+  Double  ctr_sphere_z = bFisheye ? -scos(ctr_pitch)*ssin(ctr_yaw) : 0;
+
+  Double  ctr_norm = ssqrt(ctr_sphere_x*ctr_sphere_x + ctr_sphere_y*ctr_sphere_y + ctr_sphere_z*ctr_sphere_z);
+#endif
+
+  for (Int chType = 0; chType < (Int)getNumberValidChannels(cPicD.chromaFormat); chType++)
+  {
+    const ComponentID ch = chType ? COMPONENT_Cb : COMPONENT_Y;
+    std::vector<Int> &pointListX = m_pointListX[chType];
+    std::vector<Int> &pointListY = m_pointListY[chType];
+    pointListX.clear();
+    pointListY.clear();
+    pointListX.reserve(iNumPoints);
+    pointListY.reserve(iNumPoints);
+#if SVIDEO_FISHEYE
+    Int iWidth = cPicD.get(ch).width << ::getComponentScaleX(ch, cPicD.chromaFormat);
+    Int iHeight = cPicD.get(ch).height << ::getComponentScaleY(ch, cPicD.chromaFormat);
+#endif
+    for (Int np = 0; np < iNumPoints; np++)
+    {
+      Int x_loc, y_loc;
+      if (!chType)
+      {
+        x_loc = (Int)(m_fpTable[np].x);
+        y_loc = (Int)(m_fpTable[np].y);
+      }
+      else
+      {
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+        x_loc = Int(m_fpTableC[np].x);
+        y_loc = Int(m_fpTableC[np].y);
+#else
+        x_loc = Int(m_fpTable[np].x >> ::getComponentScaleX(COMPONENT_Cb, cPicD.chromaFormat));
+        y_loc = Int(m_fpTable[np].y >> ::getComponentScaleY(COMPONENT_Cb, cPicD.chromaFormat));
+#endif
+      }
+#if SVIDEO_FISHEYE
+      if (bFisheye)
+      {
+        // for this position
+        Int    xx = x_loc << ::getComponentScaleX(ch, cPicD.chromaFormat);
+        Int    yy = y_loc << ::getComponentScaleY(ch, cPicD.chromaFormat);
+
+        Double  yaw = ((xx + 0.5) / iWidth - 0.5) * 2 * S_PI;
+        Double  pitch = ((yy + 0.5) / iHeight - 0.5) * -S_PI;
+
+        // ERP 2D to 3D mapping
+        Double  sphere_x = scos(pitch)*scos(yaw);
+        Double  sphere_y = ssin(pitch);
+        Double  sphere_z = -scos(pitch)*ssin(yaw);
+
+        Double  norm = ssqrt(sphere_x*sphere_x + sphere_y*sphere_y + sphere_z*sphere_z);
+
+        // theta
+        Double  innerProduct = sphere_x*ctr_sphere_x + sphere_y*ctr_sphere_y + sphere_z*ctr_sphere_z;
+        Double  theta_rad = acos(innerProduct / (norm * ctr_norm));
+
+        if (!(theta_rad < max_angle_rad))
+        {
+          continue;
+        }
+      }
+#endif
+      pointListX.push_back(x_loc);
+      pointListY.push_back(y_loc);
+    }
+  }
+  m_iPointListWidth       = cPicD.get(COMPONENT_Y).width;
+  m_iPointListHeight      = cPicD.get(COMPONENT_Y).height;
+  m_pointListChromaFormat = cPicD.chromaFormat;
+}
+#endif
+
 Void TSPSNRMetric::xCalculateSPSNR(PelUnitBuf& cOrgPicYuv, PelUnitBuf& cPicD)
 {
   Int iNumPoints = m_iSphNumPoints;
@@ -241,6 +350,37 @@ Void TSPSNRMetric::xCalculateSPSNR(PelUnitBuf& cOrgPicYuv, PelUnitBuf& cPicD)
 #if SVIDEO_FISHEYE  
   Int num_subset[3] = { 0, 0, 0 };
 #endif
+#if SVIDEO_SPSNR_NN_POINT_LIST
+  if (m_iPointListWidth != cPicD.get(COMPONENT_Y).width || m_iPointListHeight != cPicD.get(COMPONENT_Y).height || m_pointListChromaFormat != cPicD.chromaFormat)
+  {
+    xBuildPointLists(cPicD);
+  }
+  for (Int chan = 0; chan<getNumberValidComponents(cPicD.chromaFormat); chan++)
+  {
+    const ComponentID ch = ComponentID(chan);
+    const Int   chType = Int(toChannelType(ch));
+    const Pel*  pOrg = cOrgPicYuv.get(ch).bufAt(0, 0);
+    const Int   iOrgStride = (Int)cOrgPicYuv.get(ch).stride;
+    const Pel*  pRec = cPicD.get(ch).bufAt(0, 0);
+    const Int   iRecStride = (Int)cPicD.get(ch).stride;
+    const Int*  pX = m_pointListX[chType].data();
+    const Int*  pY = m_pointListY[chType].data();
+    const Int   iNumListPoints = (Int)m_pointListX[chType].size();
+    const Int   iRefShift = iReferenceBitShift[chType];
+    const Int   iOutShift = iOutputBitShift[chType];
+    // integer sum: exact, and equal to the former sum in Double as long as it stays below 2^53;
+    int64_t iSSD = 0;
+    for (Int i = 0; i < iNumListPoints; i++)
+    {
+      Intermediate_Int iDifflp = (pOrg[pX[i] + pY[i]*iOrgStride] << iRefShift) - (pRec[pX[i] + pY[i]*iRecStride] << iOutShift);
+      iSSD += iDifflp*iDifflp;
+    }
+    SSDspsnr[chan] = (Double)iSSD;
+#if SVIDEO_FISHEYE
+    num_subset[chan] = iNumListPoints;
+#endif
+  }
+#else
   for (Int chan = 0; chan<getNumberValidComponents(cPicD.chromaFormat); chan++)
   {
     const ComponentID ch = ComponentID(chan);
@@ -368,6 +508,8 @@ Void TSPSNRMetric::xCalculateSPSNR(PelUnitBuf& cOrgPicYuv, PelUnitBuf& cPicD)
     }
   }
 
+#endif
+
   for (Int ch_indx = 0; ch_indx < getNumberValidComponents(cPicD.chromaFormat); ch_indx++)
   {
     const ComponentID ch = ComponentID(ch_indx);
@@ -589,6 +731,11 @@ Void TSPSNRMetric::xCalculateCFSPSNR( PelUnitBuf *pcOrigPicYuv, PelUnitBuf* pcRe
   pcCodingGeometry = m_pcCodingGeometry;
   pcRefGeometry = m_pcRefGeometry;
 
+#if SVIDEO_CONVERSION_CACHE
+  if (m_pcConversionCache)
+    m_pcConversionCache->convertYuv(pcCodingGeometry, pcRecPicYuv);
+  else
+#endif
   if((pcCodingGeometry->getSVideoInfo()->geoType == SVIDEO_OCTAHEDRON || pcCodingGeometry->getSVideoInfo()->geoType == SVIDEO_ICOSAHEDRON) && pcCodingGeometry->getSVideoInfo()->iCompactFPStructure) 
   {
     pcCodingGeometry->compactFramePackConvertYuv(pcRecPicYuv);
@@ -597,8 +744,18 @@ Void TSPSNRMetric::xCalculateCFSPSNR( PelUnitBuf *pcOrigPicYuv, PelUnitBuf* pcRe
   {
     pcCodingGeometry->convertYuv(pcRecPicYuv);
   }
+#if SVIDEO_CONVERSION_CACHE
+  if (m_pcConversionCache)
+    m_pcConversionCache->spherePadding(pcCodingGeometry);
+  else
+#endif
   pcCodingGeometry->spherePadding(true);
 
+#if SVIDEO_CONVERSION_CACHE
+  if (m_pcConversionCache)
+    m_pcConversionCache->convertYuv(pcRefGeometry, pcOrigPicYuv);
+  else
+#endif
   if((pcRefGeometry->getSVideoInfo()->geoType == SVIDEO_OCTAHEDRON || pcRefGeometry->getSVideoInfo()->geoType == SVIDEO_ICOSAHEDRON) && pcRefGeometry->getSVideoInfo()->iCompactFPStructure) 
   {
     pcRefGeometry->compactFramePackConvertYuv(pcOrigPicYuv);
@@ -607,6 +764,11 @@ Void TSPSNRMetric::xCalculateCFSPSNR( PelUnitBuf *pcOrigPicYuv, PelUnitBuf* pcRe
   {
     pcRefGeometry->convertYuv(pcOrigPicYuv);
   }
+#if SVIDEO_CONVERSION_CACHE
+  if (m_pcConversionCache)
+    m_pcConversionCache->spherePadding(pcRefGeometry);
+  else
+#endif
   pcRefGeometry->spherePadding(true);
   
   for(Int chan=0; chan<getNumberValidComponents(pcRecPicYuv->chromaFormat); chan++)
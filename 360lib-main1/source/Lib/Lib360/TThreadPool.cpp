@@ -0,0 +1,199 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TThreadPool.cpp
+    \brief    Worker pool for the data-parallel loops of the 360 library
+*/
+
+#include "TThreadPool.h"
+
+#include <algorithm>
+
+#if EXTENSION_360_VIDEO
+#if SVIDEO_PARALLEL_PROCESSING
+
+TThreadPool::TThreadPool(Int iNumThreads)
+  : m_iNumWorkers(0)
+  , m_bExit(false)
+{
+  addThreads(iNumThreads - 1);
+}
+
+TThreadPool::~TThreadPool()
+{
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_bExit = true;
+  }
+  m_cvJob.notify_all();
+  for (auto &t: m_workers)
+  {
+    t.join();
+  }
+  m_workers.clear();
+  m_iNumWorkers = 0;
+}
+
+Void TThreadPool::addThreads(Int iNumThreads)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  for (Int i = 0; i < iNumThreads; i++)
+  {
+    m_workers.emplace_back(&TThreadPool::xWorkerLoop, this);
+  }
+  m_iNumWorkers = (Int)m_workers.size();
+}
+
+Bool TThreadPool::xRunTasks(Job& job)
+{
+  Bool bLastDone = false;
+  Int  iTask;
+  while ((iTask = job.iNextTask.fetch_add(1)) < job.iNumTasks)
+  {
+    (*job.pFunc)(iTask);
+    bLastDone = (job.iDoneTasks.fetch_add(1) + 1 == job.iNumTasks);
+  }
+  return bLastDone;
+}
+
+Void TThreadPool::xWorkerLoop()
+{
+  while (true)
+  {
+    std::shared_ptr<Job> pJob;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cvJob.wait(lock, [this] { return m_bExit || !m_jobQueue.empty(); });
+      if (m_bExit)
+      {
+        return;
+      }
+      pJob = m_jobQueue.front();
+      pJob->iNumHelpers++;
+      if (pJob->iNumHelpers >= pJob->iMaxHelpers || pJob->iNextTask.load() >= pJob->iNumTasks - 1)
+      {
+        // the job has all the workers it may use, or the remaining task (if any) is claimed by this worker;
+        // nobody else needs to see the job;
+        m_jobQueue.pop_front();
+      }
+    }
+    if (xRunTasks(*pJob))
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cvDone.notify_all();
+    }
+  }
+}
+
+Void TThreadPool::parallelFor(Int iNumTasks, const std::function<Void(Int)>& func, Int iMaxThreads)
+{
+  if (iNumTasks <= 0)
+  {
+    return;
+  }
+  Int iMaxHelpers = std::min(m_iNumWorkers.load(), iNumTasks - 1);
+  if (iMaxThreads > 0)
+  {
+    iMaxHelpers = std::min(iMaxHelpers, iMaxThreads - 1);
+  }
+  if (iMaxHelpers <= 0)
+  {
+    for (Int i = 0; i < iNumTasks; i++)
+    {
+      func(i);
+    }
+    return;
+  }
+
+  std::shared_ptr<Job> pJob = std::make_shared<Job>();
+  pJob->pFunc      = &func;
+  pJob->iNumTasks  = iNumTasks;
+  pJob->iMaxHelpers = iMaxHelpers;
+  pJob->iNumHelpers = 0;
+  pJob->iNextTask  = 0;
+  pJob->iDoneTasks = 0;
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_jobQueue.push_back(pJob);
+  }
+  m_cvJob.notify_all();
+
+  // the caller works on its own job as well;
+  xRunTasks(*pJob);
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  for (auto it = m_jobQueue.begin(); it != m_jobQueue.end(); it++)
+  {
+    if (*it == pJob)
+    {
+      m_jobQueue.erase(it);
+      break;
+    }
+  }
+  m_cvDone.wait(lock, [&pJob] { return pJob->iDoneTasks.load() == pJob->iNumTasks; });
+}
+
+TThreadPool* TThreadPool::getSharedPool(Int iNumThreads)
+{
+  static std::mutex                   s_mutex;
+  static std::unique_ptr<TThreadPool> s_pPool;
+
+  std::unique_lock<std::mutex> lock(s_mutex);
+  if (!s_pPool)
+  {
+    s_pPool.reset(new TThreadPool(iNumThreads));
+  }
+  else if (s_pPool->getNumThreads() < iNumThreads)
+  {
+    s_pPool->addThreads(iNumThreads - s_pPool->getNumThreads());
+  }
+  return s_pPool.get();
+}
+
+Void TThreadPool::runTasks(Int iNumThreads, Int iNumTasks, const std::function<Void(Int)>& func)
+{
+  if (iNumThreads <= 1)
+  {
+    for (Int i = 0; i < iNumTasks; i++)
+    {
+      func(i);
+    }
+  }
+  else
+  {
+    getSharedPool(iNumThreads)->parallelFor(iNumTasks, func, iNumThreads);
+  }
+}
+
+#endif
+#endif
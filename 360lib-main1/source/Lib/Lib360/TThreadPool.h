@@ -0,0 +1,98 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TThreadPool.h
+    \brief    Worker pool for the data-parallel loops of the 360 library (header)
+*/
+
+#ifndef __TTHREADPOOL__
+#define __TTHREADPOOL__
+#include "TGeometry.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+#if EXTENSION_360_VIDEO
+#if SVIDEO_PARALLEL_PROCESSING
+
+/// Fork/join pool: parallelFor() hands out task indices to the workers and to the calling thread;
+/// since the caller keeps claiming tasks until none is left, nested calls from inside a task never dead-lock.
+class TThreadPool
+{
+private:
+  struct Job
+  {
+    const std::function<Void(Int)>* pFunc;
+    Int              iNumTasks;
+    Int              iMaxHelpers;     ///< workers allowed to join the caller;
+    Int              iNumHelpers;     ///< workers joined so far, guarded by m_mutex;
+    std::atomic<Int> iNextTask;
+    std::atomic<Int> iDoneTasks;
+  };
+
+  std::vector<std::thread>          m_workers;
+  std::atomic<Int>                  m_iNumWorkers;
+  std::deque<std::shared_ptr<Job>>  m_jobQueue;
+  std::mutex                        m_mutex;
+  std::condition_variable           m_cvJob;
+  std::condition_variable           m_cvDone;
+  Bool                              m_bExit;
+
+  Void xWorkerLoop();
+  Bool xRunTasks(Job& job);
+
+public:
+  TThreadPool(Int iNumThreads);
+  virtual ~TThreadPool();
+
+  Int  getNumThreads() const { return m_iNumWorkers.load() + 1; }
+  Void addThreads(Int iNumThreads);
+  Void parallelFor(Int iNumTasks, const std::function<Void(Int)>& func, Int iMaxThreads = 0);   ///< iMaxThreads: threads of the loop including the caller; 0: all;
+
+  static TThreadPool* getSharedPool(Int iNumThreads);   ///< process wide pool, grown to the largest requested size; callers limit their loops to their own size;
+  static Void runTasks(Int iNumThreads, Int iNumTasks, const std::function<Void(Int)>& func);
+};
+
+#endif
+#endif
+#endif // __TTHREADPOOL__
@@ -0,0 +1,250 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TViewPortRenderer.cpp
+    \brief    Batch rendering of many viewports from one 360 picture
+*/
+
+#include "TViewPortRenderer.h"
+#if SVIDEO_PARALLEL_PROCESSING
+#include "TThreadPool.h"
+#endif
+
+#if EXTENSION_360_VIDEO
+#if SVIDEO_VIEWPORT_RENDERER
+
+TViewPortRenderer::TViewPortRenderer()
+  : m_iCacheSize(0)
+  , m_pGeoSrc(nullptr)
+  , m_pGeoSrcOwn(nullptr)
+  , m_pPicYuvRot(nullptr)
+{
+  memset(&m_viewPortInfo, 0, sizeof(m_viewPortInfo));
+  memset(&m_srcVideoInfo, 0, sizeof(m_srcVideoInfo));
+}
+
+TViewPortRenderer::~TViewPortRenderer()
+{
+  xClearCache();
+  if (m_pGeoSrcOwn)
+  {
+    delete m_pGeoSrcOwn;
+    m_pGeoSrcOwn = nullptr;
+  }
+  if (m_pPicYuvRot)
+  {
+    m_pPicYuvRot->destroy();
+    delete m_pPicYuvRot;
+    m_pPicYuvRot = nullptr;
+  }
+}
+
+Void TViewPortRenderer::init(const SVideoInfo &sSrcVideoInfo, const InputGeoParam *pInGeoParam, ChromaFormat viewPortChromaFormat, Int iCacheSize)
+{
+  CHECK(m_pGeoSrcOwn, "the viewport renderer is already initialized");
+  xClearCache();
+  m_pGeoSrc      = nullptr;
+  m_geoParam     = *pInGeoParam;
+  m_srcVideoInfo = sSrcVideoInfo;
+  m_iCacheSize   = iCacheSize;
+
+  memset(&m_viewPortInfo, 0, sizeof(m_viewPortInfo));
+  m_viewPortInfo.geoType = SVIDEO_VIEWPORT;
+  m_viewPortInfo.framePackStruct.chromaFormatIDC = viewPortChromaFormat;
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+  m_viewPortInfo.framePackStruct.chromaSampleLocType = 0;
+#endif
+  m_viewPortInfo.framePackStruct.rows = m_viewPortInfo.framePackStruct.cols = 1;
+  m_viewPortInfo.iNumFaces = 1;
+}
+
+/********************************
+//import the picture into the source geometry created by init() and sphere-pad it; the conversion follows 360ConvertApp:
+//a rotated ERP family picture is rotated back first, compact OHP/ISP pictures are unpacked by compactFramePackConvertYuv;
+*********************************/
+Void TViewPortRenderer::importPicture(PelUnitBuf *pSrcYuv)
+{
+  if (!m_pGeoSrcOwn)
+  {
+    m_pGeoSrcOwn = TGeometry::create(m_srcVideoInfo, &m_geoParam);
+  }
+  const SVideoInfo *pSrcInfo = m_pGeoSrcOwn->getSVideoInfo();
+  Int iRot = pSrcInfo->framePackStruct.faces[0][0].rot;
+  if (iRot && (pSrcInfo->geoType == SVIDEO_EQUIRECT
+#if SVIDEO_ADJUSTED_EQUALAREA
+               || pSrcInfo->geoType == SVIDEO_ADJUSTEDEQUALAREA
+#else
+               || pSrcInfo->geoType == SVIDEO_EQUALAREA
+#endif
+              ))
+  {
+    if (!m_pPicYuvRot)
+    {
+      Int iWidth  = pSrcYuv->get(COMPONENT_Y).width;
+      Int iHeight = pSrcYuv->get(COMPONENT_Y).height;
+      if (iRot == 90 || iRot == 270)
+      {
+        std::swap(iWidth, iHeight);
+      }
+      m_pPicYuvRot = new PelStorage;
+      m_pPicYuvRot->create(pSrcYuv->chromaFormat, Area(Position(), Size(iWidth, iHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+    }
+    m_pGeoSrcOwn->rotYuv(pSrcYuv, m_pPicYuvRot, (360 - iRot) % 360);
+    m_pGeoSrcOwn->convertYuv(m_pPicYuvRot);
+  }
+  else if ((pSrcInfo->geoType == SVIDEO_OCTAHEDRON || pSrcInfo->geoType == SVIDEO_ICOSAHEDRON) && pSrcInfo->iCompactFPStructure)
+  {
+    m_pGeoSrcOwn->compactFramePackConvertYuv(pSrcYuv);
+  }
+  else
+  {
+    m_pGeoSrcOwn->convertYuv(pSrcYuv);
+  }
+  m_pGeoSrcOwn->spherePadding();
+  setSourceGeometry(m_pGeoSrcOwn);
+}
+
+Void TViewPortRenderer::setSourceGeometry(TGeometry *pGeoSrc)
+{
+  if (pGeoSrc != m_pGeoSrc)
+  {
+    // the cached weight maps address the faces of the previous source geometry;
+    xClearCache();
+    m_pGeoSrc = pGeoSrc;
+  }
+}
+
+Void TViewPortRenderer::setCacheSize(Int iCacheSize)
+{
+  m_iCacheSize = iCacheSize;
+  while ((Int) m_cache.size() > m_iCacheSize)
+  {
+    delete m_cache.back().pViewPort;
+    m_cache.pop_back();
+  }
+}
+
+TViewPort* TViewPortRenderer::xGetViewPort(const ViewPortPose &pose)
+{
+  auto it = m_cache.begin();
+  while (it != m_cache.end() && !(it->pose == pose))
+  {
+    it++;
+  }
+  if (it != m_cache.end())
+  {
+    m_cache.splice(m_cache.begin(), m_cache, it);
+  }
+  else
+  {
+    SVideoInfo sViewPortInfo   = m_viewPortInfo;
+    sViewPortInfo.iFaceWidth   = pose.iWidth;
+    sViewPortInfo.iFaceHeight  = pose.iHeight;
+    sViewPortInfo.viewPort.hFOV   = pose.fHFOV;
+    sViewPortInfo.viewPort.vFOV   = pose.fVFOV;
+    sViewPortInfo.viewPort.fYaw   = pose.fYaw;
+    sViewPortInfo.viewPort.fPitch = pose.fPitch;
+    Entry entry = { pose, (TViewPort*) TGeometry::create(sViewPortInfo, &m_geoParam) };
+    // the pose of a viewport geometry never changes, its own orientation cache is not needed;
+    entry.pViewPort->setMapCacheSize(0);
+    m_cache.push_front(entry);
+  }
+  return m_cache.front().pViewPort;
+}
+
+Void TViewPortRenderer::xClearCache()
+{
+  for (auto &entry: m_cache)
+  {
+    delete entry.pViewPort;
+  }
+  m_cache.clear();
+}
+
+/********************************
+//render poses[i] into dstYuvs[i]; a pose listed more than once is converted once and packed into each of its buffers;
+//the distinct poses are converted concurrently, they only read the (already padded) source faces;
+*********************************/
+Void TViewPortRenderer::render(const std::vector<ViewPortPose> &poses, const std::vector<PelUnitBuf*> &dstYuvs)
+{
+  CHECK(!m_pGeoSrc, "no source picture for the viewports");
+  CHECK(poses.size() != dstYuvs.size(), "one destination buffer per viewport pose is needed");
+
+  std::vector<TViewPort*>       viewPorts;
+  std::vector<std::vector<Int>> viewPortDsts;
+  for (Int i = 0; i < (Int) poses.size(); i++)
+  {
+    CHECK(dstYuvs[i]->get(COMPONENT_Y).width != poses[i].iWidth || dstYuvs[i]->get(COMPONENT_Y).height != poses[i].iHeight,
+          "the destination buffer does not match the viewport size");
+    TViewPort *pViewPort = xGetViewPort(poses[i]);
+    Int k = 0;
+    while (k < (Int) viewPorts.size() && viewPorts[k] != pViewPort)
+    {
+      k++;
+    }
+    if (k == (Int) viewPorts.size())
+    {
+      viewPorts.push_back(pViewPort);
+      viewPortDsts.push_back(std::vector<Int>());
+    }
+    viewPortDsts[k].push_back(i);
+  }
+
+  m_pGeoSrc->spherePadding();
+  auto renderViewPort = [&](Int k) {
+    m_pGeoSrc->geoConvert(viewPorts[k]);
+    for (Int i: viewPortDsts[k])
+    {
+      viewPorts[k]->framePack(dstYuvs[i]);
+    }
+  };
+#if SVIDEO_PARALLEL_PROCESSING
+  TThreadPool::runTasks(m_geoParam.iNumThreads, (Int) viewPorts.size(), renderViewPort);
+#else
+  for (Int k = 0; k < (Int) viewPorts.size(); k++)
+  {
+    renderViewPort(k);
+  }
+#endif
+
+  // the poses of this batch are in front of the list, they stay cached even beyond the cache size;
+  while ((Int) m_cache.size() > std::max(m_iCacheSize, (Int) viewPorts.size()))
+  {
+    delete m_cache.back().pViewPort;
+    m_cache.pop_back();
+  }
+}
+
+#endif
+#endif
@@ -0,0 +1,109 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TViewPortRenderer.h
+    \brief    Batch rendering of many viewports from one 360 picture (header)
+*/
+
+#ifndef __TVIEWPORTRENDERER__
+#define __TVIEWPORTRENDERER__
+#include "TViewPort.h"
+
+#include <list>
+#include <vector>
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+#if EXTENSION_360_VIDEO
+#if SVIDEO_VIEWPORT_RENDERER
+
+/// one viewport of a batch: orientation and field of view in degrees, size in luma samples;
+struct ViewPortPose
+{
+  Float fYaw;
+  Float fPitch;
+  Float fHFOV;
+  Float fVFOV;
+  Int   iWidth;
+  Int   iHeight;
+
+  Bool operator==(const ViewPortPose &pose) const
+  {
+    return fYaw == pose.fYaw && fPitch == pose.fPitch && fHFOV == pose.fHFOV && fVFOV == pose.fVFOV
+           && iWidth == pose.iWidth && iHeight == pose.iHeight;
+  }
+};
+
+/// Renders a list of viewports from one picture: the picture is imported and sphere-padded once, then the viewports
+/// are converted concurrently, each into its own caller-provided buffer.
+/// Every pose is rendered by a viewport geometry holding the weight maps of that pose; these geometries are kept in
+/// an LRU cache keyed by the pose, so that the poses repeating from picture to picture do not generate maps again.
+/// The maps depend on the source geometry: attaching another source geometry empties the cache.
+class TViewPortRenderer
+{
+private:
+  struct Entry
+  {
+    ViewPortPose pose;
+    TViewPort   *pViewPort;
+  };
+  std::list<Entry> m_cache;                //most recently used first;
+  Int              m_iCacheSize;
+  InputGeoParam    m_geoParam;
+  SVideoInfo       m_viewPortInfo;         //template of the viewport geometries;
+  SVideoInfo       m_srcVideoInfo;
+  TGeometry       *m_pGeoSrc;
+  TGeometry       *m_pGeoSrcOwn;           //source geometry of importPicture(), created on its first call;
+  PelStorage      *m_pPicYuvRot;           //picture of a rotated ERP family input;
+
+  TViewPort* xGetViewPort(const ViewPortPose &pose);
+  Void       xClearCache();
+
+public:
+  TViewPortRenderer();
+  virtual ~TViewPortRenderer();
+
+  Void init(const SVideoInfo &sSrcVideoInfo, const InputGeoParam *pInGeoParam, ChromaFormat viewPortChromaFormat, Int iCacheSize);
+  Void importPicture(PelUnitBuf *pSrcYuv);                 ///< convertYuv() and spherePadding() of an own source geometry of the format given to init();
+  Void setSourceGeometry(TGeometry *pGeoSrc);              ///< renders from a geometry that already holds the sphere-padded picture;
+  Void render(const std::vector<ViewPortPose> &poses, const std::vector<PelUnitBuf*> &dstYuvs);  ///< dstYuvs[i] receives poses[i];
+  Void setCacheSize(Int iCacheSize);
+  Int  getNumCached() const { return (Int) m_cache.size(); }
+};
+
+#endif
+#endif
+#endif // __TVIEWPORTRENDERER__
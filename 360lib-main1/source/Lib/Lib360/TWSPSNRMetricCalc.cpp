@@ -90,6 +90,15 @@ TWSPSNRMetric::TWSPSNRMetric()
 #endif
 {
   m_dWSPSNR[0] = m_dWSPSNR[1] = m_dWSPSNR[2] = 0;
+#if SVIDEO_WSPSNR_WEIGHT_PLANE
+  for (Int chType = 0; chType < MAX_NUM_CHANNEL_TYPE; chType++)
+  {
+    m_weightSum[chType]    = 0;
+    m_iPlaneWidth[chType]  = 0;
+    m_iPlaneHeight[chType] = 0;
+  }
+  m_planeChromaFormat = ChromaFormat::_400;
+#endif
 }
 
 TWSPSNRMetric::~TWSPSNRMetric()
@@ -2883,8 +2892,221 @@ void TWSPSNRMetric::createTable(PelUnitBuf* pcPicD, TGeometry *pcCodingGeomtry)
     printf("WS-PSNR does not support for this format: GeoType:%d, FramePackingType:%d!\n", pcCodingGeomtry->getType(), pCodingSVideoInfo->iCompactFPStructure); 
     CHECK(true, "Checking configruation parameters!\n");
   }
+#if SVIDEO_WSPSNR_WEIGHT_PLANE
+  TGeometry::initSimdOps();
+  xCreateWeightPlanes(pcPicD);
+#endif
 }
 
+#if SVIDEO_WSPSNR_WEIGHT_PLANE
+/**
+ * Resolves the weight of every sample of the packed frame the way the per-sample loop of xCalculateWSPSNR did,
+ * including the fisheye circle and the unused areas of the frame packing (weight 0). Rows whose used samples share
+ * one weight are kept as a single value; the weight sums are accumulated in the original sample order.
+ */
+Void TWSPSNRMetric::xCreateWeightPlanes(PelUnitBuf* pcPicD)
+{
+  const ChromaFormat chromaFormat = pcPicD->chromaFormat;
+  m_planeChromaFormat = chromaFormat;
+
+  for (Int chan = 0; chan < std::min<Int>(getNumberValidComponents(chromaFormat), MAX_NUM_CHANNEL_TYPE); chan++)
+  {
+    const ComponentID ch     = ComponentID(chan);
+    const Int         chType = Int(toChannelType(ch));
+    const Int         iWidth  = pcPicD->get(ch).width;
+    const Int         iHeight = pcPicD->get(ch).height;
+    Int Width_from = 0;
+    Int Width_to = iWidth;
+#if SVIDEO_HEMI_PROJECTIONS
+    if (m_recGeoType == SVIDEO_HCMP || m_recGeoType == SVIDEO_HEAC)
+    {
+      Width_from = iWidth / 4;
+      Width_to = iWidth - iWidth / 4;
+    }
+#endif
+    std::vector<Double> &plane = m_weightPlane[chType];
+    std::vector<Double> rowWeights(iWidth);
+    plane.clear();
+    m_rowWeight[chType].assign(iHeight, 0);
+    m_rowStart[chType].assign(iHeight, 0);
+    m_rowEnd[chType].assign(iHeight, 0);
+    m_iPlaneWidth[chType]  = iWidth;
+    m_iPlaneHeight[chType] = iHeight;
+
+    Double fWeight = 1;
+    Double fWeightSum = 0;
+    for (Int y = 0; y < iHeight; y++)
+    {
+      if (m_codingGeoType == SVIDEO_EQUIRECT)
+      {
+        fWeight = !chan ? m_fErpWeight_Y[y] : m_fErpWeight_C[y];
+      }
+      std::fill(rowWeights.begin(), rowWeights.end(), 0.0);
+      for (Int x = Width_from; x < Width_to; x++)
+      {
+        if(  (m_codingGeoType == SVIDEO_CUBEMAP) 
+#if SVIDEO_ADJUSTED_CUBEMAP
+          || (m_codingGeoType == SVIDEO_ADJUSTEDCUBEMAP)
+#endif
+#if SVIDEO_EQUATORIAL_CYLINDRICAL && !SVIDEO_ECP_WSPSNR_FIX_TICKET56
+          || (m_codingGeoType == SVIDEO_EQUATORIALCYLINDRICAL)
+#endif
+#if SVIDEO_EQUIANGULAR_CUBEMAP
+          || (m_codingGeoType == SVIDEO_EQUIANGULARCUBEMAP)
+#endif
+#if SVIDEO_HEMI_PROJECTIONS
+          || (m_codingGeoType == SVIDEO_HCMP)
+          || (m_codingGeoType == SVIDEO_HEAC)
+#endif
+          )
+        {
+          if (iWidth/4 == iHeight/3 && x >= iWidth/4 && (y< iHeight/3 || y>= 2*iHeight/3))
+          {
+            fWeight = 0;
+          }
+          else if (!chan)
+          {
+            fWeight = m_fCubeWeight_Y[(m_iCodingFaceWidth)*(y%(m_iCodingFaceHeight)) +(x%(m_iCodingFaceWidth))];
+          }
+          else
+          {
+            fWeight = m_fCubeWeight_C[(m_iCodingFaceWidth>>(::getComponentScaleX(COMPONENT_Cb, chromaFormat)))*(y%(m_iCodingFaceHeight>>(::getComponentScaleY(COMPONENT_Cb, chromaFormat)))) +(x%(m_iCodingFaceWidth>>(::getComponentScaleX(COMPONENT_Cb, chromaFormat))))];
+          }
+        }
+#if SVIDEO_ADJUSTED_EQUALAREA
+        else if (m_codingGeoType == SVIDEO_ADJUSTEDEQUALAREA)
+#else
+        else if (m_codingGeoType == SVIDEO_EQUALAREA)
+#endif
+        {
+          fWeight = !chan ? m_fEapWeight_Y[y*iWidth+x] : m_fEapWeight_C[y*iWidth+x];
+        }
+        else if (m_codingGeoType == SVIDEO_OCTAHEDRON)
+        {
+          fWeight = !chan ? m_fOctaWeight_Y[y*iWidth+x] : m_fOctaWeight_C[y*iWidth+x];
+        }
+        else if (m_codingGeoType == SVIDEO_ICOSAHEDRON)
+        {
+          fWeight = !chan ? m_fIcoWeight_Y[y*iWidth+x] : m_fIcoWeight_C[y*iWidth+x];
+        }
+#if SVIDEO_WSPSNR_SSP
+        else if (m_codingGeoType == SVIDEO_SEGMENTEDSPHERE)
+        {
+          fWeight = !chan ? m_fSspWeight_Y[y*iWidth+x] : m_fSspWeight_C[y*iWidth+x];
+        }
+#endif
+#if SVIDEO_ROTATED_SPHERE
+        else if (m_codingGeoType == SVIDEO_ROTATEDSPHERE)
+        {
+          fWeight = !chan ? m_fRspWeight_Y[y*iWidth+x] : m_fRspWeight_C[y*iWidth+x];
+        }
+#endif
+#if SVIDEO_ECP_WSPSNR_FIX_TICKET56
+        else if (m_codingGeoType == SVIDEO_EQUATORIALCYLINDRICAL)
+        {
+          fWeight = !chan ? m_fEcpWeight_Y[y*iWidth+x] : m_fEcpWeight_C[y*iWidth+x];
+        }
+#endif
+#if SVIDEO_ERP_PADDING
+        else if (m_codingGeoType == SVIDEO_EQUIRECT && m_bPERP)
+        {
+          if ((x < (SVIDEO_ERP_PAD_L >> getComponentScaleX(ch, chromaFormat))) || (x >= (iWidth - (SVIDEO_ERP_PAD_R >> getComponentScaleX(ch, chromaFormat)))))
+            fWeight = 0;
+          else
+            fWeight = !chan ? m_fErpWeight_Y[y] : m_fErpWeight_C[y];
+        }
+#endif
+#if SVIDEO_HYBRID_EQUIANGULAR_CUBEMAP
+        else if (m_codingGeoType == SVIDEO_HYBRIDEQUIANGULARCUBEMAP)
+        {
+          fWeight = !chan ? m_fHecWeight_Y[y*iWidth+x] : m_fHecWeight_C[y*iWidth+x];
+        }
+#endif
+#if SVIDEO_GENERALIZED_CUBEMAP
+        else if (m_codingGeoType == SVIDEO_GENERALIZEDCUBEMAP)
+        {
+          fWeight = !chan ? m_fGcmpWeight_Y[y*iWidth+x] : m_fGcmpWeight_C[y*iWidth+x];
+        }
+#endif
+
+        Double fSampleWeight = fWeight;
+#if SVIDEO_FISHEYE
+        if (m_codingGeoType == SVIDEO_EQUIRECT && m_recGeoType == SVIDEO_FISHEYE_CIRCULAR)
+        {
+          Double  max_angle_rad = m_fisheyeInfo.fFOV / SVIDEO_ROT_PRECISION / 2 * S_PI / 180.0;
+
+          Double  ctr_yaw = m_fisheyeInfo.fCentreAzimuth/SVIDEO_ROT_PRECISION * S_PI / 180;
+          Double  ctr_pitch = -m_fisheyeInfo.fCentreElevation/SVIDEO_ROT_PRECISION  * S_PI / 180;
+
+          Double  ctr_sphere_x = scos(ctr_pitch)*scos(ctr_yaw);
+          Double  ctr_sphere_y = ssin(ctr_pitch);
+          Double  ctr_sphere_z = -scos(ctr_pitch)*ssin(ctr_yaw);
+
+          Double  ctr_norm = ssqrt(ctr_sphere_x*ctr_sphere_x + ctr_sphere_y*ctr_sphere_y + ctr_sphere_z*ctr_sphere_z);
+
+          Int    xx = x << getComponentScaleX(ch, chromaFormat);
+          Int    yy = y << getComponentScaleY(ch, chromaFormat);
+
+          Int    sWidth = iWidth << getComponentScaleX(ch, chromaFormat);
+          Int    sHeight = iHeight << getComponentScaleY(ch, chromaFormat);
+
+          Double  yaw = ((xx + 0.5) / sWidth - 0.5) * 2 * S_PI;
+          Double  pitch = ((yy + 0.5) / sHeight - 0.5) * -S_PI;
+
+          Double  sphere_x = scos(pitch)*scos(yaw);
+          Double  sphere_y = ssin(pitch);
+          Double  sphere_z = -scos(pitch)*ssin(yaw);
+
+          Double  norm = ssqrt(sphere_x*sphere_x + sphere_y*sphere_y + sphere_z*sphere_z);
+
+          Double  innerProduct = sphere_x*ctr_sphere_x + sphere_y*ctr_sphere_y + sphere_z*ctr_sphere_z;
+          Double  theta_rad = acos(innerProduct / (norm * ctr_norm));
+
+          if (!(theta_rad < max_angle_rad))
+          {
+            fSampleWeight = 0;
+          }
+        }
+#endif
+        rowWeights[x] = fSampleWeight;
+        if (fSampleWeight > 0)
+          fWeightSum += fSampleWeight;
+      }
+
+      // samples of weight 0 at both ends of the row do not contribute to the sums;
+      Int iStart = 0;
+      Int iEnd = iWidth;
+      while (iStart < iEnd && rowWeights[iStart] == 0)
+      {
+        iStart++;
+      }
+      while (iEnd > iStart && rowWeights[iEnd - 1] == 0)
+      {
+        iEnd--;
+      }
+      m_rowStart[chType][y]  = iStart;
+      m_rowEnd[chType][y]    = iEnd;
+      m_rowWeight[chType][y] = iStart < iEnd ? rowWeights[iStart] : 0;
+
+      const Bool bUniformRow = std::all_of(rowWeights.begin() + iStart, rowWeights.begin() + iEnd, [&](Double w) { return w == m_rowWeight[chType][y]; });
+      if (!bUniformRow && plane.empty())
+      {
+        plane.assign(size_t(iWidth) * iHeight, 0.0);
+        for (Int yy = 0; yy < y; yy++)
+        {
+          std::fill(plane.begin() + size_t(yy) * iWidth + m_rowStart[chType][yy], plane.begin() + size_t(yy) * iWidth + m_rowEnd[chType][yy], m_rowWeight[chType][yy]);
+        }
+      }
+      if (!plane.empty())
+      {
+        std::copy(rowWeights.begin(), rowWeights.end(), plane.begin() + size_t(y) * iWidth);
+      }
+    }
+    m_weightSum[chType] = fWeightSum;
+  }
+}
+#endif
+
 Void TWSPSNRMetric::xCalculateWSPSNR( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPicD )
 {
   Int iBitDepthForPSNRCalc[MAX_NUM_CHANNEL_TYPE];
@@ -2901,6 +3123,54 @@ Void TWSPSNRMetric::xCalculateWSPSNR( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPic
   PelUnitBuf &picd=*pcPicD;
   //Double SSDspsnr[3]={0, 0 ,0};
   //ChromaFormat chromaFormat = pcPicD->chromaFormat;
+#if SVIDEO_WSPSNR_WEIGHT_PLANE
+  if (pcPicD->chromaFormat != m_planeChromaFormat || pcPicD->get(COMPONENT_Y).width != m_iPlaneWidth[Int(ChannelType::LUMA)] || pcPicD->get(COMPONENT_Y).height != m_iPlaneHeight[Int(ChannelType::LUMA)])
+  {
+    xCreateWeightPlanes(pcPicD);
+  }
+
+  for (Int chan = 0; chan < getNumberValidComponents(pcPicD->chromaFormat); chan++)
+  {
+    const ComponentID ch        = ComponentID(chan);
+    const Int         chType    = Int(toChannelType(ch));
+    const Pel*        pOrg      = pcOrgPicYuv->get(ch).bufAt(0, 0);
+    const Int         iOrgStride = (Int)pcOrgPicYuv->get(ch).stride;
+    const Pel*        pRec      = picd.get(ch).bufAt(0, 0);
+    const Int         iRecStride = (Int)picd.get(ch).stride;
+    const Int         iWidth    = m_iPlaneWidth[chType];
+    const Int         iHeight   = m_iPlaneHeight[chType];
+    const Int         iOrgShift = iReferenceBitShift[chType];
+    const Int         iRecShift = iOutputBitShift[chType];
+    const Double*     pWeight   = m_weightPlane[chType].empty() ? nullptr : m_weightPlane[chType].data();
+
+    Double SSDwpsnr = 0;
+    for (Int y = 0; y < iHeight; y++)
+    {
+      const Int iStart = m_rowStart[chType][y];
+      const Int iEnd   = m_rowEnd[chType][y];
+      if (iStart < iEnd)
+      {
+        if (pWeight)
+        {
+          SSDwpsnr += g_metric360OP.weightedSSE(pOrg + iStart, pRec + iStart, pWeight + iStart, iEnd - iStart, iOrgShift, iRecShift);
+        }
+        else
+        {
+          SSDwpsnr += m_rowWeight[chType][y] * g_metric360OP.sse(pOrg + iStart, pRec + iStart, iEnd - iStart, iOrgShift, iRecShift);
+        }
+      }
+      pOrg += iOrgStride;
+      pRec += iRecStride;
+      if (pWeight)
+      {
+        pWeight += iWidth;
+      }
+    }
+
+    const Int maxval = 255<<(iBitDepthForPSNRCalc[chType]-8) ;
+    m_dWSPSNR[ch]         = ( SSDwpsnr ? 10.0 * log10( (maxval * maxval*m_weightSum[chType]) / (Double)SSDwpsnr ) : 999.99 );
+  }
+#else
 
   for(Int chan=0; chan< getNumberValidComponents(pcPicD->chromaFormat); chan++)
   {
@@ -3193,6 +3463,7 @@ Void TWSPSNRMetric::xCalculateWSPSNR( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPic
 
     m_dWSPSNR[ch]         = ( SSDwpsnr ? 10.0 * log10( (maxval * maxval*fWeightSum) / (Double)SSDwpsnr ) : 999.99 );
 }
+#endif
 }
 
 #if SVIDEO_WSPSNR_E2E
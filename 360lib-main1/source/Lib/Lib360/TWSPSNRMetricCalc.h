@@ -39,6 +39,9 @@
 #define __TWSPSNRCALC__
 #include "TGeometry.h"
 #include "../Utilities/VideoIOYuv.h"
+#if SVIDEO_WSPSNR_WEIGHT_PLANE
+#include "../CommonLib/Metric360.h"
+#endif
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -117,6 +120,19 @@ private:
 #if SVIDEO_FISHEYE
   FisheyeInfo m_fisheyeInfo;
 #endif
+#if SVIDEO_WSPSNR_WEIGHT_PLANE
+  // weights of the packed frame, per channel type;
+  std::vector<Double> m_weightPlane[MAX_NUM_CHANNEL_TYPE];  ///< weight of each sample, empty when every row has a single weight
+  std::vector<Double> m_rowWeight[MAX_NUM_CHANNEL_TYPE];    ///< weight of the samples of a row when m_weightPlane is empty
+  std::vector<Int>    m_rowStart[MAX_NUM_CHANNEL_TYPE];     ///< first sample of a row with a non-zero weight
+  std::vector<Int>    m_rowEnd[MAX_NUM_CHANNEL_TYPE];       ///< last sample + 1 of a row with a non-zero weight
+  Double              m_weightSum[MAX_NUM_CHANNEL_TYPE];
+  Int                 m_iPlaneWidth[MAX_NUM_CHANNEL_TYPE];
+  Int                 m_iPlaneHeight[MAX_NUM_CHANNEL_TYPE];
+  ChromaFormat        m_planeChromaFormat;
+
+  Void    xCreateWeightPlanes(PelUnitBuf* pcPicD);
+#endif
 public:
   TWSPSNRMetric();
   virtual ~TWSPSNRMetric();
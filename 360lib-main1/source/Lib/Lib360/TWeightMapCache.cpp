@@ -0,0 +1,270 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TWeightMapCache.cpp
+    \brief    On-disk cache of the geometry weight maps
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+#include "TWeightMapCache.h"
+
+#if EXTENSION_360_VIDEO
+#if SVIDEO_WEIGHT_MAP_CACHE
+
+static const TChar    S_WEIGHT_MAP_CACHE_MAGIC[8] = { '3', '6', '0', 'W', 'M', 'A', 'P', '\0' };
+static const uint64_t S_FNV_OFFSET_BASIS           = 0xcbf29ce484222325ULL;
+static const uint64_t S_FNV_PRIME                  = 0x100000001b3ULL;
+
+struct WeightMapCacheHeader
+{
+  TChar    magic[8];
+  UInt     uiVersion;
+  UInt     uiKeySize;
+  UInt     uiNumMaps;
+  UInt     uiReserved;
+  uint64_t uiKeyHash;
+  uint64_t uiPayloadHash;
+};
+
+TWeightMapCache::TWeightMapCache(const std::string &sCacheDir, Int iMaxMB)
+  : m_sCacheDir(sCacheDir)
+  , m_iMaxBytes((int64_t) std::max(iMaxMB, 0) << 20)
+{
+  // everything the maps depend on apart from the geometries themselves;
+  addKey(S_WEIGHT_MAP_CACHE_VERSION);
+  addKey((UInt) sizeof(POSType));
+  addKey((UInt) sizeof(PxlFltLut));
+  addKey(S_INTERPOLATE_PrecisionBD);
+  addKey(S_LANCZOS_LUT_SCALE);
+  addKey(S_PAD_MAX);
+}
+
+// FNV-1a on 64-bit words, the tail byte by byte;
+uint64_t TWeightMapCache::xHash(const UChar *pData, size_t iSize, uint64_t uiHash) const
+{
+  size_t i = 0;
+  for (; i + 8 <= iSize; i += 8)
+  {
+    uint64_t uiWord;
+    memcpy(&uiWord, pData + i, 8);
+    uiHash = (uiHash ^ uiWord) * S_FNV_PRIME;
+  }
+  for (; i < iSize; i++)
+  {
+    uiHash = (uiHash ^ pData[i]) * S_FNV_PRIME;
+  }
+  return uiHash;
+}
+
+std::string TWeightMapCache::xGetFileName() const
+{
+  TChar fileName[64];
+  snprintf(fileName, sizeof(fileName), "wmap_%016llx.bin",
+           (unsigned long long) xHash(m_key.data(), m_key.size(), S_FNV_OFFSET_BASIS));
+  TChar cLast = m_sCacheDir[m_sCacheDir.size() - 1];
+  return m_sCacheDir + ((cLast == '/' || cLast == '\\') ? "" : "/") + fileName;
+}
+
+Void TWeightMapCache::addMap(PxlFltLut *pMap, int64_t iNumEntries)
+{
+  m_maps.push_back(pMap);
+  m_mapSizes.push_back(iNumEntries);
+}
+
+Bool TWeightMapCache::load()
+{
+  if (!isEnabled())
+  {
+    return false;
+  }
+  std::string sFileName = xGetFileName();
+  FILE       *fp        = fopen(sFileName.c_str(), "rb");
+  if (!fp)
+  {
+    return false;
+  }
+
+  WeightMapCacheHeader header;
+  Bool bValid = (fread(&header, sizeof(header), 1, fp) == 1)
+                && !memcmp(header.magic, S_WEIGHT_MAP_CACHE_MAGIC, sizeof(header.magic))
+                && header.uiVersion == S_WEIGHT_MAP_CACHE_VERSION && header.uiKeySize == m_key.size()
+                && header.uiNumMaps == m_maps.size()
+                && header.uiKeyHash == xHash(m_key.data(), m_key.size(), S_FNV_OFFSET_BASIS);
+
+  std::vector<UChar> buf;
+  if (bValid)
+  {
+    buf.resize(m_key.size());
+    bValid = (fread(buf.data(), 1, buf.size(), fp) == buf.size()) && buf == m_key;
+  }
+  if (bValid)
+  {
+    std::vector<int64_t> mapSizes(m_mapSizes.size());
+    bValid = (fread(mapSizes.data(), sizeof(int64_t), mapSizes.size(), fp) == mapSizes.size()) && mapSizes == m_mapSizes;
+  }
+
+  int64_t  iOffset = sizeof(header) + m_key.size() + m_mapSizes.size() * sizeof(int64_t);
+  uint64_t uiHash  = S_FNV_OFFSET_BASIS;
+  for (size_t i = 0; bValid && i < m_maps.size(); i++)
+  {
+    int64_t iPad = (S_WEIGHT_MAP_CACHE_ALIGN - iOffset % S_WEIGHT_MAP_CACHE_ALIGN) % S_WEIGHT_MAP_CACHE_ALIGN;
+    buf.resize(iPad);
+    size_t iSize = m_mapSizes[i] * sizeof(PxlFltLut);
+    bValid = (fread(buf.data(), 1, iPad, fp) == (size_t) iPad) && (fread(m_maps[i], 1, iSize, fp) == iSize);
+    uiHash = xHash((const UChar *) m_maps[i], iSize, uiHash);
+    iOffset += iPad + iSize;
+  }
+  bValid = bValid && (uiHash == header.uiPayloadHash);
+  fclose(fp);
+
+  if (!bValid)
+  {
+    printf("Weight map cache file %s is not valid and will be rebuilt.\n", sFileName.c_str());
+  }
+  else if (m_iMaxBytes > 0)
+  {
+    // mark the file as recently used for the eviction;
+    std::error_code ec;
+    std::filesystem::last_write_time(sFileName, std::filesystem::file_time_type::clock::now(), ec);
+  }
+  return bValid;
+}
+
+Void TWeightMapCache::store()
+{
+  if (!isEnabled())
+  {
+    return;
+  }
+
+  WeightMapCacheHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, S_WEIGHT_MAP_CACHE_MAGIC, sizeof(header.magic));
+  header.uiVersion     = S_WEIGHT_MAP_CACHE_VERSION;
+  header.uiKeySize     = (UInt) m_key.size();
+  header.uiNumMaps     = (UInt) m_maps.size();
+  header.uiKeyHash     = xHash(m_key.data(), m_key.size(), S_FNV_OFFSET_BASIS);
+  header.uiPayloadHash = S_FNV_OFFSET_BASIS;
+  for (size_t i = 0; i < m_maps.size(); i++)
+  {
+    header.uiPayloadHash = xHash((const UChar *) m_maps[i], m_mapSizes[i] * sizeof(PxlFltLut), header.uiPayloadHash);
+  }
+
+  // write to a temporary file and rename it, so that concurrent jobs never read a partial file;
+  std::string sFileName = xGetFileName();
+  std::string sTmpName  = sFileName + "." + std::to_string((unsigned long long) (uintptr_t) this) + "_"
+                         + std::to_string((long long) std::chrono::steady_clock::now().time_since_epoch().count());
+  FILE *fp = fopen(sTmpName.c_str(), "wb");
+  if (!fp)
+  {
+    printf("Warning: cannot write the weight map cache file %s.\n", sTmpName.c_str());
+    return;
+  }
+  Bool bOk = (fwrite(&header, sizeof(header), 1, fp) == 1)
+             && (fwrite(m_key.data(), 1, m_key.size(), fp) == m_key.size())
+             && (fwrite(m_mapSizes.data(), sizeof(int64_t), m_mapSizes.size(), fp) == m_mapSizes.size());
+
+  int64_t            iOffset = sizeof(header) + m_key.size() + m_mapSizes.size() * sizeof(int64_t);
+  std::vector<UChar> zeros(S_WEIGHT_MAP_CACHE_ALIGN, 0);
+  for (size_t i = 0; bOk && i < m_maps.size(); i++)
+  {
+    int64_t iPad  = (S_WEIGHT_MAP_CACHE_ALIGN - iOffset % S_WEIGHT_MAP_CACHE_ALIGN) % S_WEIGHT_MAP_CACHE_ALIGN;
+    size_t  iSize = m_mapSizes[i] * sizeof(PxlFltLut);
+    bOk = (fwrite(zeros.data(), 1, iPad, fp) == (size_t) iPad) && (fwrite(m_maps[i], 1, iSize, fp) == iSize);
+    iOffset += iPad + iSize;
+  }
+  bOk = (fclose(fp) == 0) && bOk;
+
+  if (!bOk || rename(sTmpName.c_str(), sFileName.c_str()) != 0)
+  {
+    printf("Warning: cannot write the weight map cache file %s.\n", sFileName.c_str());
+    remove(sTmpName.c_str());
+  }
+  else if (m_iMaxBytes > 0)
+  {
+    xEvict(sFileName);
+  }
+}
+
+// removes the least recently used cache files until the cache fits into its limit; the file just written is kept;
+// files removed by a concurrent job or still being read are harmless, a reader keeps its open file and a later job
+// regenerates the maps;
+Void TWeightMapCache::xEvict(const std::string &sKeepFile) const
+{
+  struct CacheFile
+  {
+    std::filesystem::file_time_type time;
+    int64_t                         iSize;
+    std::filesystem::path           path;
+  };
+  std::vector<CacheFile> files;
+  int64_t                iTotal = 0;
+  std::error_code        ec;
+  const std::filesystem::path keepPath(sKeepFile);
+  for (std::filesystem::directory_iterator it(m_sCacheDir, ec), end; !ec && it != end; it.increment(ec))
+  {
+    const std::string sName = it->path().filename().string();
+    if (sName.compare(0, 5, "wmap_") || sName.size() < 4 || sName.compare(sName.size() - 4, 4, ".bin"))
+    {
+      continue;
+    }
+    std::error_code ecFile;
+    CacheFile       file = { it->last_write_time(ecFile), (int64_t) it->file_size(ecFile), it->path() };
+    if (ecFile)
+    {
+      continue;
+    }
+    iTotal += file.iSize;
+    if (it->path().filename() != keepPath.filename())
+    {
+      files.push_back(file);
+    }
+  }
+  std::sort(files.begin(), files.end(), [](const CacheFile &a, const CacheFile &b) { return a.time < b.time; });
+  for (size_t i = 0; i < files.size() && iTotal > m_iMaxBytes; i++)
+  {
+    std::error_code ecRemove;
+    if (std::filesystem::remove(files[i].path, ecRemove))
+    {
+      iTotal -= files[i].iSize;
+    }
+  }
+}
+
+#endif
+#endif
@@ -58,6 +58,9 @@
 
 DecApp::DecApp()
 : m_iPOCLastDisplay(-MAX_INT)
+#if EXTENSION_360_VIDEO && !RExt__DECODER_DEBUG_STATISTICS
+, m_ext360(nullptr)
+#endif
 {
   for (int i = 0; i < MAX_NUM_LAYER_IDS; i++)
   {
@@ -932,6 +935,9 @@ void DecApp::xCreateDecLib()
 #endif
   m_cDecLib.m_targetSubPicIdx = this->m_targetSubPicIdx;
   m_cDecLib.initScalingList();
+#if EXTENSION_360_VIDEO && !RExt__DECODER_DEBUG_STATISTICS
+  m_ext360 = new TExt360AppDecTop(*this);
+#endif
 #if GDR_LEAK_TEST
   m_cDecLib.m_gdrPocRandomAccess = this->m_gdrPocRandomAccess;
 #endif // GDR_LEAK_TEST
@@ -939,6 +945,11 @@ void DecApp::xCreateDecLib()
 
 void DecApp::xDestroyDecLib()
 {
+#if EXTENSION_360_VIDEO && !RExt__DECODER_DEBUG_STATISTICS
+  // writes the pictures still queued for the rendering;
+  delete m_ext360;
+  m_ext360 = nullptr;
+#endif
   if( !m_reconFileName.empty() )
   {
     for( auto & recFile : m_cVideoIOYuvReconFile )
@@ -1136,6 +1147,12 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
               m_clipOutputVideoToRec709Range);
             }
         }
+#if EXTENSION_360_VIDEO && !RExt__DECODER_DEBUG_STATISTICS
+        if (m_ext360->isEnabled())
+        {
+          m_ext360->write(*pcPic);
+        }
+#endif
         // Perform FGS on decoded frame and write to output FGS file
         if (!m_SEIFGSFileName.empty())
         {
@@ -1351,6 +1368,12 @@ void DecApp::xFlushOutput( PicList* pcListPic, const int layerId )
                 m_clipOutputVideoToRec709Range);
               }
           }
+#if EXTENSION_360_VIDEO && !RExt__DECODER_DEBUG_STATISTICS
+          if (m_ext360->isEnabled())
+          {
+            m_ext360->write(*pcPic);
+          }
+#endif
           // Perform FGS on decoded frame and write to output FGS file
           if (!m_SEIFGSFileName.empty())
           {
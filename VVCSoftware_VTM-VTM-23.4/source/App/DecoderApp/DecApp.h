@@ -44,6 +44,9 @@
 #include "CommonLib/Picture.h"
 #include "DecoderLib/DecLib.h"
 #include "DecAppCfg.h"
+#if EXTENSION_360_VIDEO && !RExt__DECODER_DEBUG_STATISTICS
+#include "AppDecHelper360/TExt360AppDecTop.h"
+#endif
 
 //! \ingroup DecoderApp
 //! \{
@@ -90,6 +93,10 @@ private:
   std::map<uint32_t, SEIAnnotatedRegions::AnnotatedRegionObject> m_arObjects; ///< AR object pool
   std::map<uint32_t, std::string>                                m_arLabels; ///< AR label pool
 
+#if EXTENSION_360_VIDEO && !RExt__DECODER_DEBUG_STATISTICS
+  TExt360AppDecTop* m_ext360;                     ///< renders the output pictures to the source geometry
+#endif
+
 private:
   bool  xIsNaluWithinTargetDecLayerIdSet( const InputNALUnit* nalu ) const; ///< check whether given Nalu is within targetDecLayerIdSet
   bool  xIsNaluWithinTargetOutputLayerIdSet( const InputNALUnit* nalu ) const; ///< check whether given Nalu is within targetOutputLayerIdSet
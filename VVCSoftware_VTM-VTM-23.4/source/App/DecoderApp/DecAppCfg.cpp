@@ -135,6 +135,10 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
     ;
   // clang-format on
 
+#if EXTENSION_360_VIDEO && !RExt__DECODER_DEBUG_STATISTICS
+  m_ext360.addOptions(opts);
+#endif
+
   po::setDefaults(opts);
   po::ErrorReporter err;
   const std::list<const char *> &argv_unhandled = po::scanArgv(opts, argc, (const char **) argv, err);
@@ -249,6 +253,13 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
     m_targetOlsIdx = -1;
   }
 
+#if EXTENSION_360_VIDEO && !RExt__DECODER_DEBUG_STATISTICS
+  if (!m_ext360.processOptions())
+  {
+    return false;
+  }
+#endif
+
   return true;
 }
 
@@ -277,6 +288,9 @@ DecAppCfg::DecAppCfg()
   , m_packedYUVMode(false)
   , m_statMode(0)
   , m_mctsCheck(false)
+#if EXTENSION_360_VIDEO && !RExt__DECODER_DEBUG_STATISTICS
+  , m_ext360(*this)
+#endif
 {
   m_outputBitDepth.fill(0);
 }
@@ -42,6 +42,9 @@
 
 #include "CommonLib/CommonDef.h"
 #include <vector>
+#if EXTENSION_360_VIDEO && !RExt__DECODER_DEBUG_STATISTICS // DecoderAnalyserApp builds on CommonAnalyserLib, which Lib360 is not linked against
+#include "AppDecHelper360/TExt360AppDecCfg.h"
+#endif
 
 //! \ingroup DecoderApp
 //! \{
@@ -102,6 +105,11 @@ protected:
 #if GDR_LEAK_TEST
   int           m_gdrPocRandomAccess;                   ///<
 #endif // GDR_LEAK_TEST
+#if EXTENSION_360_VIDEO && !RExt__DECODER_DEBUG_STATISTICS
+  TExt360AppDecCfg m_ext360;
+  friend class TExt360AppDecCfg;
+  friend class TExt360AppDecTop;
+#endif
 public:
   DecAppCfg();
   virtual ~DecAppCfg();
@@ -0,0 +1,758 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     360BenchmarkAppCfg.cpp
+    \brief    Lib360 benchmark: configuration and timed conversion phases of synthetic pictures
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <sstream>
+#include "360BenchmarkAppCfg.h"
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/Picture.h"
+#include "Lib360/TGeometry.h"
+#include "Utilities/program_options_lite.h"
+#if SVIDEO_SPSNR_NN
+#include "Lib360/TSPSNRMetricCalc.h"
+#endif
+#if SVIDEO_WSPSNR
+#include "Lib360/TWSPSNRMetricCalc.h"
+#endif
+#if SVIDEO_SPSNR_I
+#include "Lib360/TSPSNRIMetricCalc.h"
+#endif
+#if SVIDEO_CPPPSNR
+#include "Lib360/TCPPPSNRMetricCalc.h"
+#endif
+#if SVIDEO_VIEWPORT_PSNR
+#include "Lib360/TViewPortPSNR.h"
+#endif
+#if defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+namespace po = ProgramOptionsLite;
+
+//! \ingroup TApp360Convert
+//! \{
+
+static inline ChromaFormat numberToChromaFormat(const Int val)
+{
+  switch (val)
+  {
+  case 400: return ChromaFormat::_400; break;
+  case 420: return ChromaFormat::_420; break;
+  case 422: return ChromaFormat::_422; break;
+  case 444: return ChromaFormat::_444; break;
+  default:  return ChromaFormat::UNDEFINED;
+  }
+}
+
+static inline Int chromaFormatToNumber(const ChromaFormat fmt)
+{
+  static const Int chromaFormatId[] = { 400, 420, 422, 444 };
+  return chromaFormatId[Int(fmt)];
+}
+
+// list of integers separated by spaces or commas;
+static Bool parseIntList(const string &str, vector<Int> &list)
+{
+  string s = str;
+  replace(s.begin(), s.end(), ',', ' ');
+  istringstream iss(s);
+  Int iVal;
+  list.clear();
+  while (iss >> iVal)
+  {
+    list.push_back(iVal);
+  }
+  return iss.eof() && !list.empty();
+}
+
+// high-water mark of the resident memory of the process in bytes; 0: unknown;
+static int64_t getPeakResidentBytes()
+{
+#if defined(__linux__)
+  FILE *fp = fopen("/proc/self/status", "r");
+  if (!fp)
+  {
+    return 0;
+  }
+  TChar line[256];
+  long long iPeakKB = 0;
+  while (fgets(line, sizeof(line), fp))
+  {
+    if (!strncmp(line, "VmHWM:", 6))
+    {
+      sscanf(line + 6, "%lld", &iPeakKB);
+      break;
+    }
+  }
+  fclose(fp);
+  return (int64_t)iPeakKB * 1024;
+#elif defined(__APPLE__)
+  struct rusage usage;
+  return getrusage(RUSAGE_SELF, &usage) ? 0 : (int64_t)usage.ru_maxrss;
+#else
+  return 0;
+#endif
+}
+
+// restart the high-water mark from the current resident memory; only Linux supports it, elsewhere the mark covers the
+// whole run;
+static Bool resetPeakResident()
+{
+#if defined(__linux__)
+  FILE *fp = fopen("/proc/self/clear_refs", "w");
+  if (!fp)
+  {
+    return false;
+  }
+  Bool bOk = fputs("5", fp) >= 0;
+  bOk = (fclose(fp) == 0) && bOk;
+  return bOk;
+#else
+  return false;
+#endif
+}
+
+// ====================================================================================================================
+// Constructor / destructor
+// ====================================================================================================================
+
+TApp360BenchmarkCfg::TApp360BenchmarkCfg()
+: m_iSphNumPoints(0)
+, m_iPictureWidth(0)
+, m_iPictureHeight(0)
+, m_iBitDepth(8)
+, m_chromaFormatIDC(ChromaFormat::_420)
+, m_internalChromaFormatIDC(ChromaFormat::_420)
+, m_iIterations(1)
+, m_iNumThreads(1)
+, m_bMetrics(true)
+, m_iViewPortWidth(0)
+, m_iViewPortHeight(0)
+, m_bPeakResidentReset(false)
+{
+}
+
+TApp360BenchmarkCfg::~TApp360BenchmarkCfg()
+{
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** \param  argc        number of arguments
+    \param  argv        array of arguments
+    \retval             true when success
+ */
+Bool TApp360BenchmarkCfg::parseCfg( Int argc, TChar* argv[] )
+{
+  Bool do_help = false;
+  string cfg_Geometries;
+  string cfg_Interpolations;
+  Int tmpChromaFormat;
+  Int tmpInternalChromaFormat;
+
+  po::Options opts;
+  opts.addOptions()
+  ("help",                    do_help,                   false,                          "this help text")
+  ("c",                       po::parseConfigFile,                                       "configuration file name")
+  ("OutputFile,o",            m_benchmarkFile,           string("360Benchmark.json"),    "JSON report of the benchmark")
+  ("SourceWidth,-wdt",        m_iPictureWidth,           2048,                           "Width of the synthetic ERP picture")
+  ("SourceHeight,-hgt",       m_iPictureHeight,          1024,                           "Height of the synthetic ERP picture")
+  ("InputBitDepth",           m_iBitDepth,               8,                              "Bit depth of the synthetic picture and of the conversions")
+  ("InputChromaFormat",       tmpChromaFormat,           420,                            "Chroma format of the synthetic picture and of the converted pictures")
+  ("InternalChromaFormat",    tmpInternalChromaFormat,   0,                              "Internal chroma format of the conversions; 0: same as InputChromaFormat")
+  ("Geometries",              cfg_Geometries,            string("1 2 3 5 8 9 10 11 12 13 15"), "Coding geometries of the matrix (viewport, CPP and fisheye are not supported)")
+  ("Interpolations",          cfg_Interpolations,        string("5 2 1"),                "Luma interpolation filters of the matrix (1: NN, 2: bilinear, 3: bicubic, 4: lanczos2, 5: lanczos3); chroma uses lanczos2 with lanczos3, otherwise the luma filter")
+  ("Iterations",              m_iIterations,             3,                              "Repetitions of every timed phase; the geometry mappings are timed once")
+  ("GeoConvertThreads",       m_iNumThreads,             1,                              "Number of threads of the geometry conversions")
+  ("Metrics",                 m_bMetrics,                true,                           "Time the S-PSNR-NN, WS-PSNR, S-PSNR-I, CPP-PSNR and viewport PSNR metrics")
+  ("SphFile",                 m_sphFile,                 string(""),                     "Spherical points data file of S-PSNR-NN/S-PSNR-I; empty: generated next to the report")
+  ("SphNumPoints",            m_iSphNumPoints,           655362,                         "Number of the generated sphere points")
+  ("ViewPortWidth",           m_iViewPortWidth,          0,                              "Width of the viewports of the viewport PSNR; 0: half the picture height")
+  ("ViewPortHeight",          m_iViewPortHeight,         0,                              "Height of the viewports of the viewport PSNR; 0: half the picture height")
+  ;
+
+  po::setDefaults(opts);
+  po::ErrorReporter err;
+  const list<const TChar*>& argv_unhandled = po::scanArgv(opts, argc, (const TChar**) argv, err);
+
+  for (list<const TChar*>::const_iterator it = argv_unhandled.begin(); it != argv_unhandled.end(); it++)
+  {
+    fprintf(stderr, "Unhandled argument ignored: `%s'\n", *it);
+  }
+
+  if (do_help)
+  {
+    po::doHelp(cout, opts);
+    return false;
+  }
+  if (err.is_errored)
+  {
+    return false;
+  }
+
+  m_chromaFormatIDC         = numberToChromaFormat(tmpChromaFormat);
+  m_internalChromaFormatIDC = (tmpInternalChromaFormat == 0) ? m_chromaFormatIDC : numberToChromaFormat(tmpInternalChromaFormat);
+  // same rules as the conversion tool: 4:4:4 and 4:0:0 pictures are converted in their own format;
+  if (m_chromaFormatIDC == ChromaFormat::_444 || m_chromaFormatIDC == ChromaFormat::_400)
+  {
+    m_internalChromaFormatIDC = m_chromaFormatIDC;
+  }
+
+  Bool bError = false;
+  if (m_chromaFormatIDC == ChromaFormat::UNDEFINED || m_internalChromaFormatIDC == ChromaFormat::UNDEFINED)
+  {
+    printf("Error: invalid chroma format.\n");
+    bError = true;
+  }
+  if (m_iPictureWidth <= 0 || m_iPictureHeight <= 0 || (m_iPictureWidth & 7) || (m_iPictureHeight & 7))
+  {
+    printf("Error: SourceWidth and SourceHeight must be positive multiples of 8.\n");
+    bError = true;
+  }
+  if (m_iBitDepth < 8 || m_iBitDepth > 16)
+  {
+    printf("Error: InputBitDepth must be in the range of [8, 16].\n");
+    bError = true;
+  }
+  if (m_iIterations < 1 || m_iNumThreads < 1)
+  {
+    printf("Error: Iterations and GeoConvertThreads must be positive.\n");
+    bError = true;
+  }
+  if (!parseIntList(cfg_Geometries, m_geometryTypes))
+  {
+    printf("Error: invalid Geometries \"%s\".\n", cfg_Geometries.c_str());
+    bError = true;
+  }
+  for (size_t i = 0; i < m_geometryTypes.size(); i++)
+  {
+    const Int iGeoType = m_geometryTypes[i];
+    if (iGeoType < 0 || iGeoType >= SVIDEO_TYPE_NUM || iGeoType == SVIDEO_VIEWPORT
+#if SVIDEO_CPPPSNR
+        || iGeoType == SVIDEO_CRASTERSPARABOLIC
+#endif
+#if SVIDEO_FISHEYE
+        || iGeoType == SVIDEO_FISHEYE_CIRCULAR
+#endif
+       )
+    {
+      printf("Error: coding geometry %d is not supported by the benchmark.\n", iGeoType);
+      bError = true;
+    }
+  }
+  if (!parseIntList(cfg_Interpolations, m_interpolationTypes))
+  {
+    printf("Error: invalid Interpolations \"%s\".\n", cfg_Interpolations.c_str());
+    bError = true;
+  }
+  for (size_t i = 0; i < m_interpolationTypes.size(); i++)
+  {
+    if (m_interpolationTypes[i] < SI_NN || m_interpolationTypes[i] > SI_LANCZOS3)
+    {
+      printf("Error: interpolation filter %d is not supported.\n", m_interpolationTypes[i]);
+      bError = true;
+    }
+  }
+  if (m_sphFile.empty() && m_iSphNumPoints <= 0)
+  {
+    printf("Error: SphNumPoints must be positive.\n");
+    bError = true;
+  }
+  if (m_iViewPortWidth <= 0)
+  {
+    m_iViewPortWidth = m_iPictureHeight >> 1;
+  }
+  if (m_iViewPortHeight <= 0)
+  {
+    m_iViewPortHeight = m_iPictureHeight >> 1;
+  }
+  return !bError;
+}
+
+/** runs every geometry/interpolation case of the matrix and writes the report
+    \retval             exit code of the application
+ */
+Int TApp360BenchmarkCfg::benchmark()
+{
+  Bool bGeneratedSph = false;
+  if (m_bMetrics && m_sphFile.empty())
+  {
+    m_sphFile = m_benchmarkFile + ".sph.txt";
+    if (!xWriteSphPoints(m_sphFile))
+    {
+      printf("Error: cannot write the sphere points to %s.\n", m_sphFile.c_str());
+      return 1;
+    }
+    bGeneratedSph = true;
+  }
+  else if (m_bMetrics)
+  {
+    FILE *fpSph = fopen(m_sphFile.c_str(), "r");
+    if (!fpSph || fscanf(fpSph, "%d", &m_iSphNumPoints) != 1)
+    {
+      printf("Error: cannot read the sphere points of %s.\n", m_sphFile.c_str());
+      if (fpSph)
+      {
+        fclose(fpSph);
+      }
+      return 1;
+    }
+    fclose(fpSph);
+  }
+
+  FILE *fp = fopen(m_benchmarkFile.c_str(), "w");
+  if (!fp)
+  {
+    printf("Error: cannot open the report file %s.\n", m_benchmarkFile.c_str());
+    if (bGeneratedSph)
+    {
+      remove(m_sphFile.c_str());
+    }
+    return 1;
+  }
+  m_bPeakResidentReset = resetPeakResident();
+
+  fprintf(fp, "{\n");
+  fprintf(fp, "  \"tool\": \"360BenchmarkApp\",\n");
+  fprintf(fp, "  \"version360Lib\": \"%s\",\n", VERSION_360Lib);
+  fprintf(fp, "  \"source\": { \"geometry\": \"ERP\", \"width\": %d, \"height\": %d, \"bitDepth\": %d, \"chromaFormat\": %d },\n",
+          m_iPictureWidth, m_iPictureHeight, m_iBitDepth, chromaFormatToNumber(m_chromaFormatIDC));
+  fprintf(fp, "  \"internalChromaFormat\": %d,\n", chromaFormatToNumber(m_internalChromaFormatIDC));
+  fprintf(fp, "  \"threads\": %d,\n", m_iNumThreads);
+  fprintf(fp, "  \"iterations\": %d,\n", m_iIterations);
+  fprintf(fp, "  \"sphPoints\": %d,\n", m_bMetrics ? m_iSphNumPoints : 0);
+  fprintf(fp, "  \"peakResidentPerCase\": %s,\n", m_bPeakResidentReset ? "true" : "false");
+  fprintf(fp, "  \"cases\": [");
+
+  Bool bFirst = true;
+  for (size_t g = 0; g < m_geometryTypes.size(); g++)
+  {
+    for (size_t i = 0; i < m_interpolationTypes.size(); i++)
+    {
+      xSetupCase(m_geometryTypes[g], m_interpolationTypes[i]);
+      xRunCase();
+      xWriteCase(fp, bFirst, m_geometryTypes[g], m_interpolationTypes[i]);
+      bFirst = false;
+      fflush(fp);
+    }
+  }
+
+  fprintf(fp, "\n  ]\n}\n");
+  fclose(fp);
+  if (bGeneratedSph)
+  {
+    remove(m_sphFile.c_str());
+  }
+  printf("\nReport written to %s\n", m_benchmarkFile.c_str());
+  return 0;
+}
+
+// ====================================================================================================================
+// Protected member functions
+// ====================================================================================================================
+
+Void TApp360BenchmarkCfg::xSetupCase(Int iGeoType, Int iInterp)
+{
+  memset(&m_sourceSVideoInfo, 0, sizeof(m_sourceSVideoInfo));
+  memset(&m_codingSVideoInfo, 0, sizeof(m_codingSVideoInfo));
+  m_sourceSVideoInfo.geoType = SVIDEO_EQUIRECT;
+  m_sourceSVideoInfo.iCompactFPStructure = 1;
+  m_codingSVideoInfo.geoType = iGeoType;
+  m_codingSVideoInfo.iCompactFPStructure = 1;
+  if (iGeoType == SVIDEO_OCTAHEDRON)
+  {
+    // frame packing of the common test conditions (encoder_360_COHP.cfg);
+    static const Int aiCOHPFaces[4][2][2] = { { { 2, 270 }, { 3, 90 } }, { { 6, 90 }, { 7, 270 } }, { { 0, 270 }, { 1, 90 } }, { { 4, 90 }, { 5, 270 } } };
+    SVideoFPStruct &frmPack = m_codingSVideoInfo.framePackStruct;
+    frmPack.rows = 4;
+    frmPack.cols = 2;
+    for (Int j = 0; j < frmPack.rows; j++)
+    {
+      for (Int i = 0; i < frmPack.cols; i++)
+      {
+        frmPack.faces[j][i].id  = aiCOHPFaces[j][i][0];
+        frmPack.faces[j][i].rot = aiCOHPFaces[j][i][1];
+      }
+    }
+  }
+  setDefaultFramePackingParam(m_sourceSVideoInfo);
+  setDefaultFramePackingParam(m_codingSVideoInfo);
+
+  for (ChannelType ch = ChannelType::LUMA; ch < ChannelType::NUM; ch++)
+  {
+    m_inputBitDepth[ch]       = m_iBitDepth;
+    m_MSBExtendedBitDepth[ch] = m_iBitDepth;
+    m_internalBitDepth[ch]    = m_iBitDepth;
+    m_outputBitDepth[ch]      = m_iBitDepth;
+    m_referenceBitDepth[ch]   = m_iBitDepth;
+  }
+  m_InputChromaFormatIDC  = m_chromaFormatIDC;
+  m_OutputChromaFormatIDC = m_chromaFormatIDC;
+  m_sourceSVideoInfo.framePackStruct.chromaFormatIDC = m_InputChromaFormatIDC;
+  m_codingSVideoInfo.framePackStruct.chromaFormatIDC = m_OutputChromaFormatIDC;
+
+  m_inputGeoParam.chromaFormat    = m_internalChromaFormatIDC;
+#if !SVIDEO_CHROMA_TYPES_SUPPORT
+  m_inputGeoParam.bResampleChroma = false;
+  m_inputGeoParam.iChromaSampleLocType = 2;
+#endif
+  m_inputGeoParam.nBitDepth       = m_iBitDepth;
+  m_inputGeoParam.nOutputBitDepth = m_iBitDepth;
+  m_inputGeoParam.iInterp[Int(ChannelType::LUMA)]   = iInterp;
+  m_inputGeoParam.iInterp[Int(ChannelType::CHROMA)] = (iInterp == SI_LANCZOS3) ? SI_LANCZOS2 : iInterp;
+#if SVIDEO_PARALLEL_PROCESSING
+  m_inputGeoParam.iNumThreads = m_iNumThreads;
+#endif
+#if SVIDEO_WEIGHT_MAP_CACHE
+  m_inputGeoParam.sWeightMapCacheDir.clear();
+  m_inputGeoParam.iWeightMapCacheMaxMB = 0;
+#endif
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+  m_inputGeoParam.bFastGeometryMapping = false;
+#endif
+#if SVIDEO_COMPACT_WEIGHT_MAP
+  m_inputGeoParam.bCompactWeightMap = false;
+#endif
+
+  m_iInputWidth  = m_iPictureWidth;
+  m_iInputHeight = m_iPictureHeight;
+  m_iCodingFaceWidth  = 0;
+  m_iCodingFaceHeight = 0;
+  m_faceSizeAlignment = 8;
+  if (iGeoType == SVIDEO_OCTAHEDRON)
+  {
+    // the automatic resolution of the conversion tool does not transpose the compact OHP frame; the faces of the same
+    // area are given explicitly as the common test conditions do;
+    const Int iSize = Int(sqrt((Double)m_iInputWidth * m_iInputHeight * 4 / (sqrt(3.0) * 8)));
+    m_iCodingFaceWidth  = ((iSize + m_faceSizeAlignment - 1) / m_faceSizeAlignment * m_faceSizeAlignment) >> 2 << 2;
+    m_iCodingFaceHeight = (((Int)(iSize * sqrt(3.0) / 2.0 + 0.5) + m_faceSizeAlignment - 1) / m_faceSizeAlignment * m_faceSizeAlignment) >> 2 << 2;
+  }
+  fillSourceSVideoInfo(m_sourceSVideoInfo, m_iInputWidth, m_iInputHeight);
+  calcOutputResolution(m_sourceSVideoInfo, m_codingSVideoInfo, m_iSourceWidth, m_iSourceHeight, m_faceSizeAlignment);
+
+#if SVIDEO_CPPPSNR
+  // the reference of S-PSNR-I and CPP-PSNR is the synthetic ERP picture;
+  memset(&m_referenceSVideoInfo, 0, sizeof(m_referenceSVideoInfo));
+  m_referenceSVideoInfo.geoType = SVIDEO_EQUIRECT;
+  m_referenceSVideoInfo.iCompactFPStructure = 1;
+  setDefaultFramePackingParam(m_referenceSVideoInfo);
+  m_ReferenceChromaFormatIDC = m_chromaFormatIDC;
+  m_referenceSVideoInfo.framePackStruct.chromaFormatIDC = m_ReferenceChromaFormatIDC;
+  m_iReferenceSourceWidth  = m_iPictureWidth;
+  m_iReferenceSourceHeight = m_iPictureHeight;
+  m_iReferenceFaceWidth    = m_iPictureWidth;
+  m_iReferenceFaceHeight   = m_iPictureHeight;
+  fillSourceSVideoInfo(m_referenceSVideoInfo, m_iReferenceSourceWidth, m_iReferenceSourceHeight);
+  m_cppPsnrWidth  = m_iPictureWidth;
+  m_cppPsnrHeight = m_iPictureHeight;
+#endif
+}
+
+Void TApp360BenchmarkCfg::xRunCase()
+{
+  m_phases.clear();
+  if (m_bPeakResidentReset)
+  {
+    resetPeakResident();
+  }
+  const int64_t iSrcSamples = (int64_t)m_iInputWidth * m_iInputHeight;
+  const int64_t iOutSamples = (int64_t)m_iSourceWidth * m_iSourceHeight;
+
+  PelStorage cPicYuvSrc, cPicYuvOut, cPicYuvBack;
+  cPicYuvSrc.create(m_InputChromaFormatIDC, Area(Position(), Size(m_iInputWidth, m_iInputHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+  cPicYuvOut.create(m_OutputChromaFormatIDC, Area(Position(), Size(m_iSourceWidth, m_iSourceHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+  cPicYuvBack.create(m_InputChromaFormatIDC, Area(Position(), Size(m_iInputWidth, m_iInputHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+  xFillPicture(cPicYuvSrc, 1);
+  // the frame packing leaves the samples outside of the faces untouched;
+  cPicYuvOut.fill(1 << (m_iBitDepth - 1));
+
+  TGeometry *pcInputGeometry  = TGeometry::create(m_sourceSVideoInfo, &m_inputGeoParam);
+  TGeometry *pcCodingGeometry = TGeometry::create(m_codingSVideoInfo, &m_inputGeoParam);
+  TGeometry *pcOutputGeometry = TGeometry::create(m_sourceSVideoInfo, &m_inputGeoParam);
+  m_caseGeoName = pcCodingGeometry->getGeoName();
+  const Bool bCompact = (m_codingSVideoInfo.geoType == SVIDEO_OCTAHEDRON || m_codingSVideoInfo.geoType == SVIDEO_ICOSAHEDRON) && m_codingSVideoInfo.iCompactFPStructure;
+
+  printf("\n%s (%dx%d), interpolation %d/%d:\n", m_caseGeoName.c_str(), m_iSourceWidth, m_iSourceHeight,
+         m_inputGeoParam.iInterp[Int(ChannelType::LUMA)], m_inputGeoParam.iInterp[Int(ChannelType::CHROMA)]);
+
+  // ERP to the coding geometry; the mapping is built once and reused by every iteration of geoConvert;
+  xTimePhase("forward.convertYuv", iSrcSamples, m_iIterations, [&]() { pcInputGeometry->convertYuv(&cPicYuvSrc); });
+  xTimePhase("forward.spherePadding", iSrcSamples, m_iIterations, [&]() { pcInputGeometry->spherePadding(true); });
+  xTimePhase("forward.geometryMapping", iOutSamples, 1, [&]() { pcCodingGeometry->geometryMapping(pcInputGeometry); });
+  xTimePhase("forward.geoConvert", iOutSamples, m_iIterations, [&]() { pcInputGeometry->geoConvert(pcCodingGeometry); });
+  xTimePhase("forward.framePack", iOutSamples, m_iIterations, [&]()
+  {
+    if (bCompact)
+    {
+      pcCodingGeometry->compactFramePack(&cPicYuvOut);
+    }
+    else
+    {
+      pcCodingGeometry->framePack(&cPicYuvOut);
+    }
+  });
+
+  // the coding geometry back to ERP;
+  xTimePhase("backward.convertYuv", iOutSamples, m_iIterations, [&]()
+  {
+    if (bCompact)
+    {
+      pcCodingGeometry->compactFramePackConvertYuv(&cPicYuvOut);
+    }
+    else
+    {
+      pcCodingGeometry->convertYuv(&cPicYuvOut);
+    }
+  });
+  xTimePhase("backward.spherePadding", iOutSamples, m_iIterations, [&]() { pcCodingGeometry->spherePadding(true); });
+  xTimePhase("backward.geometryMapping", iSrcSamples, 1, [&]() { pcOutputGeometry->geometryMapping(pcCodingGeometry); });
+  xTimePhase("backward.geoConvert", iSrcSamples, m_iIterations, [&]() { pcCodingGeometry->geoConvert(pcOutputGeometry); });
+  xTimePhase("backward.framePack", iSrcSamples, m_iIterations, [&]() { pcOutputGeometry->framePack(&cPicYuvBack); });
+
+  if (m_bMetrics)
+  {
+    // the metrics of the coding geometry compare the frame packed picture with a copy of small distortions, the
+    // cross-format metrics compare it with the synthetic ERP picture;
+    PelStorage cPicYuvRef;
+    cPicYuvRef.create(m_OutputChromaFormatIDC, Area(Position(), Size(m_iSourceWidth, m_iSourceHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+    cPicYuvRef.copyFrom(cPicYuvOut);
+    const Int iMaxVal = (1 << m_iBitDepth) - 1;
+    UInt uiState = 0x9e3779b9u;
+    for (Int c = 0; c < getNumberValidComponents(m_OutputChromaFormatIDC); c++)
+    {
+      PelBuf buf = cPicYuvRef.get(ComponentID(c));
+      for (Int y = 0; y < buf.height; y++)
+      {
+        Pel *pRow = buf.bufAt(0, y);
+        for (Int x = 0; x < buf.width; x++)
+        {
+          uiState = uiState * 1664525u + 1013904223u;
+          pRow[x] = (Pel)Clip3(0, iMaxVal, pRow[x] + (Int)((uiState >> 24) % 5) - 2);
+        }
+      }
+    }
+
+#if SVIDEO_SPSNR_NN
+    {
+      TSPSNRMetric cSPSNRCalc;
+      cSPSNRCalc.setSPSNREnabledFlag(true);
+      cSPSNRCalc.setOutputBitDepth(m_outputBitDepth);
+      cSPSNRCalc.setReferenceBitDepth(m_referenceBitDepth);
+      xTimePhase("TSPSNRMetric.init", m_iSphNumPoints, 1, [&]()
+      {
+        cSPSNRCalc.sphSampoints(m_sphFile);
+        cSPSNRCalc.createTable(pcCodingGeometry);
+      });
+      xTimePhase("TSPSNRMetric.calculate", m_iSphNumPoints, m_iIterations, [&]() { cSPSNRCalc.xCalculateSPSNR(cPicYuvRef, cPicYuvOut); });
+    }
+#endif
+#if SVIDEO_WSPSNR
+    {
+      TWSPSNRMetric cWSPSNRCalc;
+      cWSPSNRCalc.setWSPSNREnabledFlag(true);
+      cWSPSNRCalc.setOutputBitDepth(m_outputBitDepth);
+      cWSPSNRCalc.setReferenceBitDepth(m_referenceBitDepth);
+      xTimePhase("TWSPSNRMetric.init", iOutSamples, 1, [&]()
+      {
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+        cWSPSNRCalc.setCodingGeoInfo(*pcCodingGeometry->getSVideoInfo());
+#else
+        cWSPSNRCalc.setCodingGeoInfo(*pcCodingGeometry->getSVideoInfo(), m_inputGeoParam.iChromaSampleLocType);
+#endif
+        cWSPSNRCalc.createTable(&cPicYuvRef, pcCodingGeometry);
+      });
+      xTimePhase("TWSPSNRMetric.calculate", iOutSamples, m_iIterations, [&]() { cWSPSNRCalc.xCalculateWSPSNR(&cPicYuvRef, &cPicYuvOut); });
+    }
+#endif
+#if SVIDEO_SPSNR_I
+    {
+      TSPSNRIMetric cSPSNRICalc;
+      cSPSNRICalc.setSPSNRIEnabledFlag(true);
+      cSPSNRICalc.setOutputBitDepth(m_outputBitDepth);
+      cSPSNRICalc.setReferenceBitDepth(m_referenceBitDepth);
+      xTimePhase("TSPSNRIMetric.init", m_iSphNumPoints, 1, [&]()
+      {
+        cSPSNRICalc.init(m_inputGeoParam, m_codingSVideoInfo, m_referenceSVideoInfo, m_iSourceWidth, m_iSourceHeight, m_iReferenceSourceWidth, m_iReferenceSourceHeight);
+        cSPSNRICalc.sphSampoints(m_sphFile);
+        cSPSNRICalc.createTable(&cPicYuvSrc, pcCodingGeometry);
+      });
+      xTimePhase("TSPSNRIMetric.calculate", m_iSphNumPoints, m_iIterations, [&]() { cSPSNRICalc.xCalculateSPSNRI(&cPicYuvSrc, &cPicYuvOut); });
+    }
+#endif
+#if SVIDEO_CPPPSNR
+    {
+      TCPPPSNRMetric cCPPPSNRCalc;
+      cCPPPSNRCalc.setCPPPSNREnabledFlag(true);
+      cCPPPSNRCalc.setOutputBitDepth(m_outputBitDepth);
+      cCPPPSNRCalc.setReferenceBitDepth(m_referenceBitDepth);
+      const int64_t iCppSamples = (int64_t)m_cppPsnrWidth * m_cppPsnrHeight;
+      xTimePhase("TCPPPSNRMetric.init", iCppSamples, 1, [&]()
+      {
+        cCPPPSNRCalc.initCPPPSNR(m_inputGeoParam, m_cppPsnrWidth, m_cppPsnrHeight, m_codingSVideoInfo, m_referenceSVideoInfo);
+      });
+      xTimePhase("TCPPPSNRMetric.calculate", iCppSamples, m_iIterations, [&]() { cCPPPSNRCalc.xCalculateCPPPSNR(&cPicYuvSrc, &cPicYuvOut); });
+    }
+#endif
+#if SVIDEO_VIEWPORT_PSNR && SVIDEO_E2E_METRICS
+    {
+      // a front view and a view tilted to the side;
+      ViewPortPSNRParam viewPortPSNRParam;
+      viewPortPSNRParam.bViewPortPSNREnabled = true;
+      viewPortPSNRParam.iViewPortWidth  = m_iViewPortWidth;
+      viewPortPSNRParam.iViewPortHeight = m_iViewPortHeight;
+      viewPortPSNRParam.viewPortSettingsList.push_back({ 90.0f, 90.0f, 0.0f, 0.0f });
+      viewPortPSNRParam.viewPortSettingsList.push_back({ 90.0f, 90.0f, 90.0f, 30.0f });
+      const int64_t iViewPortSamples = (int64_t)m_iViewPortWidth * m_iViewPortHeight * (Int)viewPortPSNRParam.viewPortSettingsList.size();
+      Picture cPic;
+      cPic.create(false, m_OutputChromaFormatIDC, Size(m_iSourceWidth, m_iSourceHeight), 0, 0, true, 0, false);
+      cPic.getRecoBuf().copyFrom(cPicYuvOut);
+      TViewPortPSNR cViewPortPSNRCalc;
+      xTimePhase("TViewPortPSNR.init", iViewPortSamples, 1, [&]()
+      {
+        cViewPortPSNRCalc.init(m_sourceSVideoInfo, m_codingSVideoInfo, &m_inputGeoParam, viewPortPSNRParam);
+      });
+      xTimePhase("TViewPortPSNR.calculate", iViewPortSamples, m_iIterations, [&]() { cViewPortPSNRCalc.xCalculatePSNR(&cPic, &cPicYuvSrc); });
+      cPic.destroy();
+    }
+#endif
+    cPicYuvRef.destroy();
+  }
+
+  delete pcInputGeometry;
+  delete pcCodingGeometry;
+  delete pcOutputGeometry;
+  cPicYuvSrc.destroy();
+  cPicYuvOut.destroy();
+  cPicYuvBack.destroy();
+}
+
+Void TApp360BenchmarkCfg::xTimePhase(const std::string &name, int64_t iSamples, Int iIterations, const std::function<Void()> &phase)
+{
+  BenchmarkPhase cPhase;
+  cPhase.name        = name;
+  cPhase.iSamples    = iSamples;
+  cPhase.iIterations = iIterations;
+  cPhase.iTotalNs    = 0;
+  cPhase.iMinNs      = INT64_MAX;
+  for (Int i = 0; i < iIterations; i++)
+  {
+    const std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+    phase();
+    const int64_t iNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tStart).count();
+    cPhase.iTotalNs += iNs;
+    cPhase.iMinNs    = std::min(cPhase.iMinNs, iNs);
+  }
+  cPhase.iPeakResidentBytes = getPeakResidentBytes();
+  m_phases.push_back(cPhase);
+
+  printf("  %-26s %12.3f ms %10.3f ns/sample %8.1f MB\n", name.c_str(), cPhase.iTotalNs / (1e6 * iIterations),
+         (Double)cPhase.iTotalNs / iIterations / std::max<int64_t>(iSamples, 1), cPhase.iPeakResidentBytes / (1024.0 * 1024.0));
+}
+
+// smooth gradients of every component with a small pseudo random texture; the same seed gives the same picture;
+Void TApp360BenchmarkCfg::xFillPicture(PelUnitBuf &buf, UInt uiSeed)
+{
+  const Int iMaxVal = (1 << m_iBitDepth) - 1;
+  UInt uiState = uiSeed;
+  for (Int c = 0; c < getNumberValidComponents(buf.chromaFormat); c++)
+  {
+    PelBuf plane = buf.get(ComponentID(c));
+    for (Int y = 0; y < plane.height; y++)
+    {
+      Pel *pRow = plane.bufAt(0, y);
+      for (Int x = 0; x < plane.width; x++)
+      {
+        uiState = uiState * 1664525u + 1013904223u;
+        const Int iGradient = ((x * (c + 1) * 3 + y * 2) * iMaxVal) / (plane.width * 3 + plane.height * 2);
+        pRow[x] = (Pel)Clip3(0, iMaxVal, iGradient + (Int)((uiState >> 24) & 15) - 8);
+      }
+    }
+  }
+}
+
+// points of a Fibonacci spiral, evenly spread over the sphere; first line the number of points, then latitude and
+// longitude in degrees, as the sphere files of the common test conditions;
+Bool TApp360BenchmarkCfg::xWriteSphPoints(const std::string &fileName)
+{
+  FILE *fp = fopen(fileName.c_str(), "w");
+  if (!fp)
+  {
+    return false;
+  }
+  fprintf(fp, "%d\n", m_iSphNumPoints);
+  const Double dGoldenAngle = 180.0 * (3.0 - sqrt(5.0));
+  for (Int i = 0; i < m_iSphNumPoints; i++)
+  {
+    const Double dLat = asin(1.0 - (2.0 * i + 1.0) / m_iSphNumPoints) * 180.0 / S_PI;
+    const Double dLon = fmod(i * dGoldenAngle, 360.0) - 180.0;
+    fprintf(fp, "%.6f %.6f\n", dLat, dLon);
+  }
+  return fclose(fp) == 0;
+}
+
+Void TApp360BenchmarkCfg::xWriteCase(FILE *fp, Bool bFirst, Int iGeoType, Int iInterp)
+{
+  fprintf(fp, "%s\n    {\n", bFirst ? "" : ",");
+  fprintf(fp, "      \"geometry\": \"%s\",\n", m_caseGeoName.c_str());
+  fprintf(fp, "      \"geometryType\": %d,\n", iGeoType);
+  fprintf(fp, "      \"codingWidth\": %d,\n", m_iSourceWidth);
+  fprintf(fp, "      \"codingHeight\": %d,\n", m_iSourceHeight);
+  fprintf(fp, "      \"faceWidth\": %d,\n", m_codingSVideoInfo.iFaceWidth);
+  fprintf(fp, "      \"faceHeight\": %d,\n", m_codingSVideoInfo.iFaceHeight);
+  fprintf(fp, "      \"interpolationLuma\": %d,\n", iInterp);
+  fprintf(fp, "      \"interpolationChroma\": %d,\n", m_inputGeoParam.iInterp[Int(ChannelType::CHROMA)]);
+  fprintf(fp, "      \"phases\": [");
+  for (size_t i = 0; i < m_phases.size(); i++)
+  {
+    const BenchmarkPhase &cPhase = m_phases[i];
+    fprintf(fp, "%s\n        { \"name\": \"%s\", \"samples\": %lld, \"iterations\": %d, \"totalNs\": %lld, \"minNs\": %lld, \"nsPerSample\": %.4f, \"peakResidentBytes\": %lld }",
+            i ? "," : "", cPhase.name.c_str(), (long long)cPhase.iSamples, cPhase.iIterations, (long long)cPhase.iTotalNs, (long long)cPhase.iMinNs,
+            (Double)cPhase.iTotalNs / cPhase.iIterations / std::max<int64_t>(cPhase.iSamples, 1), (long long)cPhase.iPeakResidentBytes);
+  }
+  fprintf(fp, "\n      ]\n    }");
+}
+
+//! \}
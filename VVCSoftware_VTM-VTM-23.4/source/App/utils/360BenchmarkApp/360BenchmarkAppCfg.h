@@ -0,0 +1,109 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     360BenchmarkAppCfg.h
+    \brief    Lib360 benchmark: configuration and timed conversion phases of synthetic pictures (header)
+*/
+
+#ifndef __TAPP360BENCHMARKCFG__
+#define __TAPP360BENCHMARKCFG__
+
+#include "360ConvertAppCfg.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+//! \ingroup TApp360Convert
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// timing of one phase of a benchmark case; the samples are the units the phase works on (luma samples of the
+/// picture it produces or reads, sphere points of the spherical metrics);
+struct BenchmarkPhase
+{
+  std::string name;
+  int64_t     iSamples;
+  Int         iIterations;
+  int64_t     iTotalNs;
+  int64_t     iMinNs;
+  int64_t     iPeakResidentBytes;   ///< high-water mark of the resident memory of the case after this phase; 0: unknown
+};
+
+/// benchmark of the Lib360 conversions and metrics: every coding geometry of the list is converted from and back to a
+/// synthetic ERP picture with every interpolation filter of the list; the geometry set up of the conversion tool is reused
+class TApp360BenchmarkCfg : public TApp360ConvertCfg
+{
+protected:
+  std::string      m_benchmarkFile;                           ///< JSON report
+  std::string      m_sphFile;                                 ///< sphere points of S-PSNR-NN/S-PSNR-I; empty: generated
+  Int              m_iSphNumPoints;                           ///< number of the generated sphere points
+  std::vector<Int> m_geometryTypes;                           ///< coding geometries of the matrix
+  std::vector<Int> m_interpolationTypes;                      ///< luma interpolation filters of the matrix
+  Int              m_iPictureWidth;                           ///< synthetic ERP picture
+  Int              m_iPictureHeight;
+  Int              m_iBitDepth;
+  ChromaFormat     m_chromaFormatIDC;
+  ChromaFormat     m_internalChromaFormatIDC;
+  Int              m_iIterations;                             ///< repetitions of every timed phase
+  Int              m_iNumThreads;                             ///< GeoConvertThreads of the conversions
+  Bool             m_bMetrics;
+  Int              m_iViewPortWidth;
+  Int              m_iViewPortHeight;
+  Bool             m_bPeakResidentReset;                      ///< the high-water mark is reset for every case
+  std::string      m_caseGeoName;                             ///< coding geometry of the current case
+  std::vector<BenchmarkPhase> m_phases;                       ///< phases of the current case
+
+  Void xSetupCase       (Int iGeoType, Int iInterp);          ///< coding geometry and conversion parameters of one case
+  Void xRunCase         ();                                   ///< timed phases of the current case into m_phases
+  Void xTimePhase       (const std::string &name, int64_t iSamples, Int iIterations, const std::function<Void()> &phase);
+  Void xFillPicture     (PelUnitBuf &buf, UInt uiSeed);       ///< deterministic synthetic content
+  Bool xWriteSphPoints  (const std::string &fileName);        ///< spiral sphere points in the SphFile format
+  Void xWriteCase       (FILE *fp, Bool bFirst, Int iGeoType, Int iInterp);
+
+public:
+  TApp360BenchmarkCfg();
+  virtual ~TApp360BenchmarkCfg();
+
+  Bool  parseCfg  ( Int argc, TChar* argv[] );                ///< parse the benchmark options
+  Int   benchmark ();                                         ///< run the matrix and write the report; returns the exit code
+};// END CLASS DEFINITION TApp360BenchmarkCfg
+
+//! \}
+
+#endif // __TAPP360BENCHMARKCFG__
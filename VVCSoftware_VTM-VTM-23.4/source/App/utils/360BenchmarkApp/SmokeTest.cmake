@@ -0,0 +1,29 @@
+# smoke test of 360BenchmarkApp: runs one small cubemap case and checks its JSON report;
+# usage: cmake -DBENCHMARK_APP=<executable> -DREPORT=<report file> -P SmokeTest.cmake
+
+file( REMOVE ${REPORT} )
+execute_process( COMMAND ${BENCHMARK_APP} --SourceWidth=256 --SourceHeight=128 --Geometries=1 --Interpolations=5 --Iterations=1 --SphNumPoints=500
+                         -o ${REPORT}
+                 RESULT_VARIABLE RESULT )
+if( NOT RESULT EQUAL 0 )
+  message( FATAL_ERROR "360BenchmarkApp failed: ${RESULT}" )
+endif()
+if( NOT EXISTS ${REPORT} )
+  message( FATAL_ERROR "no report: ${REPORT}" )
+endif()
+
+file( READ ${REPORT} JSON )
+if( NOT JSON MATCHES "\"tool\": \"360BenchmarkApp\"" )
+  message( FATAL_ERROR "${REPORT}: not a 360BenchmarkApp report" )
+endif()
+if( NOT JSON MATCHES "\"geometryType\": 1," )
+  message( FATAL_ERROR "${REPORT}: no case of geometry 1" )
+endif()
+
+# every conversion phase of the case is timed per sample and has its memory high-water mark;
+foreach( PHASE forward.convertYuv forward.spherePadding forward.geometryMapping forward.geoConvert forward.framePack
+               backward.convertYuv backward.spherePadding backward.geometryMapping backward.geoConvert backward.framePack )
+  if( NOT JSON MATCHES "\"name\": \"${PHASE}\", \"samples\": [1-9][0-9]*, [^}]*\"nsPerSample\": [0-9]+\\.[0-9]+, \"peakResidentBytes\": [1-9][0-9]*" )
+    message( FATAL_ERROR "${REPORT}: phase ${PHASE} lacks samples, nsPerSample or peakResidentBytes" )
+  endif()
+endforeach()
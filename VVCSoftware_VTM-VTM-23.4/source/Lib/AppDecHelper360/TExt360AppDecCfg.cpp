@@ -0,0 +1,228 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "TExt360AppDecCfg.h"
+#include "Lib360/TGeometry.h"
+#include "Lib360/TSVideoInfoCfg.h"
+#include "../Utilities/program_options_lite.h"
+#include "../App/DecoderApp/DecAppCfg.h"
+#include <sstream>
+
+
+TExt360AppDecCfg::TExt360AppDecCfg(DecAppCfg &cfg) : m_cfg(cfg)
+{
+}
+
+TExt360AppDecCfg::~TExt360AppDecCfg()
+{
+}
+
+Void TExt360AppDecCfg::addOptions(ProgramOptionsLite::Options &opts)
+{
+  memset(&m_sourceSVideoInfo, 0, sizeof(m_sourceSVideoInfo));
+  memset(&m_codingSVideoInfo, 0, sizeof(m_codingSVideoInfo));
+  m_inputGeoParam.chromaFormat = ChromaFormat::_444;
+#if !SVIDEO_CHROMA_TYPES_SUPPORT
+  m_inputGeoParam.bResampleChroma = false;
+#endif
+  m_inputGeoParam.nBitDepth = 8;
+  m_inputGeoParam.iInterp[0] = SI_LANCZOS3;
+  m_inputGeoParam.iInterp[1] = SI_LANCZOS2;
+#if SVIDEO_PARALLEL_PROCESSING
+  m_inputGeoParam.iNumThreads = 1;
+#endif
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+  m_inputGeoParam.bFastGeometryMapping = false;
+#endif
+#if SVIDEO_COMPACT_WEIGHT_MAP
+  m_inputGeoParam.bCompactWeightMap = false;
+#endif
+#if SVIDEO_DECODER_RENDER_THREAD
+  m_iRenderQueue = 0;
+#endif
+
+  opts.addOptions()
+  ("SphereVideo,-360vid",                        m_bSVideo,                           false,                                "Render the output pictures from the coding geometry to the source geometry")
+  ("SphereVideoFile,-360o",                      m_renderFileName,                    std::string(""),                      "Rendered YUV output file name")
+  ("SourceWidth,-wdt",                           m_iSourceWidth,                      0,                                    "Width of the rendered pictures (source picture width)")
+  ("SourceHeight,-hgt",                          m_iSourceHeight,                     0,                                    "Height of the rendered pictures (source picture height)")
+  ("InputGeometryType",                          m_sourceSVideoInfo.geoType,          0,                                    "The geometry of the rendered 360 video")
+#if SVIDEO_HEMI_PROJECTIONS
+  ("InputGeometryHemiFlag",                      m_sourceSVideoInfo.hemiFlag,         0,                                    "Hemisphere flag of the rendered video")
+#endif
+  ("SourceFPStructure",                          m_sourceSVideoInfo.framePackStruct,  m_sourceSVideoInfo.framePackStruct,   "Source framepacking structure")
+  ("SourceCompactFPStructure",                   m_sourceSVideoInfo.iCompactFPStructure, 1,                             "Compact source framepacking structure; only valid for octahedron and icosahedron projection format")
+  ("CodingGeometryType",                         m_codingSVideoInfo.geoType,          0,                                    "The geometry of the decoded pictures")
+#if SVIDEO_HEMI_PROJECTIONS
+  ("CodingGeometryHemiFlag",                     m_codingSVideoInfo.hemiFlag,         0,                                    "Hemisphere flag of the decoded pictures")
+#endif
+  ("CodingFPStructure",                          m_codingSVideoInfo.framePackStruct,  m_codingSVideoInfo.framePackStruct,   "Coding framepacking structure")
+  ("CodingCompactFPStructure",                   m_codingSVideoInfo.iCompactFPStructure, 1,                             "Compact coding framepacking structure; only valid for octahedron and icosahedron projection format")
+#if SVIDEO_ERP_PADDING
+  ("InputPERP",                                  m_sourceSVideoInfo.bPERP,            false,                                "enable PERP for the rendered video")
+  ("CodingPERP",                                 m_codingSVideoInfo.bPERP,            false,                                "enable PERP coding")
+#endif
+#if SVIDEO_ROT_FIX
+  ("SVideoRotation",                             m_codingSVideoInfo.sVideoRotation,   m_codingSVideoInfo.sVideoRotation,    "Rotation in (yaw, pitch, roll) the encoder applied, undone by the rendering")
+#else
+  ("SVideoRotation",                             m_codingSVideoInfo.sVideoRotation,   m_codingSVideoInfo.sVideoRotation,    "Rotation along X, Y, Z the encoder applied")
+#endif
+  ("InternalChromaFormat,-intercf",              m_iInternalChromaFormat,             0,                                    "InternalChromaFormatIDC of the conversion (400|420|422|444 or set 0 (default) for the decoded one)")
+  ("InterpolationMethodY,-interpY",              m_inputGeoParam.iInterp[Int(ChannelType::LUMA)],   (Int)SI_LANCZOS3,            "Interpolation method for luma, 0: default setting(lanczos3); 1:NN, 2: bilinear, 3: bicubic, 4: lanczos2, 5: lanczos3")
+  ("InterpolationMethodC,-interpC",              m_inputGeoParam.iInterp[Int(ChannelType::CHROMA)], (Int)SI_LANCZOS2,            "Interpolation method for chroma, 0: default setting(lanczos2); 1:NN, 2: bilinear, 3: bicubic, 4: lanczos2, 5: lanczos3")
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+  ("ChromaSampleLocType,-csl",                   m_sourceSVideoInfo.framePackStruct.chromaSampleLocType, 0,                 "Chroma sample location type relative to luma of the rendered video, 0: 0.5 shift in vertical direction (default setting); 1: 0.5 shift in both directions, 2: aligned with luma, 3: 0.5 shift in horizontal direction")
+  ("CodingChromaSampleLocType",                  m_codingSVideoInfo.framePackStruct.chromaSampleLocType, 0,                 "Coding chroma sample location type relative to luma, 0: 0.5 shift in vertical direction (default setting); 1: 0.5 shift in both directions, 2: aligned with luma, 3: 0.5 shift in horizontal direction")
+#else
+  ("ResampleChroma,-rc",                         m_inputGeoParam.bResampleChroma,     false,                                "ResampleChroma indiates to do conversion with aligned phase with luma")
+  ("ChromaSampleLocType,-csl",                   m_inputGeoParam.iChromaSampleLocType, 2,                                   "Chroma sample location type relative to luma, 0: 0.5 shift in vertical direction; 1: 0.5 shift in both directions, 2: aligned with luma (default setting), 3: 0.5 shift in horizontal direction")
+#endif
+#if SVIDEO_PARALLEL_PROCESSING
+  ("GeoConvertThreads",                          m_inputGeoParam.iNumThreads,         1,                                    "Number of threads used for the 360 geometry conversion, 1: serial")
+#endif
+#if SVIDEO_WEIGHT_MAP_CACHE
+  ("WeightMapCacheDir",                          m_inputGeoParam.sWeightMapCacheDir,  std::string(""),                      "Directory of the on-disk geometry weight map cache, empty: disabled")
+  ("WeightMapCacheMaxMB",                        m_inputGeoParam.iWeightMapCacheMaxMB, 4096,                                "Size limit of the weight map cache in MB, the least recently used files are removed beyond it; 0: unlimited")
+#endif
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+  ("FastGeometryMapping",                        m_inputGeoParam.bFastGeometryMapping, false,                               "Generate the geometry weight maps with single-precision trigonometry (approximate)")
+#endif
+#if SVIDEO_COMPACT_WEIGHT_MAP
+  ("CompactWeightMap",                           m_inputGeoParam.bCompactWeightMap,   false,                               "Keep the geometry weight maps in the compact delta coded format (same output, less memory)")
+#endif
+#if SVIDEO_DECODER_RENDER_THREAD
+  ("SphereVideoRenderQueue",                     m_iRenderQueue,                      0,                                   "Number of output pictures queued for the rendering thread while the decoder goes on, 0: rendered when they are output")
+#endif
+#if SVIDEO_GENERALIZED_CUBEMAP
+  ("InputGCMPMappingType",                       m_sourceSVideoInfo.iGCMPMappingType,      0,                                   "Generalized cubemap projection mapping function type of the rendered video")
+  ("CodingGCMPMappingType",                      m_codingSVideoInfo.iGCMPMappingType,      0,                                   "Generalized cubemap projection mapping function type for coding")
+  ("InputGCMPSettings",                          m_sourceSVideoInfo.GCMPSettings,          m_sourceSVideoInfo.GCMPSettings,     "Generalized cubemap projection mapping coeffients of the rendered video")
+  ("CodingGCMPSettings",                         m_codingSVideoInfo.GCMPSettings,          m_codingSVideoInfo.GCMPSettings,     "Generalized cubemap projection mapping coeffients for coding")
+  ("InputGCMPPaddingFlag",                       m_sourceSVideoInfo.bPGCMP,                false,                               "Enable padded generalized cubemap projection format for the rendered video")
+  ("CodingGCMPPaddingFlag",                      m_codingSVideoInfo.bPGCMP,                false,                               "Enable padded generalized cubemap projection format for coding")
+#if SVIDEO_GCMP_PADDING_TYPE
+  ("InputGCMPPaddingType",                       m_sourceSVideoInfo.iPGCMPPaddingType,     1,                                   "Padding type of the rendered PGCMP, 0: unspecified; 1: repetitive padding; 2: copy from the neighboring face; 3: geometry padding")
+  ("CodingGCMPPaddingType",                      m_codingSVideoInfo.iPGCMPPaddingType,     1,                                   "Padding type of coding PGCMP, 0: unspecified; 1: repetitive padding; 2: copy from the neighboring face; 3: geometry padding")
+  ("InputGCMPPaddingExteriorFlag",               m_sourceSVideoInfo.bPGCMPBoundary,        false,                               "Enable boundary padding for the rendered PGCMP")
+  ("CodingGCMPPaddingExteriorFlag",              m_codingSVideoInfo.bPGCMPBoundary,        false,                               "Enable boundary padding for PGCMP coding")
+#else
+  ("InputGCMPPaddingBoundaryType",               m_sourceSVideoInfo.bPGCMPBoundary,        false,                               "Enable boundary padding for the rendered PGCMP")
+  ("CodingGCMPPaddingBoundaryType",              m_codingSVideoInfo.bPGCMPBoundary,        false,                               "Enable boundary padding for PGCMP coding")
+#endif
+  ("InputGCMPPaddingSize",                       m_sourceSVideoInfo.iPGCMPSize,            0,                                   "Padding size of the rendered PGCMP")
+  ("CodingGCMPPaddingSize",                      m_codingSVideoInfo.iPGCMPSize,            0,                                   "Padding size for PGCMP coding")
+#endif
+  ;
+}
+
+static inline ChromaFormat numberToChromaFormat(const Int val)
+{
+  switch (val)
+  {
+    case 400: return ChromaFormat::_400; break;
+    case 420: return ChromaFormat::_420; break;
+    case 422: return ChromaFormat::_422; break;
+    case 444: return ChromaFormat::_444; break;
+    default:  return ChromaFormat::NUM;
+  }
+}
+
+Bool TExt360AppDecCfg::processOptions()
+{
+  if(!m_bSVideo)
+  {
+    return true;
+  }
+  if (m_sourceSVideoInfo.geoType >= SVIDEO_TYPE_NUM)
+  {
+    printf( "InputGeometryType is invalid.\n" );
+    return false;
+  }
+#if SVIDEO_HEMI_PROJECTIONS
+  if (m_sourceSVideoInfo.hemiFlag == 1)
+  {
+    m_sourceSVideoInfo.geoType += HEMISPHERE_OFFSET;
+  }
+#endif
+  if (m_codingSVideoInfo.geoType >= SVIDEO_TYPE_NUM || m_codingSVideoInfo.geoType == SVIDEO_VIEWPORT)
+  {
+    printf( "CodingGeometryType is invalid.\n" );
+    return false;
+  }
+#if SVIDEO_HEMI_PROJECTIONS
+  if (m_codingSVideoInfo.hemiFlag == 1)
+  {
+    m_codingSVideoInfo.geoType += HEMISPHERE_OFFSET;
+  }
+#endif
+  if (m_renderFileName.empty())
+  {
+    printf( "SphereVideoFile is not specified.\n" );
+    return false;
+  }
+  if (m_iSourceWidth <= 0 || m_iSourceHeight <= 0)
+  {
+    printf( "SourceWidth and SourceHeight of the rendered pictures are not specified.\n" );
+    return false;
+  }
+  if (m_iInternalChromaFormat)
+  {
+    m_inputGeoParam.chromaFormat = numberToChromaFormat(m_iInternalChromaFormat);
+    if (m_inputGeoParam.chromaFormat == ChromaFormat::NUM)
+    {
+      printf( "InternalChromaFormat is invalid.\n" );
+      return false;
+    }
+  }
+#if SVIDEO_DECODER_RENDER_THREAD
+  if (m_iRenderQueue < 0)
+  {
+    printf( "SphereVideoRenderQueue must not be negative.\n" );
+    return false;
+  }
+#endif
+
+  TSVideoInfoCfg::setDefaultFramePackingParam(m_sourceSVideoInfo);
+  TSVideoInfoCfg::setDefaultFramePackingParam(m_codingSVideoInfo);
+
+  // the coding geometry is filled in from the size of the first output picture;
+  TSVideoInfoCfg::fillSVideoInfo(m_sourceSVideoInfo, m_iSourceWidth, m_iSourceHeight);
+  if((m_sourceSVideoInfo.geoType == SVIDEO_OCTAHEDRON || m_sourceSVideoInfo.geoType == SVIDEO_ICOSAHEDRON) && ((m_sourceSVideoInfo.iFaceWidth%4) != 0 || (m_sourceSVideoInfo.iFaceHeight%4) != 0))
+  {
+    printf("For OHP and ISP, face width and height (%d, %d) are not multiple of 4.\n", m_sourceSVideoInfo.iFaceWidth, m_sourceSVideoInfo.iFaceHeight);
+    return false;
+  }
+  return true;
+}
+
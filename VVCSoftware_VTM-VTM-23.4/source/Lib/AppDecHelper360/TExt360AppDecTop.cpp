@@ -0,0 +1,280 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "AppDecHelper360/TExt360AppDecTop.h"
+#include "../App/DecoderApp/DecAppCfg.h"
+#include "Lib360/TSVideoInfoCfg.h"
+
+TExt360AppDecTop::TExt360AppDecTop(DecAppCfg &cfg)
+  : m_cfg(cfg)
+  , m_pcCodingGeometry(nullptr)
+  , m_pcSourceGeometry(nullptr)
+  , m_iDecodedWidth(0)
+  , m_iDecodedHeight(0)
+  , m_iLayerId(0)
+  , m_bSkipWarned(false)
+#if SVIDEO_DECODER_RENDER_THREAD
+  , m_iNumQueued(0)
+  , m_iNumRendered(0)
+  , m_bRenderExit(false)
+#endif
+{
+}
+
+TExt360AppDecTop::~TExt360AppDecTop()
+{
+  xDestroy();
+}
+
+Bool TExt360AppDecTop::isEnabled() const
+{
+  return m_cfg.m_ext360.m_bSVideo;
+}
+
+Void TExt360AppDecTop::xDestroy()
+{
+#if SVIDEO_DECODER_RENDER_THREAD
+  if (m_renderThread.joinable())
+  {
+    // the render thread writes the pictures still queued before it leaves;
+    {
+      std::unique_lock<std::mutex> lock(m_renderMutex);
+      m_bRenderExit = true;
+      m_renderCv.notify_all();
+    }
+    m_renderThread.join();
+  }
+#endif
+  if (m_cTVideoIOYuvRenderFile.isOpen())
+  {
+    m_cTVideoIOYuvRenderFile.close();
+  }
+  if (m_pcCodingGeometry)
+  {
+    delete m_pcCodingGeometry;
+    m_pcCodingGeometry = nullptr;
+  }
+  if (m_pcSourceGeometry)
+  {
+    delete m_pcSourceGeometry;
+    m_pcSourceGeometry = nullptr;
+  }
+#if SVIDEO_DECODER_RENDER_THREAD
+  for (auto &pic: m_renderPics)
+  {
+    pic.destroy();
+  }
+  m_renderPics.clear();
+#endif
+  m_picYuvRender.destroy();
+  m_picYuvRot.destroy();
+}
+
+// the geometries are set up with the first output picture: the coding geometry follows its cropped size, the sample
+// format of the conversion follows the one of the bitstream;
+Void TExt360AppDecTop::xCreate(const Picture &pic, Int iWidth, Int iHeight)
+{
+  TExt360AppDecCfg &extCfg = m_cfg.m_ext360;
+  const ChromaFormat chromaFormat = pic.m_chromaFormatIdc;
+  const BitDepths   &bitDepths    = pic.cs->sps->getBitDepths();
+
+  m_iDecodedWidth  = iWidth;
+  m_iDecodedHeight = iHeight;
+  m_iLayerId       = pic.layerId;
+  TSVideoInfoCfg::fillSVideoInfo(extCfg.m_codingSVideoInfo, iWidth, iHeight);
+  extCfg.m_sourceSVideoInfo.framePackStruct.chromaFormatIDC = chromaFormat;
+  extCfg.m_codingSVideoInfo.framePackStruct.chromaFormatIDC = chromaFormat;
+  if (!extCfg.m_iInternalChromaFormat)
+  {
+    extCfg.m_inputGeoParam.chromaFormat = chromaFormat;
+  }
+  extCfg.m_inputGeoParam.nBitDepth       = bitDepths[ChannelType::LUMA];
+  extCfg.m_inputGeoParam.nOutputBitDepth = bitDepths[ChannelType::LUMA];
+
+  m_pcCodingGeometry = TGeometry::create(extCfg.m_codingSVideoInfo, &extCfg.m_inputGeoParam);
+  m_pcSourceGeometry = TGeometry::create(extCfg.m_sourceSVideoInfo, &extCfg.m_inputGeoParam);
+
+  // the rotation of an ERP/EAP frame packing is applied after framePack(), as the encoder undoes it before convertYuv();
+  Int iRot = 0;
+  if(   extCfg.m_sourceSVideoInfo.geoType == SVIDEO_EQUIRECT
+#if SVIDEO_ADJUSTED_EQUALAREA
+     || extCfg.m_sourceSVideoInfo.geoType == SVIDEO_ADJUSTEDEQUALAREA
+#else
+     || extCfg.m_sourceSVideoInfo.geoType == SVIDEO_EQUALAREA
+#endif
+    )
+  {
+    iRot = extCfg.m_sourceSVideoInfo.framePackStruct.faces[0][0].rot;
+  }
+  if (iRot == 90 || iRot == 270)
+  {
+    m_picYuvRender.create(chromaFormat, Area(Position(), Size(extCfg.m_iSourceHeight, extCfg.m_iSourceWidth)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+  }
+  else
+  {
+    m_picYuvRender.create(chromaFormat, Area(Position(), Size(extCfg.m_iSourceWidth, extCfg.m_iSourceHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+  }
+  if (iRot)
+  {
+    m_picYuvRot.create(chromaFormat, Area(Position(), Size(extCfg.m_iSourceWidth, extCfg.m_iSourceHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+  }
+
+#if SVIDEO_DECODER_RENDER_THREAD
+  m_renderPics.resize(extCfg.m_iRenderQueue);
+  for (auto &renderPic: m_renderPics)
+  {
+    renderPic.create(chromaFormat, Area(Position(), Size(iWidth, iHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+  }
+#endif
+
+  BitDepths outputBitDepth;
+  for (auto channelType: { ChannelType::LUMA, ChannelType::CHROMA })
+  {
+    outputBitDepth[channelType] = m_cfg.m_outputBitDepth[channelType] ? m_cfg.m_outputBitDepth[channelType] : bitDepths[channelType];
+  }
+  m_cTVideoIOYuvRenderFile.open(extCfg.m_renderFileName, true, outputBitDepth, outputBitDepth, bitDepths);   // write mode
+
+  printf("360 video rendering: geometry %d %dx%d -> geometry %d %dx%d\n", extCfg.m_codingSVideoInfo.geoType, iWidth, iHeight,
+         extCfg.m_sourceSVideoInfo.geoType, extCfg.m_iSourceWidth, extCfg.m_iSourceHeight);
+}
+
+Void TExt360AppDecTop::xRender(PelUnitBuf &picYuvDecoded)
+{
+  if ((m_pcCodingGeometry->getType() == SVIDEO_OCTAHEDRON || m_pcCodingGeometry->getType() == SVIDEO_ICOSAHEDRON) && m_pcCodingGeometry->getSVideoInfo()->iCompactFPStructure)
+  {
+    m_pcCodingGeometry->compactFramePackConvertYuv(&picYuvDecoded);
+  }
+  else
+  {
+    m_pcCodingGeometry->convertYuv(&picYuvDecoded);
+  }
+#if SVIDEO_ROT_FIX
+  m_pcCodingGeometry->geoConvert(m_pcSourceGeometry, true);
+#else
+  m_pcCodingGeometry->geoConvert(m_pcSourceGeometry);
+#endif
+  if ((m_pcSourceGeometry->getType() == SVIDEO_OCTAHEDRON || m_pcSourceGeometry->getType() == SVIDEO_ICOSAHEDRON) && m_pcSourceGeometry->getSVideoInfo()->iCompactFPStructure)
+  {
+    m_pcSourceGeometry->compactFramePack(&m_picYuvRender);
+  }
+  else
+  {
+    m_pcSourceGeometry->framePack(&m_picYuvRender);
+  }
+
+  PelStorage *pcPicYuvOut = &m_picYuvRender;
+  if (m_picYuvRot.chromaFormat != ChromaFormat::NUM)
+  {
+    m_pcSourceGeometry->rotYuv(&m_picYuvRender, &m_picYuvRot, m_cfg.m_ext360.m_sourceSVideoInfo.framePackStruct.faces[0][0].rot);
+    pcPicYuvOut = &m_picYuvRot;
+  }
+  m_cTVideoIOYuvRenderFile.write(pcPicYuvOut->get(COMPONENT_Y).width, pcPicYuvOut->get(COMPONENT_Y).height, *pcPicYuvOut,
+                                 IPCOLOURSPACE_UNCHANGED, false, 0, 0, 0, 0, ChromaFormat::UNDEFINED,
+                                 m_cfg.m_clipOutputVideoToRec709Range);
+}
+
+#if SVIDEO_DECODER_RENDER_THREAD
+Void TExt360AppDecTop::xRenderLoop()
+{
+  const Int iNumRenderPics = (Int)m_renderPics.size();
+  for (Int n = 0;; n++)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_renderMutex);
+      m_renderCv.wait(lock, [&] { return m_bRenderExit || n < m_iNumQueued; });
+      if (n >= m_iNumQueued)
+      {
+        return;
+      }
+    }
+    xRender(m_renderPics[n % iNumRenderPics]);
+
+    std::unique_lock<std::mutex> lock(m_renderMutex);
+    m_iNumRendered = n + 1;
+    m_renderCv.notify_all();
+  }
+}
+#endif
+
+Void TExt360AppDecTop::write(Picture &pic)
+{
+  const Window      &conf            = pic.getConformanceWindow();
+  const ChromaFormat chromaFormatIdc = pic.m_chromaFormatIdc;
+  const Int          iLeft           = conf.getWindowLeftOffset() * SPS::getWinUnitX(chromaFormatIdc);
+  const Int          iRight          = conf.getWindowRightOffset() * SPS::getWinUnitX(chromaFormatIdc);
+  const Int          iTop            = conf.getWindowTopOffset() * SPS::getWinUnitY(chromaFormatIdc);
+  const Int          iBottom         = conf.getWindowBottomOffset() * SPS::getWinUnitY(chromaFormatIdc);
+  const Int          iWidth          = pic.Y().width - iLeft - iRight;
+  const Int          iHeight         = pic.Y().height - iTop - iBottom;
+
+  if (!m_pcCodingGeometry)
+  {
+    xCreate(pic, iWidth, iHeight);
+  }
+  // the geometries follow the first output picture; the pictures of other layers and the ones resampled to another
+  // size (RPR) are not rendered;
+  if (pic.layerId != m_iLayerId || iWidth != m_iDecodedWidth || iHeight != m_iDecodedHeight)
+  {
+    if (!m_bSkipWarned)
+    {
+      msg(WARNING, "360 video rendering: output pictures of another layer or size are not rendered\n");
+      m_bSkipWarned = true;
+    }
+    return;
+  }
+  PelUnitBuf picYuvDecoded = pic.getRecoBuf(UnitArea(chromaFormatIdc, Area(iLeft, iTop, iWidth, iHeight)));
+
+#if SVIDEO_DECODER_RENDER_THREAD
+  if (m_cfg.m_ext360.m_iRenderQueue > 0)
+  {
+    const Int iNumRenderPics = (Int)m_renderPics.size();
+    {
+      std::unique_lock<std::mutex> lock(m_renderMutex);
+      m_renderCv.wait(lock, [&] { return m_iNumQueued - m_iNumRendered < iNumRenderPics; });
+    }
+    m_renderPics[m_iNumQueued % iNumRenderPics].copyFrom(picYuvDecoded);
+    {
+      std::unique_lock<std::mutex> lock(m_renderMutex);
+      m_iNumQueued++;
+      m_renderCv.notify_all();
+    }
+    if (!m_renderThread.joinable())
+    {
+      m_renderThread = std::thread(&TExt360AppDecTop::xRenderLoop, this);
+    }
+    return;
+  }
+#endif
+  xRender(picYuvDecoded);
+}
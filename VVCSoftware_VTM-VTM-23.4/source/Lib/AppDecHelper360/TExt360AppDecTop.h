@@ -0,0 +1,92 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __TEXT360APPDECTOP__
+#define __TEXT360APPDECTOP__
+
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/Picture.h"
+#include "Lib360/TGeometry.h"
+#include "AppDecHelper360/TExt360AppDecCfg.h"
+#include "Utilities/VideoIOYuv.h"
+#if SVIDEO_DECODER_RENDER_THREAD
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+#include <vector>
+
+class DecAppCfg;
+
+class TExt360AppDecTop
+{
+  DecAppCfg     &m_cfg;
+  TGeometry     *m_pcCodingGeometry;    ///< decoded picture;
+  TGeometry     *m_pcSourceGeometry;    ///< rendered picture;
+  PelStorage     m_picYuvRender;        ///< rendered picture before the rotation of the frame packing;
+  PelStorage     m_picYuvRot;           ///< rendered picture with the ERP/EAP frame packing rotation;
+  VideoIOYuv     m_cTVideoIOYuvRenderFile;
+  Int            m_iDecodedWidth;
+  Int            m_iDecodedHeight;
+  Int            m_iLayerId;            ///< layer of the rendered pictures;
+  Bool           m_bSkipWarned;
+
+#if SVIDEO_DECODER_RENDER_THREAD
+  // the output pictures are copied out of the decoded picture buffer into the ring of m_renderPics, the render thread
+  // converts and writes them in output order;
+  std::vector<PelStorage>   m_renderPics;                     ///< ring, picture n in [n % size];
+  std::thread               m_renderThread;
+  std::mutex                m_renderMutex;
+  std::condition_variable   m_renderCv;
+  Int                       m_iNumQueued;                     ///< pictures put into the ring;
+  Int                       m_iNumRendered;                   ///< pictures written by the render thread;
+  Bool                      m_bRenderExit;
+
+  Void xRenderLoop();
+#endif
+
+  Void xCreate(const Picture &pic, Int iWidth, Int iHeight);
+  Void xDestroy();
+  Void xRender(PelUnitBuf &picYuvDecoded);
+
+public:
+  TExt360AppDecTop(DecAppCfg &cfg);
+  virtual ~TExt360AppDecTop();
+
+  Bool isEnabled() const;
+
+  Void write(Picture &pic);   ///< renders the cropped output picture pic and writes it to SphereVideoFile;
+};
+
+#endif
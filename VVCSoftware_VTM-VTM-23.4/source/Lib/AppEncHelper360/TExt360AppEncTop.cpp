@@ -51,6 +51,12 @@ TExt360AppEncTop::TExt360AppEncTop(EncAppCfg &cfg, TExt360EncGop &ext360Gop, Enc
   {
     CHECK(m_bGeoConvertSkip, "");
   }
+#if SVIDEO_INPUT_LOOKAHEAD
+  m_iLookahead             = 0;
+  m_iNumLookaheadConverted = 0;
+  m_iNumLookaheadRead      = 0;
+  m_bLookaheadExit         = false;
+#endif
   xCreate(encGop, yuvOrig);
 }
 
@@ -61,6 +67,27 @@ TExt360AppEncTop::~TExt360AppEncTop()
 
 Void TExt360AppEncTop::xDestroy()
 {
+#if SVIDEO_INPUT_LOOKAHEAD
+  if (m_lookaheadThread.joinable())
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_lookaheadMutex);
+      m_bLookaheadExit = true;
+    }
+    m_lookaheadCv.notify_all();
+    m_lookaheadThread.join();
+  }
+  if (m_iLookahead > 0)
+  {
+    m_cTVideoIOYuvInputFileLookahead.close();
+  }
+  for (auto &pic: m_lookaheadPics)
+  {
+    pic.picYuvOrg.destroy();
+    pic.picYuvTrueOrg.destroy();
+  }
+  m_lookaheadPics.clear();
+#endif
 #if SVIDEO_E2E_METRICS
   m_cTVideoIOYuvInputFile4E2EMetrics.close();
 #else
@@ -139,6 +166,31 @@ Void TExt360AppEncTop::xCreate(EncGOP &encGop, PelStorage &yuvOrig)
     m_pcInputGeomtry  = TGeometry::create(extCfg.m_sourceSVideoInfo, &extCfg.m_inputGeoParam);
     m_pcCodingGeomtry = TGeometry::create(extCfg.m_codingSVideoInfo, &extCfg.m_inputGeoParam);
 #endif
+#if SVIDEO_FACE_VIEWS
+    if (extCfg.m_bFaceViews && m_pcInputGeomtry)
+    {
+      // m_picYuvReadFromFile and m_picYuvRot carry S_PAD_MAX margins;
+      m_pcInputGeomtry->enableFaceViews(S_PAD_MAX);
+    }
+#endif
+#if SVIDEO_INPUT_LOOKAHEAD
+    if (extCfg.m_iInputLookahead > 0 && !m_bGeoConvertSkip)
+    {
+      m_iLookahead = extCfg.m_iInputLookahead;
+      m_lookaheadPics.resize(m_iLookahead);
+      for (auto &pic: m_lookaheadPics)
+      {
+        pic.picYuvOrg.create(yuvOrig.chromaFormat, Area(Position(), Size(yuvOrig.Y().width, yuvOrig.Y().height)));
+        pic.picYuvTrueOrg.create(yuvOrig.chromaFormat, Area(Position(), Size(yuvOrig.Y().width, yuvOrig.Y().height)));
+        pic.bEof = false;
+      }
+      m_cTVideoIOYuvInputFileLookahead.open(cfg.m_inputFileName, false, cfg.m_inputBitDepth, cfg.m_msbExtendedBitDepth, cfg.m_internalBitDepth);
+      m_cTVideoIOYuvInputFileLookahead.skipFrames(cfg.m_frameSkip, cfg.m_inputFileWidth, cfg.m_inputFileHeight, cfg.m_inputChromaFormatIDC);
+    }
+#endif
+#if SVIDEO_PARALLEL_METRICS
+    m_ext360EncGop.setNumThreads(extCfg.m_inputGeoParam.iNumThreads);
+#endif
 #if SVIDEO_E2E_METRICS
     m_ext360EncGop.initE2EMetricsCalc(extCfg.m_sourceSVideoInfo, extCfg.m_codingSVideoInfo, &extCfg.m_inputGeoParam, m_cTVideoIOYuvInputFile4E2EMetrics, cfg.m_inputChromaFormatIDC, cfg.m_inputFileWidth, cfg.m_inputFileHeight, cfg.m_temporalSubsampleRatio);
 #endif
@@ -285,63 +337,144 @@ Void TExt360AppEncTop::xCreate(EncGOP &encGop, PelStorage &yuvOrig)
 }
 
 
-Void
-TExt360AppEncTop::read(VideoIOYuv &inputVideoFile, PelStorage &picYuvOrg, PelStorage &picYuvTrueOrg, const InputColourSpaceConversion ipCSC)
+Void TExt360AppEncTop::xReadConvert(VideoIOYuv &inputVideoFile, PelStorage &picYuvOrg, PelStorage &picYuvTrueOrg, const InputColourSpaceConversion ipCSC)
 {
-  if (!m_bGeoConvertSkip)
+  Int aiPad[2]={0,0};
+  //PelUnitBuf tmp;
+  inputVideoFile.read(m_picYuvReadFromFile, m_picYuvReadFromFile, IPCOLOURSPACE_UNCHANGED, aiPad, m_cfg.m_inputChromaFormatIDC, m_cfg.m_clipInputVideoToRec709Range);
+  if(m_picYuvRot.chromaFormat != ChromaFormat::NUM)
   {
-    Int aiPad[2]={0,0};
-    //PelUnitBuf tmp;
-    inputVideoFile.read(m_picYuvReadFromFile, m_picYuvReadFromFile, IPCOLOURSPACE_UNCHANGED, aiPad, m_cfg.m_inputChromaFormatIDC, m_cfg.m_clipInputVideoToRec709Range);
-    if(m_picYuvRot.chromaFormat != ChromaFormat::NUM)
+    m_pcInputGeomtry->rotYuv(&m_picYuvReadFromFile, &m_picYuvRot, (360-m_cfg.m_ext360.m_sourceSVideoInfo.framePackStruct.faces[0][0].rot)%360);
+    m_pcInputGeomtry->convertYuv(&m_picYuvRot);
+  }
+  else
+  {
+    if((m_pcInputGeomtry->getSVideoInfo()->geoType == SVIDEO_OCTAHEDRON || m_pcInputGeomtry->getSVideoInfo()->geoType == SVIDEO_ICOSAHEDRON) && m_pcInputGeomtry->getSVideoInfo()->iCompactFPStructure)
     {
-      m_pcInputGeomtry->rotYuv(&m_picYuvReadFromFile, &m_picYuvRot, (360-m_cfg.m_ext360.m_sourceSVideoInfo.framePackStruct.faces[0][0].rot)%360);
-      m_pcInputGeomtry->convertYuv(&m_picYuvRot);
+      m_pcInputGeomtry->compactFramePackConvertYuv(&m_picYuvReadFromFile);
     }
     else
     {
-      if((m_pcInputGeomtry->getSVideoInfo()->geoType == SVIDEO_OCTAHEDRON || m_pcInputGeomtry->getSVideoInfo()->geoType == SVIDEO_ICOSAHEDRON) && m_pcInputGeomtry->getSVideoInfo()->iCompactFPStructure)
-      {
-        m_pcInputGeomtry->compactFramePackConvertYuv(&m_picYuvReadFromFile);
-      }
-      else
-      {
-        m_pcInputGeomtry->convertYuv(&m_picYuvReadFromFile);
-      }
+      m_pcInputGeomtry->convertYuv(&m_picYuvReadFromFile);
     }
+  }
+  if(!m_bDirectFPConvert)
+  {
+    m_pcInputGeomtry->geoConvert(m_pcCodingGeomtry);
+  }
+  else
+  {
+    m_pcInputGeomtry->setPaddingFlag(true);
+  }
+
+  if((m_pcCodingGeomtry->getSVideoInfo()->geoType == SVIDEO_OCTAHEDRON || m_pcCodingGeomtry->getSVideoInfo()->geoType == SVIDEO_ICOSAHEDRON) && m_pcCodingGeomtry->getSVideoInfo()->iCompactFPStructure)
+  {
+    if(!m_bDirectFPConvert)
+    {
+      m_pcCodingGeomtry->compactFramePack(&picYuvTrueOrg);
+    }
+    else
+    {
+      m_pcInputGeomtry->compactFramePack(&picYuvTrueOrg);
+    }
+  }
+  else
+  {
     if(!m_bDirectFPConvert)
     {
-      m_pcInputGeomtry->geoConvert(m_pcCodingGeomtry);
+      m_pcCodingGeomtry->framePack(&picYuvTrueOrg);
     }
     else
     {
-      m_pcInputGeomtry->setPaddingFlag(true);
+      m_pcInputGeomtry->framePack(&picYuvTrueOrg);
     }
+  }
+  inputVideoFile.colourSpaceConvert(picYuvTrueOrg, picYuvOrg, ipCSC, true);
+  m_pcInputGeomtry->framePadding(&picYuvOrg, m_cfg.m_sourcePadding);
+}
 
-    if((m_pcCodingGeomtry->getSVideoInfo()->geoType == SVIDEO_OCTAHEDRON || m_pcCodingGeomtry->getSVideoInfo()->geoType == SVIDEO_ICOSAHEDRON) && m_pcCodingGeomtry->getSVideoInfo()->iCompactFPStructure)
+#if SVIDEO_INPUT_LOOKAHEAD
+Void TExt360AppEncTop::xLookaheadLoop(const InputColourSpaceConversion ipCSC)
+{
+  const Int iNumPics = m_cfg.m_isField ? (m_cfg.m_framesToBeEncoded >> 1) : m_cfg.m_framesToBeEncoded;
+  for (Int n = 0; n < iNumPics; n++)
+  {
     {
-      if(!m_bDirectFPConvert)
+      std::unique_lock<std::mutex> lock(m_lookaheadMutex);
+      m_lookaheadCv.wait(lock, [&] { return m_bLookaheadExit || n - m_iNumLookaheadRead < m_iLookahead; });
+      if (m_bLookaheadExit)
       {
-        m_pcCodingGeomtry->compactFramePack(&picYuvTrueOrg);
-      }
-      else
-      {
-        m_pcInputGeomtry->compactFramePack(&picYuvTrueOrg);
+        return;
       }
     }
+    LookaheadPic &pic = m_lookaheadPics[n % m_iLookahead];
+    xReadConvert(m_cTVideoIOYuvInputFileLookahead, pic.picYuvOrg, pic.picYuvTrueOrg, ipCSC);
+    pic.bEof = m_cTVideoIOYuvInputFileLookahead.isEof();
+
+    std::unique_lock<std::mutex> lock(m_lookaheadMutex);
+    m_iNumLookaheadConverted = n + 1;
+    m_lookaheadCv.notify_all();
+    if (pic.bEof)
+    {
+      return;
+    }
+  }
+}
+
+Void TExt360AppEncTop::xReadLookahead(VideoIOYuv &inputVideoFile, PelStorage &picYuvOrg, PelStorage &picYuvTrueOrg, const InputColourSpaceConversion ipCSC)
+{
+  if (!m_lookaheadThread.joinable())
+  {
+    // the samples framePack() leaves untouched keep the values of the encoder's picture;
+    for (auto &pic: m_lookaheadPics)
+    {
+      pic.picYuvTrueOrg.copyFrom(picYuvTrueOrg);
+    }
+    m_lookaheadThread = std::thread(&TExt360AppEncTop::xLookaheadLoop, this, ipCSC);
+  }
+
+  LookaheadPic *pPic;
+  {
+    std::unique_lock<std::mutex> lock(m_lookaheadMutex);
+    m_lookaheadCv.wait(lock, [&] { return m_iNumLookaheadConverted > m_iNumLookaheadRead; });
+    pPic = &m_lookaheadPics[m_iNumLookaheadRead % m_iLookahead];
+  }
+  picYuvOrg.copyFrom(pPic->picYuvOrg);
+  picYuvTrueOrg.copyFrom(pPic->picYuvTrueOrg);
+  if (pPic->bEof)
+  {
+    // the lookahead thread has stopped; the failing read reports the end of the file to the encoder;
+    Int aiPad[2]={0,0};
+    inputVideoFile.read(m_picYuvReadFromFile, m_picYuvReadFromFile, IPCOLOURSPACE_UNCHANGED, aiPad, m_cfg.m_inputChromaFormatIDC, m_cfg.m_clipInputVideoToRec709Range);
+  }
+  else
+  {
+    inputVideoFile.skipFrames(1, m_cfg.m_inputFileWidth, m_cfg.m_inputFileHeight, m_cfg.m_inputChromaFormatIDC);
+  }
+
+  std::unique_lock<std::mutex> lock(m_lookaheadMutex);
+  m_iNumLookaheadRead++;
+  m_lookaheadCv.notify_all();
+}
+#endif
+
+Void
+TExt360AppEncTop::read(VideoIOYuv &inputVideoFile, PelStorage &picYuvOrg, PelStorage &picYuvTrueOrg, const InputColourSpaceConversion ipCSC)
+{
+  if (!m_bGeoConvertSkip)
+  {
+#if SVIDEO_INPUT_LOOKAHEAD
+    if (m_iLookahead > 0)
+    {
+      xReadLookahead(inputVideoFile, picYuvOrg, picYuvTrueOrg, ipCSC);
+    }
     else
     {
-      if(!m_bDirectFPConvert)
-      {
-        m_pcCodingGeomtry->framePack(&picYuvTrueOrg);
-      }
-      else
-      {
-        m_pcInputGeomtry->framePack(&picYuvTrueOrg);
-      }
+      xReadConvert(inputVideoFile, picYuvOrg, picYuvTrueOrg, ipCSC);
     }
-    inputVideoFile.colourSpaceConvert(picYuvTrueOrg, picYuvOrg, ipCSC, true);
-    m_pcInputGeomtry->framePadding(&picYuvOrg, m_cfg.m_sourcePadding);
+#else
+    xReadConvert(inputVideoFile, picYuvOrg, picYuvTrueOrg, ipCSC);
+#endif
   }
   else
   {
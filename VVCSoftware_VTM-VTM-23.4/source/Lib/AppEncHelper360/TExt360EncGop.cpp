@@ -34,6 +34,10 @@
 #include "AppEncHelper360/TExt360EncGop.h"
 #include "EncoderLib/Analyze.h"
 #include "EncoderLib/EncGOP.h"
+#if SVIDEO_PARALLEL_METRICS
+#include "Lib360/TThreadPool.h"
+#endif
+#include <functional>
 #if SVIDEO_HEX_PSNR_SUPPORT
 #include <cinttypes>
 #endif
@@ -51,6 +55,32 @@ TExt360EncGop::TExt360EncGop()
   m_pRefGeometry = nullptr;
   m_pRecGeometry = nullptr;
 #endif
+#if SVIDEO_PARALLEL_METRICS
+  m_iNumThreads = 1;
+#endif
+#if SVIDEO_CONVERSION_CACHE
+#if SVIDEO_CF_SPSNR_NN
+  m_cCFSPSNRMetric.setConversionCache(&m_cConversionCache);
+#endif
+#if SVIDEO_SPSNR_I
+  m_cSPSNRIMetric.setConversionCache(&m_cConversionCache);
+#endif
+#if SVIDEO_CF_SPSNR_I
+  m_cCFSPSNRIMetric.setConversionCache(&m_cConversionCache);
+#endif
+#if SVIDEO_CPPPSNR
+  m_cCPPPSNRMetric.setConversionCache(&m_cConversionCache);
+#endif
+#if SVIDEO_CF_CPPPSNR
+  m_cCFCPPPSNRMetric.setConversionCache(&m_cConversionCache);
+#endif
+#if SVIDEO_VIEWPORT_PSNR
+  m_cViewPortPSNR.setConversionCache(&m_cConversionCache);
+#endif
+#if SVIDEO_DYNAMIC_VIEWPORT_PSNR
+  m_cDynamicViewPortPSNR.setConversionCache(&m_cConversionCache);
+#endif
+#endif
 }
 
 TExt360EncGop::~TExt360EncGop()
@@ -84,23 +114,34 @@ Void TExt360EncGop::calculatePSNRs(Picture *pcPic)
 {
   PelUnitBuf recPicYuv = pcPic->getRecoBuf();
   PelUnitBuf orgPicYuv = pcPic->getOrigBuf();
+#if SVIDEO_CONVERSION_CACHE
+  m_cConversionCache.newPicture();
+#endif
 #if SVIDEO_E2E_METRICS
   readOrigPicYuv(pcPic->getPOC());
   reconstructPicYuv(recPicYuv);
 #endif
+#if SVIDEO_PARALLEL_METRICS
+  // the metrics only read the pictures and write their own results; the conversions they have in common are shared
+  // through m_cConversionCache. addResult() collects the results in a fixed order once all tasks have finished.
+  std::vector<std::function<Void()>> metricTasks;
+  auto runMetric = [&](const std::function<Void()> &task) { metricTasks.push_back(task); };
+#else
+  auto runMetric = [](const std::function<Void()> &task) { task(); };
+#endif
 #if SVIDEO_SPSNR_NN
   if(getSPSNRMetric()->getSPSNREnabled())
   {
 #if SVIDEO_E2E_METRICS
-    getSPSNRMetric()->xCalculateSPSNR(*getOrigPicYuv(), *getRecPicYuv());
+    runMetric([&]() { getSPSNRMetric()->xCalculateSPSNR(*getOrigPicYuv(), *getRecPicYuv()); });
 #else
-    getSPSNRMetric()->xCalculateSPSNR(orgPicYuv, recPicYuv);
+    runMetric([&]() { getSPSNRMetric()->xCalculateSPSNR(orgPicYuv, recPicYuv); });
 #endif
   }
 #if SVIDEO_CODEC_SPSNR_NN
   if(getCodecSPSNRMetric()->getSPSNREnabled())
   {
-    getCodecSPSNRMetric()->xCalculateSPSNR(orgPicYuv, recPicYuv);
+    runMetric([&]() { getCodecSPSNRMetric()->xCalculateSPSNR(orgPicYuv, recPicYuv); });
   }
 #endif
 #endif
@@ -110,7 +151,7 @@ Void TExt360EncGop::calculatePSNRs(Picture *pcPic)
 #if SVIDEO_HEMI_PROJECTIONS
     if (!((Int)(m_pRecGeometry->getType()) == SVIDEO_HCMP || (Int)(m_pRecGeometry->getType()) == SVIDEO_HEAC))
 #endif
-    getWSPSNRMetric()->xCalculateWSPSNR(&orgPicYuv, &recPicYuv);
+    runMetric([&]() { getWSPSNRMetric()->xCalculateWSPSNR(&orgPicYuv, &recPicYuv); });
   }
 #if SVIDEO_WSPSNR_E2E
   if(getE2EWSPSNRMetric()->getWSPSNREnabled())
@@ -120,9 +161,9 @@ Void TExt360EncGop::calculatePSNRs(Picture *pcPic)
 #endif
 
 #if SVIDEO_E2E_METRICS
-    getE2EWSPSNRMetric()->xCalculateE2EWSPSNR(getRecPicYuv(),  getOrigPicYuv());
+    runMetric([&]() { getE2EWSPSNRMetric()->xCalculateE2EWSPSNR(getRecPicYuv(),  getOrigPicYuv()); });
 #else
-    getE2EWSPSNRMetric()->xCalculateE2EWSPSNR(&recPicYuv, pcPic->getPOC());
+    runMetric([&]() { getE2EWSPSNRMetric()->xCalculateE2EWSPSNR(&recPicYuv, pcPic->getPOC()); });
 #endif
   }
 #endif
@@ -131,9 +172,9 @@ Void TExt360EncGop::calculatePSNRs(Picture *pcPic)
   if(getSPSNRIMetric()->getSPSNRIEnabled())
   {
 #if SVIDEO_E2E_METRICS
-    getSPSNRIMetric()->xCalculateSPSNRI(getOrigPicYuv(), getRecPicYuv());
+    runMetric([&]() { getSPSNRIMetric()->xCalculateSPSNRI(getOrigPicYuv(), getRecPicYuv()); });
 #else
-    getSPSNRIMetric()->xCalculateSPSNRI(&orgPicYuv, &recPicYuv);
+    runMetric([&]() { getSPSNRIMetric()->xCalculateSPSNRI(&orgPicYuv, &recPicYuv); });
 #endif
   }
 #endif
@@ -141,9 +182,9 @@ Void TExt360EncGop::calculatePSNRs(Picture *pcPic)
   if(getCPPPSNRMetric()->getCPPPSNREnabled())
   {
 #if SVIDEO_E2E_METRICS
-    getCPPPSNRMetric()->xCalculateCPPPSNR(getOrigPicYuv(), getRecPicYuv());
+    runMetric([&]() { getCPPPSNRMetric()->xCalculateCPPPSNR(getOrigPicYuv(), getRecPicYuv()); });
 #else
-    getCPPPSNRMetric()->xCalculateCPPPSNR(&orgPicYuv, &recPicYuv);
+    runMetric([&]() { getCPPPSNRMetric()->xCalculateCPPPSNR(&orgPicYuv, &recPicYuv); });
 #endif
   }
 #endif
@@ -151,36 +192,39 @@ Void TExt360EncGop::calculatePSNRs(Picture *pcPic)
   if(getViewPortPSNRMetric()->isEnabled())
   {
 #if SVIDEO_E2E_METRICS
-    getViewPortPSNRMetric()->xCalculatePSNR(pcPic, getOrigPicYuv());
+    runMetric([&]() { getViewPortPSNRMetric()->xCalculatePSNR(pcPic, getOrigPicYuv()); });
 #else
-    getViewPortPSNRMetric()->xCalculatePSNR(pcPic);
+    runMetric([&]() { getViewPortPSNRMetric()->xCalculatePSNR(pcPic); });
 #endif
   }
 #endif
 #if SVIDEO_DYNAMIC_VIEWPORT_PSNR
   if(getDynamicViewPortPSNRMetric()->isEnabled())
   {
-    getDynamicViewPortPSNRMetric()->xCalculateDynamicViewPSNR(pcPic, getOrigPicYuv());
+    runMetric([&]() { getDynamicViewPortPSNRMetric()->xCalculateDynamicViewPSNR(pcPic, getOrigPicYuv()); });
   }
 #endif
 #if SVIDEO_CF_SPSNR_NN
   if(getCFSPSNRMetric()->getSPSNREnabled())
   { 
-    getCFSPSNRMetric()->xCalculateCFSPSNR(getOrigPicYuv(), &recPicYuv);
+    runMetric([&]() { getCFSPSNRMetric()->xCalculateCFSPSNR(getOrigPicYuv(), &recPicYuv); });
   }
 #endif
 #if SVIDEO_CF_SPSNR_I
   if(getCFSPSNRIMetric()->getSPSNRIEnabled())
   { 
-    getCFSPSNRIMetric()->xCalculateSPSNRI(getOrigPicYuv(), &recPicYuv);
+    runMetric([&]() { getCFSPSNRIMetric()->xCalculateSPSNRI(getOrigPicYuv(), &recPicYuv); });
   }
 #endif
 #if SVIDEO_CF_CPPPSNR
   if(getCFCPPPSNRMetric()->getCPPPSNREnabled())
   { 
-    getCFCPPPSNRMetric()->xCalculateCPPPSNR(getOrigPicYuv(), &recPicYuv);
+    runMetric([&]() { getCFCPPPSNRMetric()->xCalculateCPPPSNR(getOrigPicYuv(), &recPicYuv); });
   }
 #endif
+#if SVIDEO_PARALLEL_METRICS
+  TThreadPool::runTasks(m_iNumThreads, (Int) metricTasks.size(), [&](Int iTask) { metricTasks[iTask](); });
+#endif
 }
 
 
@@ -537,10 +581,14 @@ Void TExt360EncGop::readOrigPicYuv(Int iPOC)
 Void TExt360EncGop::reconstructPicYuv(PelUnitBuf& InPicYuv)
 {
   //generate the reconstructed picture in source gemoetry domain;
+#if SVIDEO_CONVERSION_CACHE
+  m_cConversionCache.convertYuv(m_pRecGeometry, &InPicYuv);
+#else
   if((m_pRecGeometry->getType() == SVIDEO_OCTAHEDRON || m_pRecGeometry->getType() == SVIDEO_ICOSAHEDRON) && m_pRecGeometry->getSVideoInfo()->iCompactFPStructure) 
     m_pRecGeometry->compactFramePackConvertYuv(&InPicYuv);
   else
     m_pRecGeometry->convertYuv(&InPicYuv);
+#endif
 #if SVIDEO_ROT_FIX
   m_pRecGeometry->geoConvert(m_pRefGeometry, true);
 #else
@@ -56,6 +56,9 @@ class EncGOP;
 #if SVIDEO_VIEWPORT_PSNR
 #include "Lib360/TViewPortPSNR.h"
 #endif
+#if SVIDEO_CONVERSION_CACHE
+#include "Lib360/TConversionCache.h"
+#endif
 
 
 class TExt360EncGop
@@ -120,9 +123,18 @@ private:
 #if SVIDEO_DYNAMIC_VIEWPORT_PSNR
   TViewPortPSNR           m_cDynamicViewPortPSNR;
 #endif
+#if SVIDEO_CONVERSION_CACHE
+  TConversionCache        m_cConversionCache;   //conversions of the current picture shared by the metrics;
+#endif
+#if SVIDEO_PARALLEL_METRICS
+  Int                     m_iNumThreads;        //number of threads evaluating the metrics of a picture;
+#endif
 
 public:
 
+#if SVIDEO_PARALLEL_METRICS
+  Void setNumThreads(Int iNumThreads) { m_iNumThreads = std::max(1, iNumThreads); }
+#endif
 #if SVIDEO_E2E_METRICS
   PelStorage* getOrigPicYuv() {return m_pcOrgPicYuv;};
   PelStorage* getRecPicYuv() {return m_pcRecPicYuv;};
@@ -201,6 +201,9 @@
 #define ENABLE_SIMD_OPT_DIST                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the distortion calculations(SAD,SSE,HADAMARD), no impact on RD performance
 #define ENABLE_SIMD_OPT_AFFINE_ME                       ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for affine ME, no impact on RD performance
 #define ENABLE_SIMD_OPT_ALF                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for ALF
+#define ENABLE_SIMD_OPT_INTERP360                       ( 1 && ENABLE_SIMD_OPT && EXTENSION_360_VIDEO )     ///< SIMD optimization for the 360 geometry conversion interpolation, no impact on RD performance
+#define ENABLE_SIMD_OPT_METRIC360                       ( 1 && ENABLE_SIMD_OPT && EXTENSION_360_VIDEO )     ///< SIMD optimization for the WS-PSNR metric of the 360 extension, no impact on RD performance
+#define ENABLE_SIMD_OPT_RESAMPLE360                     ( 1 && ENABLE_SIMD_OPT && EXTENSION_360_VIDEO )     ///< SIMD optimization for the chroma resampling of the 360 extension, no impact on RD performance
 #if ENABLE_SIMD_OPT_BUFFER
 #define ENABLE_SIMD_OPT_BCW                               1                                                 ///< SIMD optimization for Bcw
 #endif
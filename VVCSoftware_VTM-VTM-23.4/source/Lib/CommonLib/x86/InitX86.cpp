@@ -50,6 +50,12 @@
 
 #include "CommonLib/IbcHashMap.h"
 
+#include "CommonLib/Interpolation360.h"
+
+#include "CommonLib/Metric360.h"
+
+#include "CommonLib/Resample360.h"
+
 #ifdef TARGET_SIMD_X86
 
 
@@ -167,6 +173,69 @@ void AdaptiveLoopFilter::initAdaptiveLoopFilterX86()
 }
 #endif
 
+#if ENABLE_SIMD_OPT_INTERP360
+void Interp360Ops::initInterp360OpsX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext)
+  {
+  case AVX512:
+  case AVX2:
+    _initInterp360OpsX86<AVX2>();
+    break;
+  case AVX:
+  case SSE42:
+  case SSE41:
+    _initInterp360OpsX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_METRIC360
+void Metric360Ops::initMetric360OpsX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext)
+  {
+  case AVX512:
+  case AVX2:
+    _initMetric360OpsX86<AVX2>();
+    break;
+  case AVX:
+  case SSE42:
+  case SSE41:
+    _initMetric360OpsX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_RESAMPLE360
+void Resample360Ops::initResample360OpsX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext)
+  {
+  case AVX512:
+  case AVX2:
+    _initResample360OpsX86<AVX2>();
+    break;
+  case AVX:
+  case SSE42:
+  case SSE41:
+    _initResample360OpsX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
 #if ENABLE_SIMD_OPT_IBC
 void IbcHashMap::initIbcHashMapX86()
 {
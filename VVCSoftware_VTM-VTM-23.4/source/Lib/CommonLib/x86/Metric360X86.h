@@ -0,0 +1,163 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2024, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     Metric360X86.h
+ *  \brief    SIMD row kernels of the weighted spherical PSNR metrics
+ */
+
+//! \ingroup CommonLib
+//! \{
+
+#include "CommonLib/CommonDef.h"
+#include "CommonDefX86.h"
+#include "CommonLib/Metric360.h"
+
+#if ENABLE_SIMD_OPT_METRIC360
+#ifdef TARGET_SIMD_X86
+
+// The differences are squared in double precision, which is exact for any sample bit depth. The products are summed
+// in several lanes, so weightedSSE may differ from the C kernel in the last bits; sse only adds integers below 2^53
+// and is exact.
+
+static inline double sumDouble2(__m128d vsum)
+{
+  return _mm_cvtsd_f64(_mm_add_sd(vsum, _mm_unpackhi_pd(vsum, vsum)));
+}
+
+template<X86_VEXT vext>
+double weightedSSE_SIMD(const Pel *org, const Pel *rec, const double *weight, int width, int orgShift, int recShift)
+{
+  const __m128i vOrgShift = _mm_cvtsi32_si128(orgShift);
+  const __m128i vRecShift = _mm_cvtsi32_si128(recShift);
+  int           x         = 0;
+  double        sum;
+#ifdef USE_AVX2
+  if (vext >= AVX2)
+  {
+    __m256d vsum = _mm256_setzero_pd();
+    for (; x + 8 <= width; x += 8)
+    {
+      __m256i vorg  = _mm256_sll_epi32(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *) (org + x))), vOrgShift);
+      __m256i vrec  = _mm256_sll_epi32(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *) (rec + x))), vRecShift);
+      __m256i vdiff = _mm256_sub_epi32(vorg, vrec);
+      __m256d vd0   = _mm256_cvtepi32_pd(_mm256_castsi256_si128(vdiff));
+      __m256d vd1   = _mm256_cvtepi32_pd(_mm256_extracti128_si256(vdiff, 1));
+      vsum = _mm256_add_pd(vsum, _mm256_mul_pd(_mm256_mul_pd(vd0, vd0), _mm256_loadu_pd(weight + x)));
+      vsum = _mm256_add_pd(vsum, _mm256_mul_pd(_mm256_mul_pd(vd1, vd1), _mm256_loadu_pd(weight + x + 4)));
+    }
+    sum = sumDouble2(_mm_add_pd(_mm256_castpd256_pd128(vsum), _mm256_extractf128_pd(vsum, 1)));
+  }
+  else
+#endif
+  {
+    __m128d vsum = _mm_setzero_pd();
+    for (; x + 4 <= width; x += 4)
+    {
+      __m128i vorg  = _mm_sll_epi32(_mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *) (org + x))), vOrgShift);
+      __m128i vrec  = _mm_sll_epi32(_mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *) (rec + x))), vRecShift);
+      __m128i vdiff = _mm_sub_epi32(vorg, vrec);
+      __m128d vd0   = _mm_cvtepi32_pd(vdiff);
+      __m128d vd1   = _mm_cvtepi32_pd(_mm_srli_si128(vdiff, 8));
+      vsum = _mm_add_pd(vsum, _mm_mul_pd(_mm_mul_pd(vd0, vd0), _mm_loadu_pd(weight + x)));
+      vsum = _mm_add_pd(vsum, _mm_mul_pd(_mm_mul_pd(vd1, vd1), _mm_loadu_pd(weight + x + 2)));
+    }
+    sum = sumDouble2(vsum);
+  }
+  for (; x < width; x++)
+  {
+    const int diff = (org[x] << orgShift) - (rec[x] << recShift);
+    sum += (double) diff * diff * weight[x];
+  }
+  return sum;
+}
+
+template<X86_VEXT vext>
+double sse_SIMD(const Pel *org, const Pel *rec, int width, int orgShift, int recShift)
+{
+  const __m128i vOrgShift = _mm_cvtsi32_si128(orgShift);
+  const __m128i vRecShift = _mm_cvtsi32_si128(recShift);
+  int           x         = 0;
+  double        sum;
+#ifdef USE_AVX2
+  if (vext >= AVX2)
+  {
+    __m256d vsum = _mm256_setzero_pd();
+    for (; x + 8 <= width; x += 8)
+    {
+      __m256i vorg  = _mm256_sll_epi32(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *) (org + x))), vOrgShift);
+      __m256i vrec  = _mm256_sll_epi32(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *) (rec + x))), vRecShift);
+      __m256i vdiff = _mm256_sub_epi32(vorg, vrec);
+      __m256d vd0   = _mm256_cvtepi32_pd(_mm256_castsi256_si128(vdiff));
+      __m256d vd1   = _mm256_cvtepi32_pd(_mm256_extracti128_si256(vdiff, 1));
+      vsum = _mm256_add_pd(vsum, _mm256_add_pd(_mm256_mul_pd(vd0, vd0), _mm256_mul_pd(vd1, vd1)));
+    }
+    sum = sumDouble2(_mm_add_pd(_mm256_castpd256_pd128(vsum), _mm256_extractf128_pd(vsum, 1)));
+  }
+  else
+#endif
+  {
+    __m128d vsum = _mm_setzero_pd();
+    for (; x + 4 <= width; x += 4)
+    {
+      __m128i vorg  = _mm_sll_epi32(_mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *) (org + x))), vOrgShift);
+      __m128i vrec  = _mm_sll_epi32(_mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *) (rec + x))), vRecShift);
+      __m128i vdiff = _mm_sub_epi32(vorg, vrec);
+      __m128d vd0   = _mm_cvtepi32_pd(vdiff);
+      __m128d vd1   = _mm_cvtepi32_pd(_mm_srli_si128(vdiff, 8));
+      vsum = _mm_add_pd(vsum, _mm_add_pd(_mm_mul_pd(vd0, vd0), _mm_mul_pd(vd1, vd1)));
+    }
+    sum = sumDouble2(vsum);
+  }
+  for (; x < width; x++)
+  {
+    const int64_t diff = (org[x] << orgShift) - (rec[x] << recShift);
+    sum += (double) (diff * diff);
+  }
+  return sum;
+}
+
+template<X86_VEXT vext>
+void Metric360Ops::_initMetric360OpsX86()
+{
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+  weightedSSE = weightedSSE_SIMD<vext>;
+  sse         = sse_SIMD<vext>;
+#endif
+}
+
+template void Metric360Ops::_initMetric360OpsX86<SIMDX86>();
+
+#endif // TARGET_SIMD_X86
+#endif
+//! \}
@@ -0,0 +1,334 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2024, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     Resample360X86.h
+ *  \brief    SIMD row kernels of the chroma resampling of the 360 geometries
+ */
+
+//! \ingroup CommonLib
+//! \{
+
+#include "CommonLib/CommonDef.h"
+#include "CommonDefX86.h"
+#include "CommonLib/Resample360.h"
+
+#if ENABLE_SIMD_OPT_RESAMPLE360
+#ifdef TARGET_SIMD_X86
+
+// The vertical kernels multiply pairs of rows with _mm_madd_epi16 and the horizontal upsampling multiplies the 32-bit
+// intermediates, both exact in 32 bits like the C kernels. The horizontal downsampling is stored unnormalised into
+// 16 bits by the C kernel, so it is computed in 16-bit wrap-around arithmetic, which gives the same truncated result.
+
+static constexpr int RESAMPLE360_MAX_TAPS = 16;
+
+static inline int pairCoeff(const int *coeff, int numTaps, int t)
+{
+  return (coeff[t] & 0xffff) | (t + 1 < numTaps ? coeff[t + 1] << 16 : 0);
+}
+
+// sums of columns 0..3 (lo) and 4..7 (hi);
+static inline void filterVer8(const Pel *src, ptrdiff_t srcStride, const __m128i *vcoeff, int numTaps, __m128i &lo,
+                              __m128i &hi)
+{
+  lo = _mm_setzero_si128();
+  hi = _mm_setzero_si128();
+  for (int t = 0; t < numTaps; t += 2)
+  {
+    __m128i va = _mm_loadu_si128((const __m128i *) (src + t * srcStride));
+    __m128i vb = t + 1 < numTaps ? _mm_loadu_si128((const __m128i *) (src + (t + 1) * srcStride)) : _mm_setzero_si128();
+    lo         = _mm_add_epi32(lo, _mm_madd_epi16(_mm_unpacklo_epi16(va, vb), vcoeff[t >> 1]));
+    hi         = _mm_add_epi32(hi, _mm_madd_epi16(_mm_unpackhi_epi16(va, vb), vcoeff[t >> 1]));
+  }
+}
+
+#ifdef USE_AVX2
+// sums of columns 0..3 and 8..11 (lo), 4..7 and 12..15 (hi);
+static inline void filterVer16(const Pel *src, ptrdiff_t srcStride, const __m256i *vcoeff, int numTaps, __m256i &lo,
+                               __m256i &hi)
+{
+  lo = _mm256_setzero_si256();
+  hi = _mm256_setzero_si256();
+  for (int t = 0; t < numTaps; t += 2)
+  {
+    __m256i va = _mm256_loadu_si256((const __m256i *) (src + t * srcStride));
+    __m256i vb =
+      t + 1 < numTaps ? _mm256_loadu_si256((const __m256i *) (src + (t + 1) * srcStride)) : _mm256_setzero_si256();
+    lo = _mm256_add_epi32(lo, _mm256_madd_epi16(_mm256_unpacklo_epi16(va, vb), vcoeff[t >> 1]));
+    hi = _mm256_add_epi32(hi, _mm256_madd_epi16(_mm256_unpackhi_epi16(va, vb), vcoeff[t >> 1]));
+  }
+}
+#endif
+
+template<X86_VEXT vext>
+void filterVer_SIMD(const Pel *src, ptrdiff_t srcStride, int *dst, int width, const int *coeff, int numTaps)
+{
+  CHECK(numTaps > RESAMPLE360_MAX_TAPS, "Too many taps");
+  int x = 0;
+#ifdef USE_AVX2
+  if (vext >= AVX2)
+  {
+    __m256i vcoeff[RESAMPLE360_MAX_TAPS >> 1];
+    for (int t = 0; t < numTaps; t += 2)
+    {
+      vcoeff[t >> 1] = _mm256_set1_epi32(pairCoeff(coeff, numTaps, t));
+    }
+    for (; x + 16 <= width; x += 16)
+    {
+      __m256i lo, hi;
+      filterVer16(src + x, srcStride, vcoeff, numTaps, lo, hi);
+      _mm256_storeu_si256((__m256i *) (dst + x), _mm256_permute2x128_si256(lo, hi, 0x20));
+      _mm256_storeu_si256((__m256i *) (dst + x + 8), _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+  }
+#endif
+  __m128i vcoeff[RESAMPLE360_MAX_TAPS >> 1];
+  for (int t = 0; t < numTaps; t += 2)
+  {
+    vcoeff[t >> 1] = _mm_set1_epi32(pairCoeff(coeff, numTaps, t));
+  }
+  for (; x + 8 <= width; x += 8)
+  {
+    __m128i lo, hi;
+    filterVer8(src + x, srcStride, vcoeff, numTaps, lo, hi);
+    _mm_storeu_si128((__m128i *) (dst + x), lo);
+    _mm_storeu_si128((__m128i *) (dst + x + 4), hi);
+  }
+  for (; x < width; x++)
+  {
+    int sum = 0;
+    for (int t = 0; t < numTaps; t++)
+    {
+      sum += src[x + t * srcStride] * coeff[t];
+    }
+    dst[x] = sum;
+  }
+}
+
+template<X86_VEXT vext>
+void filterVerClip_SIMD(const Pel *src, ptrdiff_t srcStride, Pel *dst, int width, const int *coeff, int numTaps,
+                        int shift, int bitDepth)
+{
+  CHECK(numTaps > RESAMPLE360_MAX_TAPS, "Too many taps");
+  const int     offset = shift ? 1 << (shift - 1) : 0;
+  const int     maxVal = (1 << bitDepth) - 1;
+  const __m128i vshift = _mm_cvtsi32_si128(shift);
+  int           x      = 0;
+#ifdef USE_AVX2
+  if (vext >= AVX2)
+  {
+    __m256i vcoeff[RESAMPLE360_MAX_TAPS >> 1];
+    for (int t = 0; t < numTaps; t += 2)
+    {
+      vcoeff[t >> 1] = _mm256_set1_epi32(pairCoeff(coeff, numTaps, t));
+    }
+    const __m256i voffset = _mm256_set1_epi32(offset);
+    const __m256i vmax    = _mm256_set1_epi32(maxVal);
+    for (; x + 16 <= width; x += 16)
+    {
+      __m256i lo, hi;
+      filterVer16(src + x, srcStride, vcoeff, numTaps, lo, hi);
+      lo = _mm256_min_epi32(_mm256_max_epi32(_mm256_sra_epi32(_mm256_add_epi32(lo, voffset), vshift), _mm256_setzero_si256()), vmax);
+      hi = _mm256_min_epi32(_mm256_max_epi32(_mm256_sra_epi32(_mm256_add_epi32(hi, voffset), vshift), _mm256_setzero_si256()), vmax);
+      // the in-lane pack restores the column order;
+      _mm256_storeu_si256((__m256i *) (dst + x), _mm256_packs_epi32(lo, hi));
+    }
+  }
+#endif
+  __m128i vcoeff[RESAMPLE360_MAX_TAPS >> 1];
+  for (int t = 0; t < numTaps; t += 2)
+  {
+    vcoeff[t >> 1] = _mm_set1_epi32(pairCoeff(coeff, numTaps, t));
+  }
+  const __m128i voffset = _mm_set1_epi32(offset);
+  const __m128i vmax    = _mm_set1_epi32(maxVal);
+  for (; x + 8 <= width; x += 8)
+  {
+    __m128i lo, hi;
+    filterVer8(src + x, srcStride, vcoeff, numTaps, lo, hi);
+    lo = _mm_min_epi32(_mm_max_epi32(_mm_sra_epi32(_mm_add_epi32(lo, voffset), vshift), _mm_setzero_si128()), vmax);
+    hi = _mm_min_epi32(_mm_max_epi32(_mm_sra_epi32(_mm_add_epi32(hi, voffset), vshift), _mm_setzero_si128()), vmax);
+    _mm_storeu_si128((__m128i *) (dst + x), _mm_packs_epi32(lo, hi));
+  }
+  for (; x < width; x++)
+  {
+    int sum = 0;
+    for (int t = 0; t < numTaps; t++)
+    {
+      sum += src[x + t * srcStride] * coeff[t];
+    }
+    dst[x] = ClipBD((sum + offset) >> shift, bitDepth);
+  }
+}
+
+template<X86_VEXT vext>
+void filterHorUp_SIMD(const int *src0, const int *src1, Pel *dst, int width, const int *coeff0, int numTaps0,
+                      const int *coeff1, int numTaps1, int shift, int bitDepth)
+{
+  CHECK(numTaps0 > RESAMPLE360_MAX_TAPS || numTaps1 > RESAMPLE360_MAX_TAPS, "Too many taps");
+  const int     offset = shift ? 1 << (shift - 1) : 0;
+  const int     maxVal = (1 << bitDepth) - 1;
+  const __m128i vshift = _mm_cvtsi32_si128(shift);
+  int           x      = 0;
+#ifdef USE_AVX2
+  if (vext >= AVX2)
+  {
+    const __m256i voffset = _mm256_set1_epi32(offset);
+    const __m256i vmax    = _mm256_set1_epi32(maxVal);
+    for (; x + 8 <= width; x += 8)
+    {
+      __m256i vsum0 = _mm256_setzero_si256();
+      __m256i vsum1 = _mm256_setzero_si256();
+      for (int t = 0; t < numTaps0; t++)
+      {
+        vsum0 = _mm256_add_epi32(vsum0, _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i *) (src0 + x + t)),
+                                                           _mm256_set1_epi32(coeff0[t])));
+      }
+      for (int t = 0; t < numTaps1; t++)
+      {
+        vsum1 = _mm256_add_epi32(vsum1, _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i *) (src1 + x + t)),
+                                                           _mm256_set1_epi32(coeff1[t])));
+      }
+      vsum0 = _mm256_min_epi32(_mm256_max_epi32(_mm256_sra_epi32(_mm256_add_epi32(vsum0, voffset), vshift), _mm256_setzero_si256()), vmax);
+      vsum1 = _mm256_min_epi32(_mm256_max_epi32(_mm256_sra_epi32(_mm256_add_epi32(vsum1, voffset), vshift), _mm256_setzero_si256()), vmax);
+      // interleave the phases; the in-lane unpacks and pack keep the output order;
+      __m256i vlo = _mm256_unpacklo_epi32(vsum0, vsum1);
+      __m256i vhi = _mm256_unpackhi_epi32(vsum0, vsum1);
+      _mm256_storeu_si256((__m256i *) (dst + 2 * x), _mm256_packs_epi32(vlo, vhi));
+    }
+  }
+#endif
+  const __m128i voffset = _mm_set1_epi32(offset);
+  const __m128i vmax    = _mm_set1_epi32(maxVal);
+  for (; x + 4 <= width; x += 4)
+  {
+    __m128i vsum0 = _mm_setzero_si128();
+    __m128i vsum1 = _mm_setzero_si128();
+    for (int t = 0; t < numTaps0; t++)
+    {
+      vsum0 = _mm_add_epi32(vsum0, _mm_mullo_epi32(_mm_loadu_si128((const __m128i *) (src0 + x + t)), _mm_set1_epi32(coeff0[t])));
+    }
+    for (int t = 0; t < numTaps1; t++)
+    {
+      vsum1 = _mm_add_epi32(vsum1, _mm_mullo_epi32(_mm_loadu_si128((const __m128i *) (src1 + x + t)), _mm_set1_epi32(coeff1[t])));
+    }
+    vsum0 = _mm_min_epi32(_mm_max_epi32(_mm_sra_epi32(_mm_add_epi32(vsum0, voffset), vshift), _mm_setzero_si128()), vmax);
+    vsum1 = _mm_min_epi32(_mm_max_epi32(_mm_sra_epi32(_mm_add_epi32(vsum1, voffset), vshift), _mm_setzero_si128()), vmax);
+    _mm_storeu_si128((__m128i *) (dst + 2 * x),
+                     _mm_packs_epi32(_mm_unpacklo_epi32(vsum0, vsum1), _mm_unpackhi_epi32(vsum0, vsum1)));
+  }
+  for (; x < width; x++)
+  {
+    int sum0 = 0, sum1 = 0;
+    for (int t = 0; t < numTaps0; t++)
+    {
+      sum0 += src0[x + t] * coeff0[t];
+    }
+    for (int t = 0; t < numTaps1; t++)
+    {
+      sum1 += src1[x + t] * coeff1[t];
+    }
+    dst[2 * x]     = ClipBD((sum0 + offset) >> shift, bitDepth);
+    dst[2 * x + 1] = ClipBD((sum1 + offset) >> shift, bitDepth);
+  }
+}
+
+// the even samples of 16 consecutive ones, sign extended to 32 bits and packed back;
+static inline __m128i evenSamples(const Pel *src)
+{
+  __m128i va = _mm_srai_epi32(_mm_slli_epi32(_mm_loadu_si128((const __m128i *) src), 16), 16);
+  __m128i vb = _mm_srai_epi32(_mm_slli_epi32(_mm_loadu_si128((const __m128i *) (src + 8)), 16), 16);
+  return _mm_packs_epi32(va, vb);
+}
+
+template<X86_VEXT vext>
+void filterHorDown_SIMD(const Pel *src, Pel *dst, int width, const int *coeff, int numTaps)
+{
+  // a block of n outputs loads 2n samples per tap, one beyond the last tap of the block: the last block is left to
+  // the C loop so that no sample beyond the row is read;
+  int x = 0;
+#ifdef USE_AVX2
+  if (vext >= AVX2)
+  {
+    for (; x + 16 < width; x += 16)
+    {
+      __m256i vsum = _mm256_setzero_si256();
+      for (int t = 0; t < numTaps; t++)
+      {
+        const Pel *p  = src + 2 * x + t;
+        __m256i    va = _mm256_srai_epi32(_mm256_slli_epi32(_mm256_loadu_si256((const __m256i *) p), 16), 16);
+        __m256i    vb = _mm256_srai_epi32(_mm256_slli_epi32(_mm256_loadu_si256((const __m256i *) (p + 16)), 16), 16);
+        // the in-lane pack gives outputs 0..3, 8..11, 4..7, 12..15;
+        __m256i vs = _mm256_permute4x64_epi64(_mm256_packs_epi32(va, vb), 0xd8);
+        vsum       = _mm256_add_epi16(vsum, _mm256_mullo_epi16(vs, _mm256_set1_epi16((short) coeff[t])));
+      }
+      _mm256_storeu_si256((__m256i *) (dst + x), vsum);
+    }
+  }
+#endif
+  for (; x + 8 < width; x += 8)
+  {
+    __m128i vsum = _mm_setzero_si128();
+    for (int t = 0; t < numTaps; t++)
+    {
+      vsum = _mm_add_epi16(vsum, _mm_mullo_epi16(evenSamples(src + 2 * x + t), _mm_set1_epi16((short) coeff[t])));
+    }
+    _mm_storeu_si128((__m128i *) (dst + x), vsum);
+  }
+  for (; x < width; x++)
+  {
+    int sum = 0;
+    for (int t = 0; t < numTaps; t++)
+    {
+      sum += src[2 * x + t] * coeff[t];
+    }
+    dst[x] = sum;
+  }
+}
+
+template<X86_VEXT vext>
+void Resample360Ops::_initResample360OpsX86()
+{
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+  filterVer     = filterVer_SIMD<vext>;
+  filterVerClip = filterVerClip_SIMD<vext>;
+  filterHorUp   = filterHorUp_SIMD<vext>;
+  filterHorDown = filterHorDown_SIMD<vext>;
+#endif
+}
+
+template void Resample360Ops::_initResample360OpsX86<SIMDX86>();
+
+#endif // TARGET_SIMD_X86
+#endif
+//! \}
@@ -0,0 +1 @@
+#include "../Metric360X86.h"
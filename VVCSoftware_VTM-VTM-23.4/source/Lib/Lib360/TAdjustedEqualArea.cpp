@@ -103,5 +103,17 @@ Void TAdjustedEqualArea::map3DTo2D(SPos *pSPosIn, SPos *pSPosOut)
   pSPosOut->y  -= 0.5;
 }
 
+#if SVIDEO_ROW_PROJECTION
+Void TAdjustedEqualArea::map2DTo3DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap2DTo3DRow(this, pSPosIn, pSPosOut, iNum);
+}
+
+Void TAdjustedEqualArea::map3DTo2DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap3DTo2DRow(this, pSPosIn, pSPosOut, iNum);
+}
+#endif
+
 #endif
 #endif
\ No newline at end of file
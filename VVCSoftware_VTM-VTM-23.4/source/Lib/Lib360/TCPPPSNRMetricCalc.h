@@ -38,6 +38,9 @@
 #ifndef __TCPPPSNRCALC__
 #define __TCPPPSNRCALC__
 #include "TGeometry.h"
+#if SVIDEO_CONVERSION_CACHE
+#include "TConversionCache.h"
+#endif
 
 // ====================================================================================================================
 // Class definition
@@ -77,6 +80,17 @@ private:
   TGeometry     *m_pcReferenceGeomtry;
   TGeometry     *m_pcOutputCPPGeomtry;
   TGeometry     *m_pcRefCPPGeomtry;
+#if SVIDEO_CONVERSION_CACHE
+  TConversionCache *m_pcConversionCache;
+#endif
+#if SVIDEO_CPPPSNR_MASK
+  PelStorage    m_cRefCPPYuv;
+  PelStorage    m_cOutCPPYuv;
+  std::vector<UChar> m_validMask[MAX_NUM_CHANNEL_TYPE];   ///< 1 for the samples inside the Crasters-parabolic outline, plane size of the channel type
+  Int           m_iNumValid[MAX_NUM_CHANNEL_TYPE];
+
+  Void          xCreateValidMasks();
+#endif
 
 public:
   TCPPPSNRMetric();
@@ -98,6 +112,9 @@ public:
   //Void    sphSampoints(Char* cSphDataFile);
   Void    sphToCart(CPos2D*, CPos3D*);
   Void    xCalculateCPPPSNR( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPicD );
+#if SVIDEO_CONVERSION_CACHE
+  Void    setConversionCache(TConversionCache *pcCache) { m_pcConversionCache = pcCache; }
+#endif
   Void    initCPPPSNR(InputGeoParam inputGeoParam, Int cppWidth, Int cppHeight, SVideoInfo codingvideoInfo, SVideoInfo referenceVideoInfo);
 };
 
@@ -0,0 +1,193 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TConversionCache.cpp
+    \brief    Per-picture cache of the converted face buffers shared by the 360 metrics
+*/
+
+#include "TConversionCache.h"
+
+#if EXTENSION_360_VIDEO
+#if SVIDEO_CONVERSION_CACHE
+
+TConversionCache::Entry* TConversionCache::xFind(PelUnitBuf *pSrcYuv, const std::vector<UChar> &convKey)
+{
+  const CPelBuf &srcY = pSrcYuv->get(COMPONENT_Y);
+  for (auto &entry: m_entries)
+  {
+#if SVIDEO_PARALLEL_METRICS
+    // the geometry of an entry in progress is being written, its stamp is only read once it is published;
+    Bool bValid = !entry.bReady || entry.uiFacesStamp == entry.pGeo->getFacesStamp();
+#else
+    Bool bValid = entry.uiFacesStamp == entry.pGeo->getFacesStamp();
+#endif
+    if (entry.pSrc == srcY.buf && entry.iSrcWidth == srcY.width && entry.iSrcHeight == srcY.height && bValid
+        && entry.convKey == convKey)
+    {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+Void TConversionCache::convertYuv(TGeometry *pGeo, PelUnitBuf *pSrcYuv)
+{
+  std::vector<UChar> convKey, padKey;
+  pGeo->getConversionKey(convKey, false);
+  pGeo->getConversionKey(padKey, true);
+
+#if SVIDEO_PARALLEL_METRICS
+  std::unique_lock<std::mutex> lock(m_mutex);
+  Entry *pEntry = xFind(pSrcYuv, convKey);
+  while (pEntry && !pEntry->bReady && pEntry->pGeo != pGeo)
+  {
+    m_cvChanged.wait(lock);
+    pEntry = xFind(pSrcYuv, convKey);
+  }
+#else
+  Entry *pEntry = xFind(pSrcYuv, convKey);
+#endif
+  if (pEntry)
+  {
+    if (pEntry->pGeo != pGeo)
+    {
+#if SVIDEO_PARALLEL_METRICS
+      // the published faces stay constant, they are copied without the lock;
+      pEntry->iNumReaders++;
+      lock.unlock();
+#endif
+      pGeo->copyFaces(pEntry->pGeo, pEntry->pGeo->getPaddingFlag() && padKey == pEntry->padKey);
+#if SVIDEO_PARALLEL_METRICS
+      lock.lock();
+      if (--pEntry->iNumReaders == 0)
+      {
+        m_cvChanged.notify_all();
+      }
+      lock.unlock();
+      if (!pGeo->getPaddingFlag())
+      {
+        pGeo->spherePadding(true);
+      }
+#endif
+    }
+    return;
+  }
+
+#if SVIDEO_PARALLEL_METRICS
+  xRelease(pGeo, lock);
+#else
+  xRelease(pGeo);
+#endif
+  const CPelBuf &srcY = pSrcYuv->get(COMPONENT_Y);
+  Entry entry;
+  entry.pSrc       = srcY.buf;
+  entry.iSrcWidth  = srcY.width;
+  entry.iSrcHeight = srcY.height;
+  entry.convKey    = convKey;
+  entry.padKey     = padKey;
+  entry.pGeo       = pGeo;
+#if SVIDEO_PARALLEL_METRICS
+  entry.bReady      = false;
+  entry.iNumReaders = 0;
+  m_entries.push_back(entry);
+  Entry *pNew = &m_entries.back();
+  lock.unlock();
+#endif
+
+  if ((pGeo->getSVideoInfo()->geoType == SVIDEO_OCTAHEDRON || pGeo->getSVideoInfo()->geoType == SVIDEO_ICOSAHEDRON)
+      && pGeo->getSVideoInfo()->iCompactFPStructure)
+  {
+    pGeo->compactFramePackConvertYuv(pSrcYuv);
+  }
+  else
+  {
+    pGeo->convertYuv(pSrcYuv);
+  }
+#if SVIDEO_PARALLEL_METRICS
+  // every metric pads its conversion before reading it; doing it here keeps the published faces constant;
+  pGeo->spherePadding(true);
+
+  lock.lock();
+  pNew->uiFacesStamp = pGeo->getFacesStamp();
+  pNew->bReady       = true;
+  m_cvChanged.notify_all();
+#else
+  entry.uiFacesStamp = pGeo->getFacesStamp();
+  m_entries.push_back(entry);
+#endif
+}
+
+Void TConversionCache::spherePadding(TGeometry *pGeo)
+{
+  // only pGeo is written; with SVIDEO_PARALLEL_METRICS a published geometry is already padded, so no lock is needed;
+  if (!pGeo->getPaddingFlag())
+  {
+    pGeo->spherePadding(true);
+  }
+}
+
+Void TConversionCache::release(TGeometry *pGeo)
+{
+#if SVIDEO_PARALLEL_METRICS
+  std::unique_lock<std::mutex> lock(m_mutex);
+  xRelease(pGeo, lock);
+#else
+  xRelease(pGeo);
+#endif
+}
+
+#if SVIDEO_PARALLEL_METRICS
+// waits (lock held by the caller) until no metric copies the faces of pGeo any more;
+Void TConversionCache::xRelease(TGeometry *pGeo, std::unique_lock<std::mutex> &lock)
+#else
+Void TConversionCache::xRelease(TGeometry *pGeo)
+#endif
+{
+  for (auto it = m_entries.begin(); it != m_entries.end(); it++)
+  {
+    if (it->pGeo == pGeo)
+    {
+#if SVIDEO_PARALLEL_METRICS
+      while (it->iNumReaders > 0)
+      {
+        m_cvChanged.wait(lock);
+      }
+#endif
+      m_entries.erase(it);
+      return;
+    }
+  }
+}
+
+#endif
+#endif
@@ -290,5 +290,17 @@ Void TEquatorialCylindrical::map3DTo2D(SPos *pSPosIn, SPos *pSPosOut)
     pSPosOut->x = (x + 1.0)*m_sVideoInfo.iFaceWidth/2.0 - 0.5;
     pSPosOut->y = (y + 1.0)*m_sVideoInfo.iFaceHeight/2.0 - 0.5;
 }
+
+#if SVIDEO_ROW_PROJECTION
+Void TEquatorialCylindrical::map2DTo3DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap2DTo3DRow(this, pSPosIn, pSPosOut, iNum);
+}
+
+Void TEquatorialCylindrical::map3DTo2DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap3DTo2DRow(this, pSPosIn, pSPosOut, iNum);
+}
+#endif
 #endif
 #endif
@@ -75,8 +75,17 @@ Void TEquiAngularCubeMap::map2DTo3D(SPos& IPosIn, SPos *pSPosOut)
   pu = stan(pu*S_PI/4.0);
   pv = stan(pv*S_PI/4.0);
 
+#if SVIDEO_SEPARABLE_MAPPING
+  xPlaneTo3D(IPosIn.faceIdx, pu, pv, pSPosOut);
+}
+
+Void TEquiAngularCubeMap::xPlaneTo3D(Int faceIdx, POSType pu, POSType pv, SPos *pSPosOut)
+{
+  switch(faceIdx)
+#else
   //map 2D plane ((convergent direction) to 3D ;
   switch(IPosIn.faceIdx)
+#endif
   {
   case 0:
     pSPosOut->x = 1.0;
@@ -174,5 +183,49 @@ Void TEquiAngularCubeMap::map3DTo2D(SPos *pSPosIn, SPos *pSPosOut)
   pSPosOut->x = (POSType)((pu+1.0)*(m_sVideoInfo.iFaceWidth>>1) + (-0.5));
   pSPosOut->y = (POSType)((pv+1.0)*(m_sVideoInfo.iFaceHeight>>1)+ (-0.5));
 }
+
+#if SVIDEO_ROW_PROJECTION
+Void TEquiAngularCubeMap::map2DTo3DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap2DTo3DRow(this, pSPosIn, pSPosOut, iNum);
+}
+
+Void TEquiAngularCubeMap::map3DTo2DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap3DTo2DRow(this, pSPosIn, pSPosOut, iNum);
+}
+#endif
+
+#if SVIDEO_SEPARABLE_MAPPING
+/********************************
+//map2DTo3D() of a row with the tangent of the row evaluated once and the tangents of the columns once per column;
+*********************************/
+Void TEquiAngularCubeMap::map2DTo3DRowMemo(SPos *pSPosIn, SPos *pSPosOut, Int iNum, const Int *pCol, SeparableMemo &memo)
+{
+  for (Int k = 0; k < iNum; k++)
+  {
+    pSPosOut[k].faceIdx = pSPosIn[k].faceIdx;
+    POSType u, v;
+    POSType pu, pv; //positin in the plane of unit sphere;
+    u = pSPosIn[k].x + (POSType)(0.5);
+    v = pSPosIn[k].y + (POSType)(0.5);
+    pu = (POSType)((2.0*u)/m_sVideoInfo.iFaceWidth-1.0);
+    pv = (POSType)((2.0*v)/m_sVideoInfo.iFaceHeight-1.0);
+
+    if (!SeparableMemo::isSame(pv, memo.rowArg))
+    {
+      memo.rowArg    = pv;
+      memo.rowVal[0] = stan(pv*S_PI/4.0);
+    }
+    Int c = pCol[k];
+    if (!SeparableMemo::isSame(pu, memo.colArg[0][c]))
+    {
+      memo.colArg[0][c] = pu;
+      memo.colVal[0][c] = stan(pu*S_PI/4.0);
+    }
+    xPlaneTo3D(pSPosIn[k].faceIdx, memo.colVal[0][c], memo.rowVal[0], pSPosOut + k);
+  }
+}
+#endif
 #endif
 #endif
@@ -53,6 +53,14 @@ private:
 private:
   Void sPadH(Pel *pSrc, Pel *pDst, Int iCount);
   Void sPadV(Pel *pSrc, Pel *pDst, Int iStride, Int iCount); 
+#if SVIDEO_PADDING_GATHER_TABLE
+  Void sPadVRows(Pel *pSrc, Pel *pDst, Int iStride, Int iCount, Int iWidth);
+#endif
+  Void xPadTopBottom(Int ch);
+  Void xFoldMargins(POSType &u, POSType &v);
+#if SVIDEO_SEPARABLE_MAPPING
+  template<Bool bFast> Void xMap3DTo2DRowMemo(SPos *pSPosIn, SPos *pSPosOut, Int iNum, const Int *pCol, SeparableMemo &memo);
+#endif
 
 public:
   TEquiRect(SVideoInfo& sVideoInfo, InputGeoParam *pInGeoParam);
@@ -60,6 +68,14 @@ public:
 
   virtual Void map2DTo3D(SPos& IPosIn, SPos *pSPosOut); 
   virtual Void map3DTo2D(SPos *pSPosIn, SPos *pSPosOut);
+#if SVIDEO_ROW_PROJECTION
+  virtual Void map2DTo3DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum);
+  virtual Void map3DTo2DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum);
+#endif
+#if SVIDEO_SEPARABLE_MAPPING
+  virtual Void map2DTo3DRowMemo(SPos *pSPosIn, SPos *pSPosOut, Int iNum, const Int *pCol, SeparableMemo &memo);
+  virtual Void map3DTo2DRowMemo(SPos *pSPosIn, SPos *pSPosOut, Int iNum, const Int *pCol, SeparableMemo &memo);
+#endif
 
   //own methods;
   virtual Void convertYuv(PelUnitBuf *pSrcYuv);
@@ -0,0 +1,211 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TFastMath.h
+    \brief    Single-precision approximations of the trigonometric functions for the fast geometry mapping (header)
+*/
+
+#ifndef __TFASTMATH__
+#define __TFASTMATH__
+
+// included by TGeometry.h after the basic types and the S_* constants;
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#if EXTENSION_360_VIDEO
+
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// Single-precision polynomial approximations of the trigonometric functions (minimax fits of the Cephes sinf, cosf,
+/// atanf and asinf); the position error of the weight maps stays below 1e-3 sample, the PSNR of the converted
+/// pictures against the double-precision maps is in the order of 76-80 dB.
+/// The functions are inline: the row mappings instantiated with TTrig<true> (TEquiRect) inline them into their loops,
+/// the s*() macros of the other paths test the flag of the thread per call. A TFastMath::Scope sets the flag for the
+/// mapping it encloses.
+class TFastMath
+{
+public:
+  class Scope
+  {
+  public:
+    Scope(Bool bEnable) : m_bPrev(s_bEnabled) { s_bEnabled = bEnable; }
+    ~Scope() { s_bEnabled = m_bPrev; }
+  private:
+    Bool m_bPrev;
+  };
+
+  static Bool isEnabled() { return s_bEnabled; }
+
+  static Double sin(Double x)
+  {
+    Float r;
+    Int   q = xReduceQuadrant(x, r);
+    Float v = (q & 1) ? xCosPoly(r) : xSinPoly(r);
+    return (q & 2) ? -v : v;
+  }
+
+  static Double cos(Double x)
+  {
+    Float r;
+    Int   q = xReduceQuadrant(x, r);
+    Float v = (q & 1) ? xSinPoly(r) : xCosPoly(r);
+    return ((q + 1) & 2) ? -v : v;
+  }
+
+  static Double tan(Double x)
+  {
+    Float r;
+    Int   q = xReduceQuadrant(x, r);
+    Float s = xSinPoly(r);
+    Float c = xCosPoly(r);
+    return (q & 1) ? -c / s : s / c;
+  }
+
+  static Double atan(Double x)
+  {
+    Float a   = std::fabs(Float(x));
+    Bool  bHi = a > 2.414213562373095049f;           // tan(3*pi/8);
+    Bool  bMi = !bHi && a > 0.414213562373095049f;   // tan(pi/8);
+    Float y0  = bHi ? 1.570796326794896619f : (bMi ? 0.785398163397448310f : 0.0f);
+    Float t   = bHi ? -1.0f / a : (bMi ? (a - 1.0f) / (a + 1.0f) : a);
+    Float v   = y0 + xAtanPoly(t);
+    return x < 0 ? -v : v;
+  }
+
+  static Double atan2(Double y, Double x)
+  {
+    if (x == 0)
+    {
+      return y > 0 ? S_PI_2 : (y < 0 ? -S_PI_2 : std::atan2(y, x));
+    }
+    Double v = atan(y / x);
+    if (x < 0)
+    {
+      v += std::signbit(y) ? -S_PI : S_PI;
+    }
+    return v;
+  }
+
+  static Double asin(Double x)
+  {
+    if (std::fabs(x) > 1.0)
+    {
+      return std::numeric_limits<Double>::quiet_NaN();
+    }
+    Float a   = std::fabs(Float(x));
+    Bool  bHi = a > 0.5f;
+    Float t   = bHi ? std::sqrt(0.5f * (1.0f - a)) : a;
+    Float v   = xAsinPoly(t);
+    v         = bHi ? 1.570796326794896619f - 2.0f * v : v;
+    return x < 0 ? -v : v;
+  }
+
+  static Double acos(Double x)
+  {
+    if (std::fabs(x) > 1.0)
+    {
+      return std::numeric_limits<Double>::quiet_NaN();
+    }
+    Float a = Float(x);
+    if (a > 0.5f)
+    {
+      return 2.0f * xAsinPoly(std::sqrt(0.5f * (1.0f - a)));
+    }
+    if (a < -0.5f)
+    {
+      return S_PI - 2.0 * xAsinPoly(std::sqrt(0.5f * (1.0f + a)));
+    }
+    return S_PI_2 - asin(x);
+  }
+
+private:
+  static Float xSinPoly(Float x)   // |x| <= pi/4;
+  {
+    Float z = x * x;
+    return ((-1.9515295891E-4f * z + 8.3321608736E-3f) * z - 1.6666654611E-1f) * z * x + x;
+  }
+
+  static Float xCosPoly(Float x)   // |x| <= pi/4;
+  {
+    Float z = x * x;
+    return ((2.443315711809948E-5f * z - 1.388731625493765E-3f) * z + 4.166664568298827E-2f) * z * z - 0.5f * z + 1.0f;
+  }
+
+  static Float xAtanPoly(Float x)   // |x| <= tan(pi/8);
+  {
+    Float z = x * x;
+    return (((8.05374449538E-2f * z - 1.38776856032E-1f) * z + 1.99777106478E-1f) * z - 3.33329491539E-1f) * z * x + x;
+  }
+
+  static Float xAsinPoly(Float x)   // |x| <= 0.5;
+  {
+    Float z = x * x;
+    return ((((4.2163199048E-2f * z + 2.4181311049E-2f) * z + 4.5470025998E-2f) * z + 7.4953002686E-2f) * z
+            + 1.6666752422E-1f) * z * x + x;
+  }
+
+  // x = q*pi/2 + r, |r| <= pi/4; the reduction itself is done in double precision to keep large angles exact;
+  static Int xReduceQuadrant(Double x, Float &r)
+  {
+    Double q = std::nearbyint(x * (2.0 / S_PI));
+    r        = Float(x - q * S_PI_2);
+    return Int(int64_t(q) & 3);
+  }
+
+  static inline thread_local Bool s_bEnabled = false;
+};
+
+#endif
+
+/// trigonometry of the row mappings specialised for the fast geometry mapping; TTrig<false> is the double-precision libm;
+template<Bool bFast> struct TTrig
+{
+  static Double atan2(Double y, Double x) { return std::atan2(y, x); }
+  static Double acos(Double x)            { return std::acos(x); }
+};
+
+#if SVIDEO_FAST_GEOMETRY_MAPPING
+template<> struct TTrig<true>
+{
+  static Double atan2(Double y, Double x) { return TFastMath::atan2(y, x); }
+  static Double acos(Double x)            { return TFastMath::acos(x); }
+};
+#endif
+
+#endif
+#endif // __TFASTMATH__
@@ -281,6 +281,24 @@ Void TGeneralizedCubeMap::map3DTo2D(SPos *pSPosIn, SPos *pSPosOut)
   pSPosOut->y = (POSType)((pv + 1.0) * (m_sVideoInfo.iFaceHeight >> 1) + (-0.5));
 }
 
+#if SVIDEO_ROW_PROJECTION
+Void TGeneralizedCubeMap::map2DTo3DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap2DTo3DRow(this, pSPosIn, pSPosOut, iNum);
+}
+
+Void TGeneralizedCubeMap::map3DTo2DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap3DTo2DRow(this, pSPosIn, pSPosOut, iNum);
+}
+
+Void TGeneralizedCubeMap::insideFaceRow(Int fId, Int x, Int iStepX, Int y, Int iNum, ComponentID chId, ComponentID origchId,
+                                             Bool *pbInside)
+{
+  xInsideFaceRow(this, fId, x, iStepX, y, iNum, chId, origchId, pbInside);
+}
+#endif
+
 Void TGeneralizedCubeMap::geoToFramePack(IPos *posIn, IPos2D *posOut)
 {
   Int nFaceWidth  = m_sVideoInfo.iFaceWidth;
@@ -38,6 +38,11 @@
 #ifndef __TOCTAHEDRON__
 #define __TOCTAHEDRON__
 #include "TGeometry.h"
+#if SVIDEO_COMPACT_COPY_PLAN
+#include <array>
+#include <map>
+#include <vector>
+#endif
 
 
 // ====================================================================================================================
@@ -46,6 +51,23 @@
 
 #if EXTENSION_360_VIDEO
 
+#if SVIDEO_COMPACT_COPY_PLAN
+//run of samples of a triangleFaceCopy() loop row that are inside the face;
+struct TriangleCopySpan
+{
+  Int iRow;     //loop row, the source and destination lines are advanced by it;
+  Int iStart;   //offset of the first sample, identical in source and destination;
+  Int iLength;
+};
+
+//spans of a triangleFaceCopy() layout, grouped into bands of S_PARALLEL_ROW_BAND loop rows;
+struct TriangleCopyPlan
+{
+  std::vector<TriangleCopySpan> spans;
+  std::vector<Int> bandStart;   //[band] index of the first span, one extra entry closing the last band;
+};
+#endif
+
 class TOctahedron : public TGeometry
 {
 private:
@@ -56,6 +78,12 @@ private:
 
 protected:
   TriMesh m_meshFaces[SV_MAX_NUM_FACES];
+#if SVIDEO_COMPACT_COPY_PLAN
+  //key: face size, source window, chId, rot, flip and face;
+  std::map<std::array<Int, 10>, TriangleCopyPlan> m_triangleCopyPlans;
+
+  const TriangleCopyPlan& xGetTriangleCopyPlan(Int iFaceWidth, Int iFaceHeight, Int iStartHorPos, Int iEndHorPos, Int iStartVerPos, Int iEndVerPos, ComponentID chId, Int rot, FaceFlipType eFaceFlipType, Int face);
+#endif
   
   Void compactFramePackConvertYuvType1(PelUnitBuf *pSrcYuv);  //JVET-D0142;
   Void compactFramePackType1(PelUnitBuf *pDstYuv);            //JVET-D0142;
@@ -82,7 +110,15 @@ public:
   virtual Void clamp(IPos *pIPos);
   virtual Void map2DTo3D(SPos& IPosIn, SPos *pSPosOut); 
   virtual Void map3DTo2D(SPos *pSPosIn, SPos *pSPosOut); 
+#if SVIDEO_ROW_PROJECTION
+  virtual Void map2DTo3DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum);
+  virtual Void map3DTo2DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum);
+#endif
   virtual Bool insideFace(Int fId, Int x, Int y, ComponentID chId, ComponentID origchId);
+#if SVIDEO_ROW_PROJECTION
+  virtual Void insideFaceRow(Int fId, Int x, Int iStepX, Int y, Int iNum, ComponentID chId, ComponentID origchId,
+                             Bool *pbInside);
+#endif
   virtual Bool validPosition4Interp(ComponentID chId, POSType x, POSType y);
   virtual Void convertYuv(PelUnitBuf *pSrcYuv);
 
@@ -91,6 +91,10 @@ public:
 
   virtual Void map2DTo3D(SPos& IPosIn, SPos *pSPosOut); 
   virtual Void map3DTo2D(SPos *pSPosIn, SPos *pSPosOut); 
+#if SVIDEO_ROW_PROJECTION
+  virtual Void map2DTo3DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum);
+  virtual Void map3DTo2DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum);
+#endif
 
   virtual Void convertYuv(PelUnitBuf *pSrcYuv);
   
@@ -99,6 +103,10 @@ public:
   virtual Void spherePadding(Bool bEnforced = false);
     
   virtual Bool insideFace(Int fId, Int x, Int y, ComponentID chId, ComponentID origchId);
+#if SVIDEO_ROW_PROJECTION
+  virtual Void insideFaceRow(Int fId, Int x, Int iStepX, Int y, Int iNum, ComponentID chId, ComponentID origchId,
+                             Bool *pbInside);
+#endif
 };
 #endif
 #endif
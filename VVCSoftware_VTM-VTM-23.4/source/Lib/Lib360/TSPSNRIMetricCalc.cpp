@@ -44,6 +44,13 @@ TSPSNRIMetric::TSPSNRIMetric()
 , m_pCart2D(nullptr)
 , m_fpDTable(nullptr)
 , m_fpTable(nullptr)
+#if SVIDEO_CONVERSION_CACHE
+, m_pcConversionCache(nullptr)
+#endif
+#if SVIDEO_SPSNR_I_POINT_MAP
+, m_pcCodingGeometry(nullptr)
+, m_pcRefGeometry(nullptr)
+#endif
 {
   m_dSPSNRI[0] = m_dSPSNRI[1] = m_dSPSNRI[2] = 0;
 }
@@ -62,6 +69,16 @@ TSPSNRIMetric::~TSPSNRIMetric()
   {
     free(m_fpTable); m_fpTable = nullptr;
   }
+#if SVIDEO_SPSNR_I_POINT_MAP
+  if (m_pcCodingGeometry)
+  {
+    delete m_pcCodingGeometry; m_pcCodingGeometry = nullptr;
+  }
+  if (m_pcRefGeometry)
+  {
+    delete m_pcRefGeometry; m_pcRefGeometry = nullptr;
+  }
+#endif
 }
 
 Void TSPSNRIMetric::setVideoInfo(SVideoInfo sCodingVideoInfo, SVideoInfo sRefVideoInfo)
@@ -178,17 +195,95 @@ void TSPSNRIMetric::createTable(PelUnitBuf* pcPicD, TGeometry *pcCodingGeomtry)
     m_fpDTable[np].y = Out3d.y; 
     m_fpDTable[np].z = Out3d.z;
   }
+#if SVIDEO_SPSNR_I_POINT_MAP
+  xCreatePointMaps();
+#endif
 }
 
+#if SVIDEO_SPSNR_I_POINT_MAP
+// the positions of the sphere points in both geometries do not change over the sequence: their interpolation
+// records are derived once, so that a picture only needs the conversion, the padding and the filtering;
+Void TSPSNRIMetric::xCreatePointMaps()
+{
+  Int iNumPoints = m_iSphNumPoints;
+  SPos sCodingPos, sTempPos;
+  SPos sRefPos;
+
+  if (m_pcCodingGeometry)
+  {
+    delete m_pcCodingGeometry;
+  }
+  if (m_pcRefGeometry)
+  {
+    delete m_pcRefGeometry;
+  }
+  m_pcCodingGeometry = TGeometry::create(m_OutputVideoInfo, &m_GeoParam);
+  m_pcRefGeometry    = TGeometry::create(m_RefVideoInfo, &m_GeoParam);
+  TGeometry *pcCodingGeometry = m_pcCodingGeometry;
+  TGeometry *pcRefGeometry    = m_pcRefGeometry;
+
+  for (Int chType = 0; chType < (Int)getNumberValidChannels(m_GeoParam.chromaFormat); chType++)
+  {
+    const ComponentID ch = chType ? COMPONENT_Cb : COMPONENT_Y;
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+    Double chromaOffsetCoding[2] = { 0.0, 0.0 }; //[0: X; 1: Y];
+    Double chromaOffsetRef[2] = { 0.0, 0.0 }; //[0: X; 1: Y];
+#endif
+    m_codingPointMap[chType].resize(iNumPoints);
+    m_refPointMap[chType].resize(iNumPoints);
+
+    for (Int np = 0; np < iNumPoints; np++)
+    {
+#if SVIDEO_ROT_FIX
+      sTempPos = m_fpDTable[np];
+      pcCodingGeometry->invRotate3D(sTempPos, -pcCodingGeometry->getSVideoInfo()->sVideoRotation.degree[0], -pcCodingGeometry->getSVideoInfo()->sVideoRotation.degree[1], -pcCodingGeometry->getSVideoInfo()->sVideoRotation.degree[2]);
+      pcCodingGeometry->map3DTo2D(&sTempPos, &sCodingPos);
+#else
+      pcCodingGeometry->map3DTo2D(&m_fpDTable[np], &sCodingPos);
+#endif
+      pcRefGeometry->map3DTo2D(&m_fpDTable[np], &sRefPos);
+      if(chType != 0)
+      {
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+        pcCodingGeometry->getFaceChromaOffset(chromaOffsetCoding, sCodingPos.faceIdx, ch);
+        sCodingPos.x = (sCodingPos.x - chromaOffsetCoding[0]) / (1 << pcCodingGeometry->getComponentScaleX(ch));
+        sCodingPos.y = (sCodingPos.y - chromaOffsetCoding[1]) / (1 << pcCodingGeometry->getComponentScaleY(ch));
+#else
+        sCodingPos.x = sCodingPos.x/2;
+        sCodingPos.y = sCodingPos.y/2;
+        sCodingPos.z = sCodingPos.z/2;
+#endif
+
+#if SVIDEO_CHROMA_TYPES_SUPPORT
+        pcRefGeometry->getFaceChromaOffset(chromaOffsetRef, sRefPos.faceIdx, ch);
+        sRefPos.x = (sRefPos.x - chromaOffsetRef[0]) / (1 << pcRefGeometry->getComponentScaleX(ch));
+        sRefPos.y = (sRefPos.y - chromaOffsetRef[1]) / (1 << pcRefGeometry->getComponentScaleY(ch));
+#else
+        sRefPos.x = sRefPos.x/2;
+        sRefPos.y = sRefPos.y/2;
+        sRefPos.z = sRefPos.z/2;
+#endif
+      }
+      pcCodingGeometry->getPelWeight(ch, sCodingPos, m_codingPointMap[chType][np]);
+      pcRefGeometry->getPelWeight(ch, sRefPos, m_refPointMap[chType][np]);
+    }
+  }
+  m_codingPels.resize(iNumPoints);
+  m_refPels.resize(iNumPoints);
+}
+#endif
+
 Void TSPSNRIMetric::xCalculateSPSNRI( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPicD )
 {
   Int iNumPoints = m_iSphNumPoints;
   Int iBitDepthForPSNRCalc[MAX_NUM_CHANNEL_TYPE];
   Int iReferenceBitShift[MAX_NUM_CHANNEL_TYPE];
   Int iOutputBitShift[MAX_NUM_CHANNEL_TYPE];
+#if !SVIDEO_SPSNR_I_POINT_MAP
   SPos sCodingPos, sTempPos;
   SPos sRefPos;
   Pel   refPel, codingPel;
+#endif
 
   TGeometry  *pcCodingGeometry;
   TGeometry  *pcRefGeometry;
@@ -203,9 +298,19 @@ Void TSPSNRIMetric::xCalculateSPSNRI( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPic
 
   memset(m_dSPSNRI, 0, sizeof(Double)*3);
 
+#if SVIDEO_SPSNR_I_POINT_MAP
+  pcCodingGeometry    = m_pcCodingGeometry;
+  pcRefGeometry       = m_pcRefGeometry;
+#else
   pcCodingGeometry    = TGeometry::create(m_OutputVideoInfo, &m_GeoParam);
   pcRefGeometry       = TGeometry::create(m_RefVideoInfo, &m_GeoParam);
+#endif
 
+#if SVIDEO_CONVERSION_CACHE
+  if (m_pcConversionCache)
+    m_pcConversionCache->convertYuv(pcCodingGeometry, pcPicD);
+  else
+#endif
   if((pcCodingGeometry->getSVideoInfo()->geoType == SVIDEO_OCTAHEDRON || pcCodingGeometry->getSVideoInfo()->geoType == SVIDEO_ICOSAHEDRON) && pcCodingGeometry->getSVideoInfo()->iCompactFPStructure) 
   {
     pcCodingGeometry->compactFramePackConvertYuv(pcPicD);
@@ -214,8 +319,18 @@ Void TSPSNRIMetric::xCalculateSPSNRI( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPic
   {
     pcCodingGeometry->convertYuv(pcPicD);
   }
+#if SVIDEO_CONVERSION_CACHE
+  if (m_pcConversionCache)
+    m_pcConversionCache->spherePadding(pcCodingGeometry);
+  else
+#endif
   pcCodingGeometry->spherePadding(true);
 
+#if SVIDEO_CONVERSION_CACHE
+  if (m_pcConversionCache)
+    m_pcConversionCache->convertYuv(pcRefGeometry, pcOrgPicYuv);
+  else
+#endif
   if((pcRefGeometry->getSVideoInfo()->geoType == SVIDEO_OCTAHEDRON || pcRefGeometry->getSVideoInfo()->geoType == SVIDEO_ICOSAHEDRON) && pcRefGeometry->getSVideoInfo()->iCompactFPStructure) 
   {
     pcRefGeometry->compactFramePackConvertYuv(pcOrgPicYuv);
@@ -224,8 +339,36 @@ Void TSPSNRIMetric::xCalculateSPSNRI( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPic
   {
     pcRefGeometry->convertYuv(pcOrgPicYuv);
   }
+#if SVIDEO_CONVERSION_CACHE
+  if (m_pcConversionCache)
+    m_pcConversionCache->spherePadding(pcRefGeometry);
+  else
+#endif
   pcRefGeometry->spherePadding(true);
 
+#if SVIDEO_SPSNR_I_POINT_MAP
+  for(Int chan=0; chan<getNumberValidComponents(pcPicD->chromaFormat); chan++)
+  {
+    const ComponentID ch=ComponentID(chan);
+    const Int   chType = Int(toChannelType(ch));
+    const Int   iRefShift = iReferenceBitShift[chType];
+    const Int   iOutShift = iOutputBitShift[chType];
+    const Pel  *pCodingPel = m_codingPels.data();
+    const Pel  *pRefPel    = m_refPels.data();
+
+    pcCodingGeometry->getPelValues(ch, m_codingPointMap[chType].data(), iNumPoints, m_codingPels.data());
+    pcRefGeometry->getPelValues(ch, m_refPointMap[chType].data(), iNumPoints, m_refPels.data());
+
+    // integer sum: exact, and equal to the former sum in Double as long as it stays below 2^53;
+    int64_t iSSD = 0;
+    for (Int np = 0; np < iNumPoints; np++)
+    {
+      Intermediate_Int iDifflp=  (Intermediate_Int)((pRefPel[np]<<iRefShift) - (pCodingPel[np]<<iOutShift) );
+      iSSD += iDifflp*iDifflp;
+    }
+    SSDspsnrI[chan] = (Double)iSSD/iNumPoints;
+  }
+#else
   for(Int chan=0; chan<getNumberValidComponents(pcPicD->chromaFormat); chan++)
   {
     const ComponentID ch=ComponentID(chan);
@@ -279,6 +422,8 @@ Void TSPSNRIMetric::xCalculateSPSNRI( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPic
     SSDspsnrI[chan] = SSDspsnrI[chan]/iNumPoints;
   }
 
+#endif
+
   for (Int ch_indx = 0; ch_indx < getNumberValidComponents(pcPicD->chromaFormat); ch_indx++)
   {
     const ComponentID ch=ComponentID(ch_indx);
@@ -288,9 +433,18 @@ Void TSPSNRIMetric::xCalculateSPSNRI( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPic
     m_dSPSNRI[ch_indx] = ( SSDspsnrI[ch_indx] ? 10.0 * log10( fReflpsnr / (Double)SSDspsnrI[ch_indx] ) : 999.99 );
   }
 
+#if !SVIDEO_SPSNR_I_POINT_MAP
+#if SVIDEO_CONVERSION_CACHE
+  if (m_pcConversionCache)
+  {
+    m_pcConversionCache->release(pcCodingGeometry);
+    m_pcConversionCache->release(pcRefGeometry);
+  }
+#endif
   if(pcCodingGeometry)
     delete pcCodingGeometry;
   if(pcRefGeometry)
     delete pcRefGeometry;
+#endif
 }
 #endif
@@ -38,6 +38,9 @@
 #ifndef __TSPSNRICALC__
 #define __TSPSNRICALC__
 #include "TGeometry.h"
+#if SVIDEO_CONVERSION_CACHE
+#include "TConversionCache.h"
+#endif
 
 // ====================================================================================================================
 // Class definition
@@ -68,6 +71,19 @@ private:
   Int        m_iRefWidth;
   Int        m_iRefHeight;
   //ChromaFormat  m_chromaFormatIDC;
+#if SVIDEO_CONVERSION_CACHE
+  TConversionCache *m_pcConversionCache;
+#endif
+#if SVIDEO_SPSNR_I_POINT_MAP
+  TGeometry              *m_pcCodingGeometry;                          //kept for the sequence;
+  TGeometry              *m_pcRefGeometry;
+  std::vector<PxlFltLut>  m_codingPointMap[MAX_NUM_CHANNEL_TYPE];      //interpolation records of the sphere points;
+  std::vector<PxlFltLut>  m_refPointMap[MAX_NUM_CHANNEL_TYPE];
+  std::vector<Pel>        m_codingPels;                                //interpolated samples of one channel;
+  std::vector<Pel>        m_refPels;
+
+  Void    xCreatePointMaps();
+#endif
 
 
 public:
@@ -85,6 +101,9 @@ public:
   Void    sphToCart(CPos2D*, CPos3D*);
   Void    createTable(PelUnitBuf* pcPicD, TGeometry *pcCodingGeomtry);
   Void    xCalculateSPSNRI( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPicD );
+#if SVIDEO_CONVERSION_CACHE
+  Void    setConversionCache(TConversionCache *pcCache) { m_pcConversionCache = pcCache; }
+#endif
 
   Int     interpolate(POSType t) { return (Int)(t+ (t>=0? 0.5 :-0.5)); };
 };
@@ -38,6 +38,9 @@
 #ifndef __TSPSNRCALC__
 #define __TSPSNRCALC__
 #include "TGeometry.h"
+#if SVIDEO_CONVERSION_CACHE
+#include "TConversionCache.h"
+#endif
 
 // ====================================================================================================================
 // Class definition
@@ -79,6 +82,22 @@ private:
   IPos*       m_pSamplePosCRecTable;
 #endif
 #endif
+#if SVIDEO_CONVERSION_CACHE
+  TConversionCache *m_pcConversionCache;
+#endif
+#if SVIDEO_SPSNR_NN_POINT_LIST
+  // frame-packed positions of the sphere points that are evaluated, per channel type (structure of arrays);
+  std::vector<Int> m_pointListX[MAX_NUM_CHANNEL_TYPE];
+  std::vector<Int> m_pointListY[MAX_NUM_CHANNEL_TYPE];
+  Int           m_iPointListWidth;         //picture size the lists were built for; 0: not built;
+  Int           m_iPointListHeight;
+  ChromaFormat  m_pointListChromaFormat;
+
+  Void    xBuildPointLists(PelUnitBuf& cPicD);
+#if SVIDEO_FISHEYE
+  Bool    xIsFisheyeSubset();
+#endif
+#endif
 public:
   TSPSNRMetric();
   virtual ~TSPSNRMetric();
@@ -96,6 +115,9 @@ public:
   Void    createTableCFSPSNR(UInt uiXScale, UInt uiYScale);
   Void    xCalculateCFSPSNR( PelUnitBuf *pcOrigPicYuv, PelUnitBuf* pcRecPicYuv);
 #endif
+#if SVIDEO_CONVERSION_CACHE
+  Void    setConversionCache(TConversionCache *pcCache) { m_pcConversionCache = pcCache; }
+#endif
 
 #if !SVIDEO_ROUND_FIX
   inline Int round(POSType t) { return (Int)(t+ (t>=0? 0.5 :-0.5)); }; 
@@ -0,0 +1,547 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TSVideoInfoCfg.cpp
+    \brief    SVideoInfo set-up shared by the 360 options of the encoder and the decoder
+*/
+
+#include "TSVideoInfoCfg.h"
+
+#if EXTENSION_360_VIDEO
+
+std::istringstream &operator>>(std::istringstream &in, GeometryRotation &rot)
+{
+#if SVIDEO_ROT_FIX
+  Double t;
+  in>>t; //yaw;
+  rot.degree[2] = TGeometry::round(t*SVIDEO_ROT_PRECISION);
+  in>>t; //pitch;
+  rot.degree[1] = TGeometry::round(t*SVIDEO_ROT_PRECISION);
+  in>>t; //roll
+  rot.degree[0] = TGeometry::round(t*SVIDEO_ROT_PRECISION);
+#else
+  in>>rot.degree[0];
+  in>>rot.degree[1];
+  in>>rot.degree[2];
+#endif
+  return in;
+}
+
+std::istringstream &operator>>(std::istringstream &in, SVideoFPStruct &sFPStruct)
+{
+  in>>sFPStruct.rows;
+  in>>sFPStruct.cols;
+  for ( Int i = 0; i < sFPStruct.rows; i++ )
+  {
+    for(Int j=0; j<sFPStruct.cols; j++)
+    {
+      in>>sFPStruct.faces[i][j].id;
+      in>>sFPStruct.faces[i][j].rot;
+    }
+  }
+  return in;
+}
+
+#if SVIDEO_GENERALIZED_CUBEMAP
+std::istringstream &operator >> (std::istringstream &in, GeneralizedCMPSettings &gcmp)     //input
+{
+  Int i = 0;
+  while(!in.eof() && i < 6)
+  {
+    in >> gcmp.fCoeffU[i];
+    in >> gcmp.bUAffectedByV[i];
+    in >> gcmp.fCoeffV[i];
+    in >> gcmp.bVAffectedByU[i];
+    i++;
+  }
+  return in;
+}
+#endif
+
+Void TSVideoInfoCfg::setDefaultFramePackingParam(SVideoInfo& sVideoInfo)
+{
+  if(  sVideoInfo.geoType == SVIDEO_EQUIRECT 
+#if SVIDEO_ADJUSTED_EQUALAREA
+    || sVideoInfo.geoType == SVIDEO_ADJUSTEDEQUALAREA 
+#else
+    || sVideoInfo.geoType == SVIDEO_EQUALAREA 
+#endif
+    || sVideoInfo.geoType == SVIDEO_VIEWPORT 
+#if SVIDEO_CPPPSNR
+    || sVideoInfo.geoType == SVIDEO_CRASTERSPARABOLIC
+#endif
+#if SVIDEO_FISHEYE
+    || sVideoInfo.geoType == SVIDEO_FISHEYE_CIRCULAR
+#endif
+    )
+  {
+    if(sVideoInfo.framePackStruct.rows ==0 || sVideoInfo.framePackStruct.cols ==0)
+    {
+      SVideoFPStruct &frmPack = sVideoInfo.framePackStruct;
+      frmPack.chromaFormatIDC = ChromaFormat::_420;
+      frmPack.rows = 1;
+      frmPack.cols = 1;
+      frmPack.faces[0][0].id = 0; frmPack.faces[0][0].rot = 0;
+    }
+  }
+  else if( (sVideoInfo.geoType == SVIDEO_CUBEMAP) 
+#if SVIDEO_ADJUSTED_CUBEMAP
+        || (sVideoInfo.geoType == SVIDEO_ADJUSTEDCUBEMAP)
+#endif
+#if SVIDEO_EQUATORIAL_CYLINDRICAL
+        || (sVideoInfo.geoType == SVIDEO_EQUATORIALCYLINDRICAL)
+#endif
+#if SVIDEO_EQUIANGULAR_CUBEMAP
+        || (sVideoInfo.geoType == SVIDEO_EQUIANGULARCUBEMAP)
+#endif
+#if SVIDEO_HYBRID_EQUIANGULAR_CUBEMAP
+        || (sVideoInfo.geoType == SVIDEO_HYBRIDEQUIANGULARCUBEMAP)
+#endif
+#if SVIDEO_HEMI_PROJECTIONS
+        || (sVideoInfo.geoType == SVIDEO_HCMP)
+        || (sVideoInfo.geoType == SVIDEO_HEAC)
+#endif
+#if SVIDEO_GENERALIZED_CUBEMAP
+        || (sVideoInfo.geoType == SVIDEO_GENERALIZEDCUBEMAP)
+#endif
+          )
+  {
+    if(sVideoInfo.framePackStruct.rows ==0 || sVideoInfo.framePackStruct.cols ==0)
+    {
+      //set default frame packing format as CMP 3x2;
+      SVideoFPStruct &frmPack = sVideoInfo.framePackStruct;
+      frmPack.chromaFormatIDC = ChromaFormat::_420;
+      frmPack.rows = 2;
+      frmPack.cols = 3;
+      frmPack.faces[0][0].id = 4; frmPack.faces[0][0].rot = 0;
+      frmPack.faces[0][1].id = 0; frmPack.faces[0][1].rot = 0;
+      frmPack.faces[0][2].id = 5; frmPack.faces[0][2].rot = 0;
+      frmPack.faces[1][0].id = 3; frmPack.faces[1][0].rot = 180;
+      frmPack.faces[1][1].id = 1; frmPack.faces[1][1].rot = 270;
+      frmPack.faces[1][2].id = 2; frmPack.faces[1][2].rot = 0;
+    }
+#if SVIDEO_GENERALIZED_CUBEMAP
+    if(sVideoInfo.geoType == SVIDEO_GENERALIZEDCUBEMAP)
+    {
+      if(sVideoInfo.framePackStruct.rows == 6 && sVideoInfo.framePackStruct.cols == 1)      sVideoInfo.iGCMPPackingType = 0;
+      else if(sVideoInfo.framePackStruct.rows == 3 && sVideoInfo.framePackStruct.cols == 2) sVideoInfo.iGCMPPackingType = 1;
+      else if(sVideoInfo.framePackStruct.rows == 2 && sVideoInfo.framePackStruct.cols == 3) sVideoInfo.iGCMPPackingType = 2;
+      else if(sVideoInfo.framePackStruct.rows == 1 && sVideoInfo.framePackStruct.cols == 6) sVideoInfo.iGCMPPackingType = 3;
+      else if(sVideoInfo.framePackStruct.rows == 1 && sVideoInfo.framePackStruct.cols == 5)
+      {
+        sVideoInfo.iGCMPPackingType = 4;
+        sVideoInfo.framePackStruct.cols = 6;
+        //set virtual face
+        SVideoFPStruct &frmPack = sVideoInfo.framePackStruct;
+        frmPack.faces[0][5].id = 15;
+        for(Int i = 0; i < 5; i++)
+          frmPack.faces[0][5].id -= frmPack.faces[0][i].id;
+      }
+      else if(sVideoInfo.framePackStruct.rows == 5 && sVideoInfo.framePackStruct.cols == 1)
+      {
+        sVideoInfo.iGCMPPackingType = 5;
+        sVideoInfo.framePackStruct.rows = 6;
+        //set virtual face
+        SVideoFPStruct &frmPack = sVideoInfo.framePackStruct;
+        frmPack.faces[5][0].id = 15;
+        for(Int i = 0; i < 5; i++)
+          frmPack.faces[5][0].id -= frmPack.faces[i][0].id;
+      }
+    }
+#endif
+  }
+  else if(sVideoInfo.geoType == SVIDEO_OCTAHEDRON)
+  {
+    if(sVideoInfo.framePackStruct.rows ==0 || sVideoInfo.framePackStruct.cols ==0)
+    {
+      //set default frame packing format;
+      if (sVideoInfo.iCompactFPStructure == 1)
+      {
+        SVideoFPStruct &frmPack = sVideoInfo.framePackStruct;
+        frmPack.chromaFormatIDC = ChromaFormat::_420;
+        frmPack.rows = 4;
+        frmPack.cols = 2;
+        frmPack.faces[0][0].id = 5; frmPack.faces[0][0].rot = 0;
+        frmPack.faces[0][1].id = 0; frmPack.faces[0][1].rot = 0;
+        frmPack.faces[0][2].id = 7; frmPack.faces[0][2].rot = 0;
+        frmPack.faces[0][3].id = 2; frmPack.faces[0][3].rot = 0;
+        frmPack.faces[1][0].id = 4; frmPack.faces[1][0].rot = 180;
+        frmPack.faces[1][1].id = 1; frmPack.faces[1][1].rot = 180;
+        frmPack.faces[1][2].id = 6; frmPack.faces[1][2].rot = 180;
+        frmPack.faces[1][3].id = 3; frmPack.faces[1][3].rot = 180;
+      }
+      else 
+      {
+        CHECK(!(sVideoInfo.iCompactFPStructure == 0 || sVideoInfo.iCompactFPStructure == 2), "");
+        SVideoFPStruct &frmPack = sVideoInfo.framePackStruct;
+        frmPack.chromaFormatIDC = ChromaFormat::_420;
+        frmPack.rows = 4;
+        frmPack.cols = 2;
+        frmPack.faces[0][0].id = 4; frmPack.faces[0][0].rot = 0;
+        frmPack.faces[0][1].id = 0; frmPack.faces[0][1].rot = 0;
+        frmPack.faces[0][2].id = 6; frmPack.faces[0][2].rot = 0;
+        frmPack.faces[0][3].id = 2; frmPack.faces[0][3].rot = 0;
+        frmPack.faces[1][0].id = 5; frmPack.faces[1][0].rot = 180;
+        frmPack.faces[1][1].id = 1; frmPack.faces[1][1].rot = 180;
+        frmPack.faces[1][2].id = 7; frmPack.faces[1][2].rot = 180;
+        frmPack.faces[1][3].id = 3; frmPack.faces[1][3].rot = 180;
+      }
+    }
+  }
+  else if(sVideoInfo.geoType == SVIDEO_ICOSAHEDRON)
+  {
+    if(sVideoInfo.framePackStruct.rows ==0 || sVideoInfo.framePackStruct.cols ==0)
+    {
+#if SVIDEO_SEC_VID_ISP3
+      if (sVideoInfo.iCompactFPStructure == 1)
+      {
+        SVideoFPStruct &frmPack = sVideoInfo.framePackStruct;
+        frmPack.chromaFormatIDC = ChromaFormat::_420;
+        frmPack.rows = 4;
+        frmPack.cols = 5;
+        frmPack.faces[0][0].id = 0; frmPack.faces[0][0].rot = 180;
+        frmPack.faces[0][1].id = 2; frmPack.faces[0][1].rot = 180;
+        frmPack.faces[0][2].id = 4; frmPack.faces[0][2].rot = 0;
+        frmPack.faces[0][3].id = 6; frmPack.faces[0][3].rot = 180;
+        frmPack.faces[0][4].id = 8; frmPack.faces[0][4].rot = 0;
+        frmPack.faces[1][0].id = 1; frmPack.faces[1][0].rot = 180;
+        frmPack.faces[1][1].id = 3; frmPack.faces[1][1].rot = 180;
+        frmPack.faces[1][2].id = 5; frmPack.faces[1][2].rot = 180;
+        frmPack.faces[1][3].id = 7; frmPack.faces[1][3].rot = 180;
+        frmPack.faces[1][4].id = 9; frmPack.faces[1][4].rot = 180;
+        frmPack.faces[2][0].id = 11; frmPack.faces[1][0].rot = 0;
+        frmPack.faces[2][1].id = 13; frmPack.faces[1][1].rot = 0;
+        frmPack.faces[2][2].id = 15; frmPack.faces[1][2].rot = 0;
+        frmPack.faces[2][3].id = 17; frmPack.faces[1][3].rot = 0;
+        frmPack.faces[2][4].id = 19; frmPack.faces[1][4].rot = 0;
+        frmPack.faces[3][0].id = 10; frmPack.faces[3][0].rot = 180;
+        frmPack.faces[3][1].id = 12; frmPack.faces[3][1].rot = 0;
+        frmPack.faces[3][2].id = 14; frmPack.faces[3][2].rot = 180;
+        frmPack.faces[3][3].id = 16; frmPack.faces[3][3].rot = 0;
+        frmPack.faces[3][4].id = 18; frmPack.faces[3][4].rot = 0;
+      }
+      else
+      {
+#endif
+        //set default frame packing format;
+        SVideoFPStruct &frmPack = sVideoInfo.framePackStruct;
+        frmPack.chromaFormatIDC = ChromaFormat::_420;
+        frmPack.rows = 4;
+        frmPack.cols = 5;
+        frmPack.faces[0][0].id = 0; frmPack.faces[0][0].rot = 0;
+        frmPack.faces[0][1].id = 2; frmPack.faces[0][1].rot = 0;
+        frmPack.faces[0][2].id = 4; frmPack.faces[0][2].rot = 0;
+        frmPack.faces[0][3].id = 6; frmPack.faces[0][3].rot = 0;
+        frmPack.faces[0][4].id = 8; frmPack.faces[0][4].rot = 0;
+        frmPack.faces[1][0].id = 1; frmPack.faces[1][0].rot = 180;
+        frmPack.faces[1][1].id = 3; frmPack.faces[1][1].rot = 180;
+        frmPack.faces[1][2].id = 5; frmPack.faces[1][2].rot = 180;
+        frmPack.faces[1][3].id = 7; frmPack.faces[1][3].rot = 180;
+        frmPack.faces[1][4].id = 9; frmPack.faces[1][4].rot = 180;
+        frmPack.faces[2][0].id = 11; frmPack.faces[1][0].rot = 0;
+        frmPack.faces[2][1].id = 13; frmPack.faces[1][1].rot = 0;
+        frmPack.faces[2][2].id = 15; frmPack.faces[1][2].rot = 0;
+        frmPack.faces[2][3].id = 17; frmPack.faces[1][3].rot = 0;
+        frmPack.faces[2][4].id = 19; frmPack.faces[1][4].rot = 0;
+        frmPack.faces[3][0].id = 10; frmPack.faces[3][0].rot = 180;
+        frmPack.faces[3][1].id = 12; frmPack.faces[3][1].rot = 180;
+        frmPack.faces[3][2].id = 14; frmPack.faces[3][2].rot = 180;
+        frmPack.faces[3][3].id = 16; frmPack.faces[3][3].rot = 180;
+        frmPack.faces[3][4].id = 18; frmPack.faces[3][4].rot = 180;
+#if SVIDEO_SEC_VID_ISP3
+      }
+#endif
+    }
+  }
+#if SVIDEO_TSP_IMP
+  else if(sVideoInfo.geoType == SVIDEO_TSP)
+  {
+    if(sVideoInfo.framePackStruct.rows ==0 || sVideoInfo.framePackStruct.cols ==0)
+    {
+      //set default frame packing format
+      SVideoFPStruct &frmPack = sVideoInfo.framePackStruct;
+      frmPack.chromaFormatIDC = ChromaFormat::_420;
+      frmPack.rows = 1;
+      frmPack.cols = 2;
+      frmPack.faces[0][0].id = 0; frmPack.faces[0][0].rot = 0;
+      frmPack.faces[0][1].id = 1; frmPack.faces[0][1].rot = 0;
+    }
+  }
+#endif
+#if SVIDEO_SEGMENTED_SPHERE
+  else if(sVideoInfo.geoType == SVIDEO_SEGMENTEDSPHERE)
+  {
+    if(sVideoInfo.framePackStruct.rows ==0 || sVideoInfo.framePackStruct.cols ==0)
+    {
+      SVideoFPStruct &frmPack = sVideoInfo.framePackStruct;
+      frmPack.chromaFormatIDC = ChromaFormat::_420;
+#if SVIDEO_SSP_VERT
+      frmPack.rows = 6;
+      frmPack.cols = 1;
+      //sVidInfo.framePackStruct.faces[0][0].id = 0;
+      frmPack.faces[0][0].id = 0; frmPack.faces[0][0].rot = 0;
+      frmPack.faces[1][0].id = 1; frmPack.faces[1][0].rot = 0;
+      frmPack.faces[2][0].id = 2; frmPack.faces[2][0].rot = 270;
+      frmPack.faces[3][0].id = 3; frmPack.faces[3][0].rot = 270;
+      frmPack.faces[4][0].id = 4; frmPack.faces[4][0].rot = 270;
+      frmPack.faces[5][0].id = 5; frmPack.faces[5][0].rot = 270;
+#else
+      frmPack.rows = 1;
+      frmPack.cols = 6;
+      //sVidInfo.framePackStruct.faces[0][0].id = 0;
+      frmPack.faces[0][0].id = 0; frmPack.faces[0][0].rot = 0;
+      frmPack.faces[0][1].id = 1; frmPack.faces[0][1].rot = 0;
+      frmPack.faces[0][2].id = 2; frmPack.faces[0][2].rot = 0;
+      frmPack.faces[0][3].id = 3; frmPack.faces[0][3].rot = 0;
+      frmPack.faces[0][4].id = 4; frmPack.faces[0][4].rot = 0;
+      frmPack.faces[0][5].id = 5; frmPack.faces[0][5].rot = 0;
+#endif
+    }
+  }
+#endif
+#if SVIDEO_ROTATED_SPHERE
+  else if(sVideoInfo.geoType == SVIDEO_ROTATEDSPHERE)
+  {
+      if(sVideoInfo.framePackStruct.rows ==0 || sVideoInfo.framePackStruct.cols ==0)
+      {
+          //set default frame packing format as CMP 3x2;
+          SVideoFPStruct &frmPack = sVideoInfo.framePackStruct;
+          frmPack.chromaFormatIDC = ChromaFormat::_420;
+          frmPack.rows = 2;
+          frmPack.cols = 3;          
+          frmPack.faces[0][0].id = 4; frmPack.faces[0][0].rot = 0;
+          frmPack.faces[0][1].id = 0; frmPack.faces[0][1].rot = 0;
+          frmPack.faces[0][2].id = 5; frmPack.faces[0][2].rot = 0;
+          frmPack.faces[1][0].id = 3; frmPack.faces[1][0].rot = 0;
+          frmPack.faces[1][1].id = 1; frmPack.faces[1][1].rot = 0;
+          frmPack.faces[1][2].id = 2; frmPack.faces[1][2].rot = 0;
+      }
+  }
+#endif
+}
+
+Void TSVideoInfoCfg::fillSVideoInfo(SVideoInfo& sVidInfo, Int inputWidth, Int inputHeight)
+{
+  if(  sVidInfo.geoType == SVIDEO_EQUIRECT 
+#if SVIDEO_ADJUSTED_EQUALAREA
+    || sVidInfo.geoType == SVIDEO_ADJUSTEDEQUALAREA 
+#else
+    || sVidInfo.geoType == SVIDEO_EQUALAREA 
+#endif
+    || sVidInfo.geoType == SVIDEO_VIEWPORT
+    )
+  {
+    //assert(sVidInfo.framePackStruct.rows == 1);
+    //assert(sVidInfo.framePackStruct.cols == 1);
+    //enforce;
+    sVidInfo.framePackStruct.rows = 1;
+    sVidInfo.framePackStruct.cols = 1;
+    sVidInfo.framePackStruct.faces[0][0].id = 0; 
+    //sVidInfo.framePackStruct.faces[0][0].rot = 0;
+    sVidInfo.iNumFaces =1;
+    if(sVidInfo.framePackStruct.faces[0][0].rot == 90 || sVidInfo.framePackStruct.faces[0][0].rot == 270)
+    {
+#if SVIDEO_ERP_PADDING
+      if (sVidInfo.bPERP)
+        inputHeight -= (SVIDEO_ERP_PAD_L + SVIDEO_ERP_PAD_R);
+#endif
+      sVidInfo.iFaceWidth = inputHeight;
+      sVidInfo.iFaceHeight = inputWidth;
+    }
+    else
+    {
+#if SVIDEO_ERP_PADDING
+      if (sVidInfo.bPERP)
+        inputWidth -= (SVIDEO_ERP_PAD_L + SVIDEO_ERP_PAD_R);
+#endif
+      sVidInfo.iFaceWidth = inputWidth;
+      sVidInfo.iFaceHeight = inputHeight;
+    }
+  }
+  else if (  (sVidInfo.geoType == SVIDEO_CUBEMAP)
+#if SVIDEO_ADJUSTED_CUBEMAP
+          || (sVidInfo.geoType == SVIDEO_ADJUSTEDCUBEMAP)
+#endif
+#if SVIDEO_ROTATED_SPHERE
+          || (sVidInfo.geoType == SVIDEO_ROTATEDSPHERE)
+#endif
+#if SVIDEO_EQUATORIAL_CYLINDRICAL
+          || (sVidInfo.geoType == SVIDEO_EQUATORIALCYLINDRICAL)
+#endif
+#if SVIDEO_EQUIANGULAR_CUBEMAP
+          || (sVidInfo.geoType == SVIDEO_EQUIANGULARCUBEMAP)
+#endif
+#if SVIDEO_HYBRID_EQUIANGULAR_CUBEMAP
+          || (sVidInfo.geoType == SVIDEO_HYBRIDEQUIANGULARCUBEMAP)
+#endif
+         )
+  {
+    //assert(sVidInfo.framePackStruct.cols*sVidInfo.framePackStruct.rows == 6);
+    sVidInfo.iNumFaces = 6;
+    //maybe there are some virtual faces;
+    sVidInfo.iFaceWidth = inputWidth/sVidInfo.framePackStruct.cols;
+    sVidInfo.iFaceHeight = inputHeight/sVidInfo.framePackStruct.rows;
+    CHECK((sVidInfo.iFaceWidth != sVidInfo.iFaceHeight), "");
+  }
+#if SVIDEO_GENERALIZED_CUBEMAP
+  else if(sVidInfo.geoType == SVIDEO_GENERALIZEDCUBEMAP)
+  {
+    //assert(sVidInfo.framePackStruct.cols*sVidInfo.framePackStruct.rows == 6);
+    sVidInfo.iNumFaces = 6;
+    if(sVidInfo.bPGCMP)
+    {
+      if(sVidInfo.iGCMPPackingType == 0 || sVidInfo.iGCMPPackingType == 2)
+#if SVIDEO_GCMP_PADDING_TYPE
+        inputHeight -= (2 * sVidInfo.iPGCMPSize);
+#else
+        inputHeight -= sVidInfo.iPGCMPSize;
+#endif
+      else if(sVidInfo.iGCMPPackingType == 1 || sVidInfo.iGCMPPackingType == 3)
+#if SVIDEO_GCMP_PADDING_TYPE
+        inputWidth -= (2 * sVidInfo.iPGCMPSize);
+#else
+        inputWidth -= sVidInfo.iPGCMPSize;
+#endif
+      else if(sVidInfo.iGCMPPackingType == 4)
+        inputWidth -= (2 * sVidInfo.iPGCMPSize);
+      else if(sVidInfo.iGCMPPackingType == 5)
+        inputHeight -= (2 * sVidInfo.iPGCMPSize);
+      if(sVidInfo.bPGCMPBoundary) {
+        inputWidth -= (sVidInfo.iPGCMPSize << 1);
+        inputHeight -= (sVidInfo.iPGCMPSize << 1);
+      }
+    }
+    sVidInfo.iFaceWidth = sVidInfo.iGCMPPackingType == 4 ? inputWidth/3 : inputWidth/sVidInfo.framePackStruct.cols;
+    sVidInfo.iFaceHeight = sVidInfo.iGCMPPackingType == 5 ? inputHeight/3 : inputHeight/sVidInfo.framePackStruct.rows;
+    CHECK(sVidInfo.iFaceWidth != sVidInfo.iFaceHeight, "");
+  }
+#endif
+  else if(sVidInfo.geoType == SVIDEO_OCTAHEDRON
+         || sVidInfo.geoType == SVIDEO_ICOSAHEDRON
+    )
+  {
+    //assert(sVidInfo.framePackStruct.cols*sVidInfo.framePackStruct.rows == 8);
+    sVidInfo.iNumFaces = (sVidInfo.geoType == SVIDEO_OCTAHEDRON)? 8 : 20;
+    //maybe there are some virtual faces;
+    if(sVidInfo.geoType == SVIDEO_OCTAHEDRON && sVidInfo.iCompactFPStructure)
+    {
+#if SVIDEO_MTK_MODIFIED_COHP1
+      if (sVidInfo.iCompactFPStructure == 1)
+      {
+#if SVIDEO_COHP1_PADDING
+        inputHeight -= (S_COHP1_PAD << 1);
+#endif
+        sVidInfo.iFaceWidth  = inputHeight / (sVidInfo.framePackStruct.rows >> 1) - 4;
+        sVidInfo.iFaceHeight = inputWidth / sVidInfo.framePackStruct.cols;
+      }
+      else
+      {
+        sVidInfo.iFaceWidth = (inputWidth/sVidInfo.framePackStruct.cols) - 4;
+        sVidInfo.iFaceHeight = (inputHeight<<1)/sVidInfo.framePackStruct.rows;
+      }
+#else
+      sVidInfo.iFaceWidth = (inputWidth/sVidInfo.framePackStruct.cols) - 4;
+      sVidInfo.iFaceHeight = (inputHeight<<1)/sVidInfo.framePackStruct.rows;
+#endif
+    }
+    else if(sVidInfo.geoType == SVIDEO_ICOSAHEDRON && sVidInfo.iCompactFPStructure)
+    {
+      Int halfCol = (sVidInfo.framePackStruct.cols>>1);
+#if SVIDEO_SEC_VID_ISP3
+      //if (sVidInfo.iCompactFPStructure == 1)
+      {
+        sVidInfo.iFaceWidth = (2 * inputWidth - 16 * halfCol - 8 - 2 * S_CISP_PAD_HOR) / (2 * halfCol + 1);
+        sVidInfo.iFaceHeight = (inputHeight - S_CISP_PAD_VER) / sVidInfo.framePackStruct.rows;
+      }
+#else
+#if SVIDEO_SEC_ISP
+      sVidInfo.iFaceWidth = (2*inputWidth - 16*halfCol - 8 )/(2*halfCol + 1);
+      sVidInfo.iFaceHeight = (inputHeight - 96)/sVidInfo.framePackStruct.rows;
+#else
+      sVidInfo.iFaceWidth = (2*inputWidth - 8*halfCol - 4 )/(2*halfCol + 1);
+      sVidInfo.iFaceHeight = inputHeight/sVidInfo.framePackStruct.rows;
+#endif
+#endif
+    }
+    else
+    {
+      sVidInfo.iFaceWidth = inputWidth/sVidInfo.framePackStruct.cols;
+      sVidInfo.iFaceHeight = inputHeight/sVidInfo.framePackStruct.rows;
+    }
+  }
+#if SVIDEO_TSP_IMP
+  else if(sVidInfo.geoType == SVIDEO_TSP)
+  {
+    sVidInfo.iNumFaces = 6;
+    sVidInfo.iFaceWidth = inputWidth/sVidInfo.framePackStruct.cols;
+    sVidInfo.iFaceHeight = inputHeight/sVidInfo.framePackStruct.rows;
+    CHECK((sVidInfo.iFaceWidth != sVidInfo.iFaceHeight), "");
+  }
+#endif
+#if SVIDEO_SEGMENTED_SPHERE
+  else if(sVidInfo.geoType == SVIDEO_SEGMENTEDSPHERE)
+  {
+#if !SVIDEO_SSP_VERT
+      sVidInfo.framePackStruct.rows = 1;
+      sVidInfo.framePackStruct.cols = 6;
+#endif
+      //sVidInfo.framePackStruct.faces[0][0].id = 0;
+      sVidInfo.iNumFaces = 6;
+      sVidInfo.iFaceWidth = inputWidth / sVidInfo.framePackStruct.cols;
+#if SVIDEO_EAP_SSP_PADDING
+      sVidInfo.iFaceHeight = (inputHeight-(SVIDEO_SSP_GUARD_BAND << 2)) / sVidInfo.framePackStruct.rows;
+#else
+      sVidInfo.iFaceHeight = inputHeight / sVidInfo.framePackStruct.rows;
+#endif
+  }
+#endif
+#if SVIDEO_FISHEYE
+  else if (sVidInfo.geoType == SVIDEO_FISHEYE_CIRCULAR)
+  {
+    sVidInfo.framePackStruct.rows = 1;
+    sVidInfo.framePackStruct.cols = 1;
+    sVidInfo.framePackStruct.faces[0][0].id = 0;
+    sVidInfo.framePackStruct.faces[0][0].rot = 0;
+    sVidInfo.iNumFaces = 1;
+
+    sVidInfo.iFaceWidth = sVidInfo.sFisheyeInfo.iRectWidth;
+    sVidInfo.iFaceHeight = sVidInfo.sFisheyeInfo.iRectHeight;
+  }
+#endif
+  else
+  {
+    CHECK(true, "Not supported yet");
+  }
+}
+
+#endif
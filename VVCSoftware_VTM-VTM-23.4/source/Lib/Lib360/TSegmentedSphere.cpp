@@ -62,15 +62,12 @@ TSegmentedSphere::~TSegmentedSphere()
 #if SVIDEO_EAP_SSP_PADDING
   for(Int i = 0; i < 2; i++)
   {
-    if(pixelWeight4PolePadding[i])
+    for(Int j = 0; j < 2; j++)
     {
-      for(Int j = 0; j < 2; j++)
+      if(pixelWeight4PolePadding[i][j])
       {
-        if(pixelWeight4PolePadding[i][j])
-        {
-          delete[] pixelWeight4PolePadding[i][j];
-          pixelWeight4PolePadding[i][j] = nullptr;
-        }
+        delete[] pixelWeight4PolePadding[i][j];
+        pixelWeight4PolePadding[i][j] = nullptr;
       }
     }
   }
@@ -239,6 +236,24 @@ Void TSegmentedSphere::map3DTo2D(SPos *pSPosIn, SPos *pSPosOut)
     }
 }
 
+#if SVIDEO_ROW_PROJECTION
+Void TSegmentedSphere::map2DTo3DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap2DTo3DRow(this, pSPosIn, pSPosOut, iNum);
+}
+
+Void TSegmentedSphere::map3DTo2DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap3DTo2DRow(this, pSPosIn, pSPosOut, iNum);
+}
+
+Void TSegmentedSphere::insideFaceRow(Int fId, Int x, Int iStepX, Int y, Int iNum, ComponentID chId, ComponentID origchId,
+                                          Bool *pbInside)
+{
+  xInsideFaceRow(this, fId, x, iStepX, y, iNum, chId, origchId, pbInside);
+}
+#endif
+
 #if SVIDEO_SSP_VERT
 //90 anti clockwise: source -> destination;
 /*Void TSegmentedSphere::rot90(Pel *pSrcBuf, Int iStrideSrc, Int iWidth, Int iHeight, Int iNumSamples, Pel *pDst, Int iStrideDst)
@@ -357,11 +372,17 @@ Void TSegmentedSphere::sPadH(Pel *pSrc, Pel *pDst, Int iCount, Int iVCnt, Int iS
 {
     for (Int j = 0; j < iVCnt; j++)
     {
+#if SVIDEO_PADDING_GATHER_TABLE
+        //pSrc and pDst are in different faces;
+        memcpy(pDst, pSrc, iCount * sizeof(Pel));
+        memcpy(pSrc - iCount, pDst - iCount, iCount * sizeof(Pel));
+#else
         for (Int i = 1; i <= iCount; i++)
         {
             pDst[i - 1] = pSrc[i - 1];
             pSrc[-i] = pDst[-i];
         }
+#endif
         pSrc += iStride;
         pDst += iStride;
     }
@@ -381,12 +402,22 @@ Void TSegmentedSphere::fillEmptyRegion(PelUnitBuf *pDstYuv)
     Int iWidth = pDstYuv->get(chId).width;
     Int nHeight = m_sVideoInfo.iFaceHeight >> getComponentScaleY(chId);
     Int nGuardBand = SVIDEO_SSP_GUARD_BAND >> getComponentScaleY(chId);
+#if SVIDEO_SSP_GUARD_BAND_FIX
+    // the second guard band only exists when the faces are stacked vertically;
+    Int iPicHeight = pDstYuv->get(chId).height;
 
+    for (Int j = nHeight; j < std::min(nHeight + (nGuardBand<<1), iPicHeight); j++)
+      for (Int i = 0; i < iWidth; i++)
+        pcBufDst[j*iStride + i] = emptyVal;
+
+    for (Int j = (nHeight+nGuardBand) << 1; j < std::min(nHeight*2+nGuardBand*4, iPicHeight); j++)
+#else
     for (Int j = nHeight; j < nHeight + (nGuardBand<<1); j++)
       for (Int i = 0; i < iWidth; i++)
         pcBufDst[j*iStride + i] = emptyVal;
 
     for (Int j = (nHeight+nGuardBand) << 1; j < nHeight*2+nGuardBand*4; j++)
+#endif
       for (Int i = 0; i < iWidth; i++)
         pcBufDst[j*iStride + i] = emptyVal;
   }
@@ -543,12 +574,42 @@ Void TSegmentedSphere::polePadding(PelUnitBuf *pDstYuv)
       Int iStrideDst = (Int)pDstYuv->get(chId).stride;
       Pel *pDstBuf = pDstYuv->get(chId).bufAt(0, 0) + offsetDstY*iStrideDst + offsetDstX;
 
+#if SVIDEO_PADDING_GATHER_TABLE
+      std::vector<SSPPolePaddingSample> &samples = m_polePaddingSamples[faceIdx][ch > 0 ? 1 : 0];
+      if(samples.empty())
+      {
+        for(Int j = 0; j < nHeight; j++)
+        {
+          for(Int i = 0; i < nWidth; i++)
+          {
+            if(!insidePadding(faceIdx, i<<getComponentScaleX(chId), j<<getComponentScaleY(chId), COMPONENT_Y, chId))
+              continue;
+
+            Double x_L = (i << getComponentScaleX(chId)) + 0.5 - radius;
+            Double y_L = (j << getComponentScaleY(chId)) + 0.5 - radius;
+
+            if(faceIdx == 1)
+              y_L -= SVIDEO_SSP_GUARD_BAND;
+
+            SSPPolePaddingSample sample = { i, j, ssqrt(x_L*x_L + y_L*y_L) };
+            samples.push_back(sample);
+          }
+        }
+      }
+
+      for(const SSPPolePaddingSample &sample : samples)
+      {
+        {
+          Int i = sample.i;
+          Int j = sample.j;
+#else
       for(Int j = 0; j < nHeight; j++)
       {
         for(Int i = 0; i < nWidth; i++)
         {
           if(!insidePadding(faceIdx, i<<getComponentScaleX(chId), j<<getComponentScaleY(chId), COMPONENT_Y, chId))
             continue;
+#endif
 
           Int sum = 0;
 
@@ -558,6 +619,9 @@ Void TSegmentedSphere::polePadding(PelUnitBuf *pDstYuv)
           Int iWLutIdx = (m_chromaFormatIDC==ChromaFormat::_400 || (m_InterpolationType[0]==m_InterpolationType[1]))? 0 : Int(chType);
           Int *pWLut = m_pWeightLut[iWLutIdx][pPelWeight->weightIdx];
           Pel *pPelLine = m_pFacesOrig[face][ch] +iTLPos -((m_iInterpFilterTaps[Int(chType)][1]-1)>>1)*getStride(chId) -((m_iInterpFilterTaps[Int(chType)][0]-1)>>1);
+#if SVIDEO_INTERP_KERNELS
+          sum = g_interp360OP.filter2D[m_iInterpFilterTaps[Int(chType)][0]](pPelLine, getStride(chId), pWLut);
+#else
           for(Int m=0; m<m_iInterpFilterTaps[Int(chType)][1]; m++)
           {
             for(Int n=0; n<m_iInterpFilterTaps[Int(chType)][0]; n++)
@@ -565,9 +629,13 @@ Void TSegmentedSphere::polePadding(PelUnitBuf *pDstYuv)
             pPelLine += getStride(chId);
             pWLut += m_iInterpFilterTaps[Int(chType)][0];
           }
+#endif
           
           pDstBuf[i+j*iStrideDst] = ClipBD((sum + iOffset)>>iBDPrecision, m_nBitDepth);
           
+#if SVIDEO_PADDING_GATHER_TABLE
+          Double d = sample.d;
+#else
           Double x_L = (i << getComponentScaleX(chId)) + 0.5 - radius;
           Double y_L = (j << getComponentScaleY(chId)) + 0.5 - radius;
 
@@ -575,6 +643,7 @@ Void TSegmentedSphere::polePadding(PelUnitBuf *pDstYuv)
             y_L -= SVIDEO_SSP_GUARD_BAND;
 
           Double d = ssqrt(x_L*x_L + y_L*y_L);
+#endif
 
           pDstBuf[i+j*iStrideDst] = (Pel)(((radius2-d) * pDstBuf[i+j*iStrideDst] + (d-radius) * emptyVal) / (Double)SVIDEO_SSP_PADDING_SIZE);
         }
@@ -44,6 +44,15 @@
 // Class definition
 // ====================================================================================================================
 #if EXTENSION_360_VIDEO
+#if SVIDEO_EAP_SSP_PADDING && SVIDEO_PADDING_GATHER_TABLE
+//sample of a pole face written by polePadding() and its distance to the centre of the pole;
+struct SSPPolePaddingSample
+{
+    Int i;
+    Int j;
+    Double d;
+};
+#endif
 class TSegmentedSphere : public TCubeMap
 {
 public:
@@ -52,7 +61,15 @@ public:
 
     virtual Void map2DTo3D(SPos& IPosIn, SPos *pSPosOut);
     virtual Void map3DTo2D(SPos *pSPosIn, SPos *pSPosOut);
+#if SVIDEO_ROW_PROJECTION
+    virtual Void map2DTo3DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum);
+    virtual Void map3DTo2DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum);
+#endif
     virtual Bool insideFace(Int fId, Int x, Int y, ComponentID chId, ComponentID origchId);
+#if SVIDEO_ROW_PROJECTION
+    virtual Void insideFaceRow(Int fId, Int x, Int iStepX, Int y, Int iNum, ComponentID chId, ComponentID origchId,
+                               Bool *pbInside);
+#endif
 #if SVIDEO_SSP_VERT
     //virtual Void rot90(Pel *pSrcBuf, Int iStrideSrc, Int iWidth, Int iHeight, Int iNumSamples, Pel *pDst, Int iStrideDst);
     Int getRot(Int faceIdx);
@@ -69,6 +86,9 @@ public:
 private:
     PxlFltLut *pixelWeight4PolePadding[2][2]; //[face][luma/chroma]
     Bool m_bPolePadding;
+#if SVIDEO_PADDING_GATHER_TABLE
+    std::vector<SSPPolePaddingSample> m_polePaddingSamples[2][2]; //[face][luma/chroma], resolved once instead of testing every sample of the face;
+#endif
     Void fillEmptyRegion(PelUnitBuf *pDstYuv);
     Bool insidePadding(Int fId, Int x, Int y, ComponentID chId, ComponentID origchId);
     Void geometryMapping4PolePadding();
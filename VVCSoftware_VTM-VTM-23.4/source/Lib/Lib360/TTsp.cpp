@@ -270,6 +270,18 @@ Void TTsp::map3DTo2D(SPos *pSPosIn, SPos *pSPosOut)
 #endif
 }
 
+#if SVIDEO_ROW_PROJECTION
+Void TTsp::map2DTo3DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap2DTo3DRow(this, pSPosIn, pSPosOut, iNum);
+}
+
+Void TTsp::map3DTo2DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap3DTo2DRow(this, pSPosIn, pSPosOut, iNum);
+}
+#endif
+
 Bool TTsp::insideTspFace(Int fId, Int xx, Int yy, ComponentID chId, ComponentID origchId)
 {
   Bool ret = ( xx>=0 && xx<(m_sVideoInfo.iFaceWidth>>getComponentScaleX(chId)) && yy>=0 && yy<(m_sVideoInfo.iFaceHeight>>getComponentScaleY(chId)) );
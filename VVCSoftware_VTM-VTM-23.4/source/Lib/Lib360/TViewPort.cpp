@@ -36,11 +36,16 @@
 */
 
 #include <math.h>
+#include <iterator>
 #include "TViewPort.h"
 
 #if EXTENSION_360_VIDEO
 
 TViewPort::TViewPort(SVideoInfo& sVideoInfo, InputGeoParam *pInGeoParam) : TGeometry()
+#if SVIDEO_VIEWPORT_MAP_CACHE
+, m_bInvKValid(false)
+, m_iMapCacheSize(SVIDEO_VIEWPORT_MAP_CACHE_SIZE)
+#endif
 {
    //assert(sVideoInfo.iNumFaces == 1);
    geoInit(sVideoInfo, pInGeoParam);   
@@ -48,6 +53,9 @@ TViewPort::TViewPort(SVideoInfo& sVideoInfo, InputGeoParam *pInGeoParam) : TGeom
 
 TViewPort::~TViewPort()  
 {
+#if SVIDEO_VIEWPORT_MAP_CACHE
+  xClearMapCache();
+#endif
 }
 
 
@@ -74,6 +82,14 @@ Void TViewPort::map2DTo3D(SPos& IPosIn, SPos *pSPosOut)
 
 Void TViewPort::setViewPort(Float fovx,Float fovy,Float yaw,Float pitch)
 {
+#if SVIDEO_VIEWPORT_MAP_CACHE
+  if (fovx == m_sVideoInfo.viewPort.hFOV && fovy == m_sVideoInfo.viewPort.vFOV)
+  {
+    setOrientation(yaw, pitch);
+    return;
+  }
+  xClearMapCache();
+#endif
    m_sVideoInfo.viewPort.hFOV= fovx;
    m_sVideoInfo.viewPort.vFOV= fovy;
    m_sVideoInfo.viewPort.fYaw= yaw;
@@ -93,6 +109,16 @@ Void TViewPort::setRotMat()
 }
 Void TViewPort::setInvK()
 {
+#if SVIDEO_VIEWPORT_MAP_CACHE
+  // the camera does not depend on the orientation, it is only derived again when the FOV changes;
+  if (m_bInvKValid && m_fInvKFOV[0] == m_sVideoInfo.viewPort.hFOV && m_fInvKFOV[1] == m_sVideoInfo.viewPort.vFOV)
+  {
+    return;
+  }
+  m_bInvKValid  = true;
+  m_fInvKFOV[0] = m_sVideoInfo.viewPort.hFOV;
+  m_fInvKFOV[1] = m_sVideoInfo.viewPort.vFOV;
+#endif
   POSType fovx = (POSType)(S_PI * (m_sVideoInfo.viewPort.hFOV)/180.0);
   POSType fovy = (POSType)(S_PI * (m_sVideoInfo.viewPort.vFOV)/180.0);
 
@@ -118,9 +144,116 @@ Void TViewPort::matInv(POSType K[3][3])
   m_matInvK[2][1] = (K[2][0] * K[0][1] - K[0][0] * K[2][1]) /det;
   m_matInvK[2][2] = (K[0][0] * K[1][1] - K[1][0] * K[0][1]) /det;
 }
+#if SVIDEO_VIEWPORT_MAP_CACHE
+/********************************
+//change yaw/pitch of the viewport; the weight map of the current orientation is kept in a small LRU cache
+//and is swapped back in (instead of being generated again) when an orientation repeats;
+*********************************/
+Void TViewPort::setOrientation(Float fYaw, Float fPitch)
+{
+  ViewPortSettings &viewPort = m_sVideoInfo.viewPort;
+  if (m_bGeometryMapping && fYaw == viewPort.fYaw && fPitch == viewPort.fPitch)
+  {
+    return;
+  }
+
+  auto it = m_mapCache.begin();
+  while (it != m_mapCache.end() && !(it->fYaw == fYaw && it->fPitch == fPitch))
+  {
+    it++;
+  }
+  if (it != m_mapCache.end())
+  {
+    for (Int ch = 0; ch < 2; ch++)
+    {
+      std::swap(m_pPixelWeight[0][ch], it->pPixelWeight[ch]);
+    }
+    if (m_bGeometryMapping)
+    {
+      it->fYaw   = viewPort.fYaw;
+      it->fPitch = viewPort.fPitch;
+      m_mapCache.splice(m_mapCache.begin(), m_mapCache, it);
+    }
+    else
+    {
+      for (Int ch = 0; ch < 2; ch++)
+      {
+        delete[] it->pPixelWeight[ch];
+      }
+      m_mapCache.erase(it);
+    }
+    m_bGeometryMapping = true;
+  }
+  else
+  {
+    if (m_bGeometryMapping && m_iMapCacheSize > 0)
+    {
+      if ((Int) m_mapCache.size() < m_iMapCacheSize)
+      {
+        MapCacheEntry entry = { viewPort.fYaw, viewPort.fPitch, { m_pPixelWeight[0][0], m_pPixelWeight[0][1] } };
+        m_mapCache.push_front(entry);
+        m_pPixelWeight[0][0] = m_pPixelWeight[0][1] = nullptr;
+      }
+      else
+      {
+        // the least recently used map is dropped; its buffers receive the map of the new orientation;
+        MapCacheEntry &entry = m_mapCache.back();
+        for (Int ch = 0; ch < 2; ch++)
+        {
+          std::swap(m_pPixelWeight[0][ch], entry.pPixelWeight[ch]);
+        }
+        entry.fYaw   = viewPort.fYaw;
+        entry.fPitch = viewPort.fPitch;
+        m_mapCache.splice(m_mapCache.begin(), m_mapCache, std::prev(m_mapCache.end()));
+      }
+    }
+    m_bGeometryMapping = false;
+  }
+  viewPort.fYaw   = fYaw;
+  viewPort.fPitch = fPitch;
+}
+
+Void TViewPort::setMapCacheSize(Int iSize)
+{
+  m_iMapCacheSize = iSize;
+  while ((Int) m_mapCache.size() > m_iMapCacheSize)
+  {
+    for (Int ch = 0; ch < 2; ch++)
+    {
+      delete[] m_mapCache.back().pPixelWeight[ch];
+    }
+    m_mapCache.pop_back();
+  }
+}
+
+Void TViewPort::xClearMapCache()
+{
+  for (auto &entry: m_mapCache)
+  {
+    for (Int ch = 0; ch < 2; ch++)
+    {
+      delete[] entry.pPixelWeight[ch];
+    }
+  }
+  m_mapCache.clear();
+}
+#endif
+
 Void TViewPort::map3DTo2D(SPos *,SPos *)
 {
     CHECK(true, "Viewport 3D to 2D is not supported ");
 }
 
+#if SVIDEO_ROW_PROJECTION
+Void TViewPort::map2DTo3DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap2DTo3DRow(this, pSPosIn, pSPosOut, iNum);
+}
+
+Void TViewPort::map3DTo2DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum)
+{
+  xMap3DTo2DRow(this, pSPosIn, pSPosOut, iNum);
+}
+#endif
+
 #endif
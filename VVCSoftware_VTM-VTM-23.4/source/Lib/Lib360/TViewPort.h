@@ -38,6 +38,9 @@
 #ifndef __TVIEWPORT__
 #define __TVIEWPORT__
 #include "TGeometry.h"
+#if SVIDEO_VIEWPORT_MAP_CACHE
+#include <list>
+#endif
 
 // ====================================================================================================================
 // Class definition
@@ -50,6 +53,20 @@ class TViewPort : public TGeometry
 private:
   POSType m_matRotMatx[3][3];
   POSType m_matInvK[3][3];
+#if SVIDEO_VIEWPORT_MAP_CACHE
+  struct MapCacheEntry
+  {
+    Float      fYaw;
+    Float      fPitch;
+    PxlFltLut *pPixelWeight[2];
+  };
+  Bool  m_bInvKValid;
+  Float m_fInvKFOV[2];                     //hFOV/vFOV m_matInvK was derived from;
+  std::list<MapCacheEntry> m_mapCache;     //most recently used first;
+  Int   m_iMapCacheSize;
+
+  Void xClearMapCache();
+#endif
 
 public:
   TViewPort(SVideoInfo& sVideoInfo, InputGeoParam *pInGeoParam);
@@ -60,10 +77,18 @@ public:
 
   //own methods;
   virtual Void map3DTo2D(SPos *pSPosIn, SPos *pSPosOut); 
+#if SVIDEO_ROW_PROJECTION
+  virtual Void map2DTo3DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum);
+  virtual Void map3DTo2DRow(SPos *pSPosIn, SPos *pSPosOut, Int iNum);
+#endif
   Void setViewPort(Float, Float, Float, Float);
   Void setRotMat();
   Void setInvK();
   Void matInv(POSType[3][3]);
+#if SVIDEO_VIEWPORT_MAP_CACHE
+  Void setOrientation(Float fYaw, Float fPitch);
+  Void setMapCacheSize(Int iSize);
+#endif
 };
 
 #endif
@@ -64,6 +64,9 @@ TViewPortPSNR::TViewPortPSNR()
 , m_iNumFrameSkipped(0)
 , m_bViewPortPSNREnabled(false)
 #endif
+#if SVIDEO_CONVERSION_CACHE
+, m_pcConversionCache(nullptr)
+#endif
 {
   m_viewPortPSNRParam.bViewPortPSNREnabled = false;
   m_viewPortPSNRParam.viewPortSettingsList.clear();
@@ -387,6 +390,11 @@ Void TViewPortPSNR::xCalculatePSNR( Picture* pcPic)
 #endif
   Int iNumOfViewPorts = (Int)m_viewPortPSNRParam.viewPortSettingsList.size(); 
 #if SVIDEO_E2E_METRICS
+#if SVIDEO_CONVERSION_CACHE
+  if (m_pcConversionCache)
+    m_pcConversionCache->convertYuv(m_pRefGeometry, pcOrgPicYuv);
+  else
+#endif
   if((m_pRefGeometry->getType() == SVIDEO_OCTAHEDRON || m_pRefGeometry->getType() == SVIDEO_ICOSAHEDRON) && m_pRefGeometry->getSVideoInfo()->iCompactFPStructure) 
     m_pRefGeometry->compactFramePackConvertYuv(pcOrgPicYuv);
   else
@@ -398,6 +406,11 @@ Void TViewPortPSNR::xCalculatePSNR( Picture* pcPic)
     m_pRefGeometry->convertYuv(m_pcOrgPicYuv);
 #endif
   PelUnitBuf pRecPicYuv = pcPic->getRecoBuf();
+#if SVIDEO_CONVERSION_CACHE
+  if (m_pcConversionCache)
+    m_pcConversionCache->convertYuv(m_pRecGeometry, &pRecPicYuv);
+  else
+#endif
   if((m_pRecGeometry->getType() == SVIDEO_OCTAHEDRON || m_pRecGeometry->getType() == SVIDEO_ICOSAHEDRON) && m_pRecGeometry->getSVideoInfo()->iCompactFPStructure) 
     m_pRecGeometry->compactFramePackConvertYuv(&pRecPicYuv);
   else
@@ -454,12 +467,22 @@ Void TViewPortPSNR::xCalculateDynamicViewPSNR( Picture* pcPic, PelUnitBuf *pcOrg
   if(!m_dynamicViewPortPSNRParam.bViewPortPSNREnabled)
     return;
 
+#if SVIDEO_CONVERSION_CACHE
+  if (m_pcConversionCache)
+    m_pcConversionCache->convertYuv(m_pRefGeometry, pcOrgPicYuv);
+  else
+#endif
   if((m_pRefGeometry->getType() == SVIDEO_OCTAHEDRON || m_pRefGeometry->getType() == SVIDEO_ICOSAHEDRON) && m_pRefGeometry->getSVideoInfo()->iCompactFPStructure) 
     m_pRefGeometry->compactFramePackConvertYuv(pcOrgPicYuv);
   else
     m_pRefGeometry->convertYuv(pcOrgPicYuv);
 
   PelUnitBuf pRecPicYuv = pcPic->getRecoBuf();
+#if SVIDEO_CONVERSION_CACHE
+  if (m_pcConversionCache)
+    m_pcConversionCache->convertYuv(m_pRecGeometry, &pRecPicYuv);
+  else
+#endif
   if((m_pRecGeometry->getType() == SVIDEO_OCTAHEDRON || m_pRecGeometry->getType() == SVIDEO_ICOSAHEDRON) && m_pRecGeometry->getSVideoInfo()->iCompactFPStructure) 
     m_pRecGeometry->compactFramePackConvertYuv(&pRecPicYuv);
   else
@@ -477,17 +500,25 @@ Void TViewPortPSNR::xCalculateDynamicViewPSNR( Picture* pcPic, PelUnitBuf *pcOrg
 
     Float dCurrPitch  = (iTotalNumFrame) ? ( dStartPitch + (dEndPitch - dStartPitch)/Float(iTotalNumFrame)*Float(iCurPOC) ) : dStartPitch;
     Float dCurrYaw    = (iTotalNumFrame) ? ( dStartYaw + (dEndYaw - dStartYaw)/Float(iTotalNumFrame)*Float(iCurPOC) ) : dStartYaw;
+#if SVIDEO_VIEWPORT_MAP_CACHE
+    // the maps are only generated again when the orientation is not the current or a cached one;
+    ((TViewPort *) m_pRefViewPortList[i])->setOrientation(dCurrYaw, dCurrPitch);
+    ((TViewPort *) m_pRecViewPortList[i])->setOrientation(dCurrYaw, dCurrPitch);
+#else
     m_pRefViewPortList[i]->getSVideoInfo()->viewPort.fPitch = dCurrPitch;
     m_pRefViewPortList[i]->getSVideoInfo()->viewPort.fYaw   = dCurrYaw;
     m_pRecViewPortList[i]->getSVideoInfo()->viewPort.fPitch = dCurrPitch;
     m_pRecViewPortList[i]->getSVideoInfo()->viewPort.fYaw   = dCurrYaw;
+#endif
 
 
     Double *dPSNR = m_pdPSNR[i];
     Double dMSE[MAX_NUM_COMPONENT];
 
     //generate reference viewport;
+#if !SVIDEO_VIEWPORT_MAP_CACHE
     m_pRefViewPortList[i]->setGeometryMapping(false);
+#endif
     m_pRefGeometry->geoConvert(m_pRefViewPortList[i]);
     if((m_pRefViewPortList[i]->getType() == SVIDEO_OCTAHEDRON || m_pRefViewPortList[i]->getType() == SVIDEO_ICOSAHEDRON) && m_pRefViewPortList[i]->getSVideoInfo()->iCompactFPStructure)
       m_pRefViewPortList[i]->compactFramePack(m_pRefViewPortYuv);
@@ -495,7 +526,9 @@ Void TViewPortPSNR::xCalculateDynamicViewPSNR( Picture* pcPic, PelUnitBuf *pcOrg
       m_pRefViewPortList[i]->framePack(m_pRefViewPortYuv);
 
     //generate reconstructed viewport;
+#if !SVIDEO_VIEWPORT_MAP_CACHE
     m_pRecViewPortList[i]->setGeometryMapping(false);
+#endif
 #if SVIDEO_ROT_FIX
     m_pRecGeometry->geoConvert(m_pRecViewPortList[i], true);
 #else
@@ -39,6 +39,9 @@
 #define __TVIEWPORTPSNR__
 #include "TGeometry.h"
 #include "TViewPort.h"
+#if SVIDEO_CONVERSION_CACHE
+#include "TConversionCache.h"
+#endif
 #include "../Utilities/VideoIOYuv.h"
 #include "../CommonLib/Picture.h"
 #include "../Utilities/VideoIOYuv.h"
@@ -84,6 +87,9 @@ private:
   UInt         m_iNumFrameSkipped;
   Bool         m_bViewPortPSNREnabled;
 #endif
+#if SVIDEO_CONVERSION_CACHE
+  TConversionCache *m_pcConversionCache;
+#endif
 
   Void xCalculatePSNRInternal(PelUnitBuf *pcOrgPicYuv, PelUnitBuf *pcPicD, Double *pdPSNR, Double *pdMSE);
   Void calculateCombinedValues(Int vpIdx, UInt uiNumPics, Double &PSNRyuv, Double &MSEyuv);
@@ -112,6 +118,9 @@ public:
   Bool isEnabled() { return m_viewPortPSNRParam.bViewPortPSNREnabled; }
 #endif
   Void printSummary(UInt uiNumPics);
+#if SVIDEO_CONVERSION_CACHE
+  Void setConversionCache(TConversionCache *pcCache) { m_pcConversionCache = pcCache; }
+#endif
 #if SVIDEO_DYNAMIC_VIEWPORT_PSNR
   Void initDynamicViewPort(SVideoInfo& sRefVideoInfo, SVideoInfo& sRecVideoInfo, InputGeoParam *pInGeoParam, DynamicViewPortPSNRParam& param, UInt numFrameSkipped, UInt tempSubsampleRatio);
   Void xCalculateDynamicViewPSNR( Picture* pcPic, PelUnitBuf *pcOrgPicYuv);
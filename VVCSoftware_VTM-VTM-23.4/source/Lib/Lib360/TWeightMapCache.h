@@ -0,0 +1,86 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TWeightMapCache.h
+    \brief    On-disk cache of the geometry weight maps (header)
+*/
+
+#ifndef __TWEIGHTMAPCACHE__
+#define __TWEIGHTMAPCACHE__
+#include "TGeometryKey.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+#if EXTENSION_360_VIDEO
+#if SVIDEO_WEIGHT_MAP_CACHE
+
+static const UInt S_WEIGHT_MAP_CACHE_VERSION = 1;   //increase whenever the map generation changes its output;
+static const Int  S_WEIGHT_MAP_CACHE_ALIGN   = 4096; //file offset alignment of the maps, so that they can be mapped directly;
+
+/// One cache file stores all the weight maps of a geometry. The file name is the hash of the key; the key itself,
+/// the version and the map sizes are stored in the header and compared on load, so a stale or colliding file is
+/// never used. With a size limit, the least recently used files (by modification time, which load() refreshes) are
+/// removed after a store() until the cache fits again; dynamic viewports write one file per orientation.
+class TWeightMapCache : public TGeometryKey
+{
+private:
+  std::string                m_sCacheDir;
+  int64_t                    m_iMaxBytes;   ///< 0: unlimited;
+  std::vector<PxlFltLut*>    m_maps;
+  std::vector<int64_t>       m_mapSizes;
+
+  uint64_t    xHash(const UChar *pData, size_t iSize, uint64_t uiHash) const;
+  std::string xGetFileName() const;
+  Void        xEvict(const std::string &sKeepFile) const;
+
+public:
+  TWeightMapCache(const std::string &sCacheDir, Int iMaxMB = 0);
+  virtual ~TWeightMapCache() {}
+
+  Bool isEnabled() const { return !m_sCacheDir.empty(); }
+
+  Void addMap(PxlFltLut *pMap, int64_t iNumEntries);
+
+  Bool load();    ///< fills the registered maps; false if there is no valid cache file;
+  Void store();   ///< writes the registered maps; errors are reported but not fatal;
+};
+
+#endif
+#endif
+#endif // __TWEIGHTMAPCACHE__